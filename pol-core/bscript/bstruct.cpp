@@ -5,6 +5,7 @@ History
 2008/02/11 Turley:    BStruct::unpack() will accept zero length Structs
 2009/09/05 Turley:    Added struct .? and .- as shortcut for .exists() and .erase()
 2009/12/21 Turley:    ._method() call fix
+2026/10/17 agent:     Contents with hash index for lookups in big structs
 
 Notes
 =======
@@ -191,6 +192,7 @@ namespace Pol {
 		const BObjectRef& bvalref = elem.second;
         size += bkey.capacity( ) + bvalref.sizeEstimate( ) + ( sizeof(void*)* 3 + 1 ) / 2;
 	  }
+	  size += contents_.indexSize();
 	  return size;
 	}
 
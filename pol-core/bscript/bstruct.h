@@ -3,6 +3,7 @@ History
 =======
 2009/09/05 Turley:    Added struct .? and .- as shortcut for .exists() and .erase()
 2009/12/21 Turley:    ._method() call fix
+2026/10/17 agent:     Contents with hash index for lookups in big structs
 
 Notes
 =======
@@ -16,6 +17,7 @@ Notes
 #include "bobject.h"
 #endif
 
+#include "../clib/indexedmap.h"
 #include "../clib/maputil.h"
 
 #include <map>
@@ -24,6 +26,14 @@ Notes
 
 namespace Pol {
   namespace Bscript {
+	// member names are case-insensitive
+	struct BStructKeyTraits
+	{
+	  static bool indexable( const std::string& ) { return true; }
+	  static size_t hash( const std::string& key ) { return Clib::ci_hash( key ); }
+	  static bool equal( const std::string& a, const std::string& b ) { return stricmp( a.c_str(), b.c_str() ) == 0; }
+	};
+
 	class BStruct : public BObjectImp
 	{
 	public:
@@ -38,7 +48,7 @@ namespace Pol {
 
 	  size_t mapcount() const;
 
-	  typedef std::map<std::string, BObjectRef, Clib::ci_cmp_pred> Contents;
+	  typedef Clib::IndexedMap<std::string, BObjectRef, Clib::ci_cmp_pred, BStructKeyTraits> Contents;
 	  const Contents& contents() const;
 
 	protected:
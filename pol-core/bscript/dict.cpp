@@ -4,6 +4,7 @@ History
 2005/11/26 Shinigami: changed "strcmp" into "stricmp" to suppress Script Errors
 2008/02/11 Turley:    BDictionary::unpack() will accept zero length Dictionarys
 2009/12/21 Turley:    ._method() call fix
+2026/10/17 agent:     Contents with hash index for lookups in big dictionaries
 
 Notes
 =======
@@ -22,10 +23,30 @@ Notes
 
 #include "../clib/stlutil.h"
 
+#include <functional>
 #include <sstream>
 
 namespace Pol {
   namespace Bscript {
+	bool BDictionaryKeyTraits::indexable( const BObject& key )
+	{
+	  return key.isa( BObjectImp::OTLong ) || key.isa( BObjectImp::OTString );
+	}
+
+	size_t BDictionaryKeyTraits::hash( const BObject& key )
+	{
+	  if ( key.isa( BObjectImp::OTLong ) )
+		return std::hash<int>()( static_cast<const BLong*>( key.impptr() )->value() );
+	  return std::hash<std::string>()( static_cast<const String*>( key.impptr() )->value() );
+	}
+
+	bool BDictionaryKeyTraits::equal( const BObject& a, const BObject& b )
+	{
+	  if ( a.impptr()->type() != b.impptr()->type() )
+		return false;
+	  return a.impptr()->isEqual( *b.impptr() );
+	}
+
 	BDictionary::BDictionary() : BObjectImp( OTDictionary )
 	{}
 
@@ -140,6 +161,7 @@ namespace Pol {
 		const BObjectRef& bvalref = elem.second;
         size += bkeyobj.sizeEstimate() + bvalref.sizeEstimate() + ( sizeof(void*)* 3 + 1 ) / 2;
 	  }
+	  size += contents_.indexSize();
 	  return size;
 	}
 
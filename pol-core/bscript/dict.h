@@ -2,6 +2,7 @@
 History
 =======
 2009/12/21 Turley:    ._method() call fix
+2026/10/17 agent:     Contents with hash index for lookups in big dictionaries
 
 Notes
 =======
@@ -19,11 +20,22 @@ Notes
 #include "bobject.h"
 #endif
 
+#include "../clib/indexedmap.h"
+
 #include <map>
 #include <iosfwd>
 
 namespace Pol {
   namespace Bscript {
+	// only integer and string keys are hashed, a dictionary with any other key
+	// type uses the ordered lookup alone (ints and reals compare equal)
+	struct BDictionaryKeyTraits
+	{
+	  static bool indexable( const BObject& key );
+	  static size_t hash( const BObject& key );
+	  static bool equal( const BObject& a, const BObject& b );
+	};
+
 	class BDictionary : public BObjectImp
 	{
 	public:
@@ -36,7 +48,7 @@ namespace Pol {
 	  void addMember( BObjectImp* key, BObjectImp* val );
 	  size_t mapcount() const;
 
-	  typedef std::map<BObject, BObjectRef> Contents;
+	  typedef Clib::IndexedMap<BObject, BObjectRef, std::less<BObject>, BDictionaryKeyTraits> Contents;
 	  const Contents& contents() const;
 
 	protected:
@@ -38,6 +38,7 @@ namespace Pol {
 	  version( 0 ),
       invocations( 0 ),
       instr_cycles( 0 ),
+      startup_ns( 0 ),
       pkg( NULL ),
 	  instr(),
 	  debug_loaded( false ),
@@ -126,6 +126,7 @@ namespace Pol {
 	  unsigned short version;
       unsigned int invocations;
       u64 instr_cycles; // FIXME need an enable-profiling flag
+      u64 startup_ns; // creating the executors and attaching this program, summed over the invocations
       Plib::Package const * pkg;
       std::vector<Instruction> instr;
 
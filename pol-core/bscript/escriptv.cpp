@@ -15,8 +15,13 @@ namespace Pol {
 	int include_debug;
 
 	int executor_count;
+#ifdef PARALLEL_SCRIPTS
+	std::atomic<int> eobject_imp_count( 0 );
+	std::atomic<int> eobject_imp_constructions( 0 );
+#else
 	int eobject_imp_count;
 	int eobject_imp_constructions;
+#endif
 	int escript_program_count;
 	u64 escript_instr_cycles;
 	int escript_execinstr_calls;
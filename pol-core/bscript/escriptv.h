@@ -12,14 +12,26 @@ Notes
 #define BSCRIPT_ESCRIPTV_H
 
 #include "../clib/rawtypes.h"
+
+// PARALLEL_SCRIPTS: BObjectImps are also created on the script worker threads (see run_ready()),
+// so their counters have to be atomic.
+#ifdef PARALLEL_SCRIPTS
+#include <atomic>
+#endif
+
 namespace Pol {
   namespace Bscript {
 	extern int include_debug;
 
 	extern int executor_count;
 
+#ifdef PARALLEL_SCRIPTS
+	extern std::atomic<int> eobject_imp_count;
+	extern std::atomic<int> eobject_imp_constructions;
+#else
 	extern int eobject_imp_count;
 	extern int eobject_imp_constructions;
+#endif
 
 	extern int escript_program_count;
 
@@ -68,6 +68,10 @@ namespace Pol {
 	  const std::string& scriptname() const;
 	  Executor& exec;
 
+	  // true if the functions of this module only work on their parameters,
+	  // so they can be called by a script worker thread (see Executor::next_instr_threadsafe)
+	  virtual bool is_threadsafe() const { return false; }
+
 	protected:
 	  ExecutorModule( const char* moduleName, Executor& iExec );
 
@@ -80,6 +80,9 @@ namespace Pol {
 
 	extern int executor_count;
 	std::mutex Executor::_executor_mutex;
+
+	// deep enough for nearly every script, so the value stack doesn't grow while running
+	static const size_t VALUESTACK_RESERVE = 32;
 	Executor::Executor() :
 	  done( 0 ),
 	  error_( false ),
@@ -92,12 +95,17 @@ namespace Pol {
 	  current_module_function( NULL ),
 	  prog_ok_( false ),
 	  viewmode_( false ),
+	  module_factories_( NULL ),
+	  created_( std::chrono::steady_clock::now() ),
 	  debugging_( false ),
 	  debug_state_( DEBUG_STATE_NONE ),
 	  breakpoints_(),
 	  bp_skip_( ~0u ),
-	  func_result_( NULL )
+	  func_result_( NULL ),
+	  unlocked_pcs_()
 	{
+	  ValueStack.reserve( VALUESTACK_RESERVE );
+
 	  std::lock_guard<std::mutex> lock( _executor_mutex );
 	  ++executor_count;
 	  executor_instances.insert( this );
@@ -140,6 +148,8 @@ namespace Pol {
 		}
 
 		ExecutorModule* em = findModule( fm->modulename );
+		if ( em == NULL )
+		  em = createModule( fm->modulename );
 		execmodules.push_back( em );
 		if ( em == NULL )
 		{
@@ -730,6 +740,7 @@ namespace Pol {
 	  nLines = static_cast<unsigned int>( prog_->instr.size() );
 
 	  Globals2.clear();
+	  Globals2.reserve( prog_->nglobals );
 	  for ( unsigned i = 0; i < prog_->nglobals; ++i )
 	  {
 		Globals2.push_back( BObjectRef() );
@@ -739,6 +750,8 @@ namespace Pol {
 	  prog_ok_ = true;
 	  seterror( false );
 	  ++prog_->invocations;
+	  prog_->startup_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now() - created_ ).count();
 	  return true;
 	}
 
@@ -1619,6 +1632,29 @@ namespace Pol {
 	  ValueStack.pop_back();
 	}
 
+	/*
+	  Most operands of an expression are temporaries which are only referenced by the
+	  value stack (literals and results of other operations). For those the BObject,
+	  and for numbers the BObjectImp too, is reused for the result instead of
+	  allocating new ones. Variables are shared with the stack and never modified.
+	  */
+	static inline bool is_number( const BObjectImp* imp )
+	{
+	  return imp->isa( BObjectImp::OTLong ) || imp->isa( BObjectImp::OTDouble );
+	}
+	static inline bool is_temporary_number( const BObjectRef& ref )
+	{
+	  return ref->count() == 1 && ref->impptr()->count() == 1 && is_number( ref->impptr() );
+	}
+	// replaces the object on the stack with imp, reusing the BObject if it's a temporary
+	static inline void set_result( BObjectRef& ref, BObjectImp* imp )
+	{
+	  if ( ref->count() == 1 && ref->impptr() != imp )
+		ref->setimp( imp );
+	  else
+		ref.set( new BObject( imp ) );
+	}
+
 	// TOK_ADD:
 	void Executor::ins_add( const Instruction& /*ins*/ )
 	{
@@ -1634,7 +1670,15 @@ namespace Pol {
 	  BObject& right = *rightref;
 	  BObject& left = *leftref;
 
-	  leftref.set( new BObject( right.impref().selfPlusObjImp( left.impref() ) ) );
+	  if ( is_number( right.impptr() ) && is_temporary_number( leftref ) )
+		left.impref().operPlusEqual( left, right.impref() );
+	  else if ( is_number( left.impptr() ) && is_temporary_number( rightref ) )
+	  {
+		right.impref().operPlusEqual( right, left.impref() );
+		leftref = rightref;
+	  }
+	  else
+		set_result( leftref, right.impref().selfPlusObjImp( left.impref() ) );
 	}
 
 	// TOK_SUBTRACT
@@ -1652,7 +1696,10 @@ namespace Pol {
 	  BObject& right = *rightref;
 	  BObject& left = *leftref;
 
-	  leftref.set( new BObject( right.impref().selfMinusObjImp( left.impref() ) ) );
+	  if ( is_number( right.impptr() ) && is_temporary_number( leftref ) )
+		left.impref().operMinusEqual( left, right.impref() );
+	  else
+		set_result( leftref, right.impref().selfMinusObjImp( left.impref() ) );
 	}
 
 	// TOK_MULT:
@@ -1670,7 +1717,15 @@ namespace Pol {
 	  BObject& right = *rightref;
 	  BObject& left = *leftref;
 
-	  leftref.set( new BObject( right.impref().selfTimesObjImp( left.impref() ) ) );
+	  if ( is_number( right.impptr() ) && is_temporary_number( leftref ) )
+		left.impref().operTimesEqual( left, right.impref() );
+	  else if ( is_number( left.impptr() ) && is_temporary_number( rightref ) )
+	  {
+		right.impref().operTimesEqual( right, left.impref() );
+		leftref = rightref;
+	  }
+	  else
+		set_result( leftref, right.impref().selfTimesObjImp( left.impref() ) );
 	}
 	// TOK_DIV:
 	void Executor::ins_div( const Instruction& /*ins*/ )
@@ -1687,7 +1742,10 @@ namespace Pol {
 	  BObject& right = *rightref;
 	  BObject& left = *leftref;
 
-	  leftref.set( new BObject( right.impref().selfDividedByObjImp( left.impref() ) ) );
+	  if ( is_number( right.impptr() ) && is_temporary_number( leftref ) )
+		left.impref().operDivideEqual( left, right.impref() );
+	  else
+		set_result( leftref, right.impref().selfDividedByObjImp( left.impref() ) );
 	}
 	// TOK_MODULUS:
 	void Executor::ins_modulus( const Instruction& /*ins*/ )
@@ -1704,7 +1762,7 @@ namespace Pol {
 	  BObject& right = *rightref;
 	  BObject& left = *leftref;
 
-	  leftref.set( new BObject( right.impref().selfModulusObjImp( left.impref() ) ) );
+	  set_result( leftref, right.impref().selfModulusObjImp( left.impref() ) );
 	}
 	// TOK_BSRIGHT:
 	void Executor::ins_bitshift_right( const Instruction& /*ins*/ )
@@ -1721,7 +1779,7 @@ namespace Pol {
 	  BObject& right = *rightref;
 	  BObject& left = *leftref;
 
-	  leftref.set( new BObject( right.impref().selfBitShiftRightObjImp( left.impref() ) ) );
+	  set_result( leftref, right.impref().selfBitShiftRightObjImp( left.impref() ) );
 	}
 	// TOK_BSLEFT:
 	void Executor::ins_bitshift_left( const Instruction& /*ins*/ )
@@ -1738,7 +1796,7 @@ namespace Pol {
 	  BObject& right = *rightref;
 	  BObject& left = *leftref;
 
-	  leftref.set( new BObject( right.impref().selfBitShiftLeftObjImp( left.impref() ) ) );
+	  set_result( leftref, right.impref().selfBitShiftLeftObjImp( left.impref() ) );
 	}
 	// TOK_BITAND:
 	void Executor::ins_bitwise_and( const Instruction& /*ins*/ )
@@ -1755,7 +1813,7 @@ namespace Pol {
 	  BObject& right = *rightref;
 	  BObject& left = *leftref;
 
-	  leftref.set( new BObject( right.impref().selfBitAndObjImp( left.impref() ) ) );
+	  set_result( leftref, right.impref().selfBitAndObjImp( left.impref() ) );
 	}
 	// TOK_BITXOR:
 	void Executor::ins_bitwise_xor( const Instruction& /*ins*/ )
@@ -1772,7 +1830,7 @@ namespace Pol {
 	  BObject& right = *rightref;
 	  BObject& left = *leftref;
 
-	  leftref.set( new BObject( right.impref().selfBitXorObjImp( left.impref() ) ) );
+	  set_result( leftref, right.impref().selfBitXorObjImp( left.impref() ) );
 	}
 	// TOK_BITOR:
 	void Executor::ins_bitwise_or( const Instruction& /*ins*/ )
@@ -1789,7 +1847,7 @@ namespace Pol {
 	  BObject& right = *rightref;
 	  BObject& left = *leftref;
 
-	  leftref.set( new BObject( right.impref().selfBitOrObjImp( left.impref() ) ) );
+	  set_result( leftref, right.impref().selfBitOrObjImp( left.impref() ) );
 	}
 
 	void Executor::ins_logical_and( const Instruction& /*ins*/ )
@@ -1807,7 +1865,7 @@ namespace Pol {
 	  BObject& left = *leftref;
 
 	  int _true = ( left.isTrue() && right.isTrue() );
-	  leftref.set( new BObject( new BLong( _true ) ) );
+	  set_result( leftref, new BLong( _true ) );
 	}
 	void Executor::ins_logical_or( const Instruction& /*ins*/ )
 	{
@@ -1824,7 +1882,7 @@ namespace Pol {
 	  BObject& left = *leftref;
 
 	  int _true = ( left.isTrue() || right.isTrue() );
-	  leftref.set( new BObject( new BLong( _true ) ) );
+	  set_result( leftref, new BLong( _true ) );
 	}
 
 	void Executor::ins_notequal( const Instruction& /*ins*/ )
@@ -1842,7 +1900,7 @@ namespace Pol {
 	  BObject& left = *leftref;
 
 	  int _true = !( left->isEqual( right.impref() ) );
-	  leftref.set( new BObject( new BLong( _true ) ) );
+	  set_result( leftref, new BLong( _true ) );
 	}
 
 	void Executor::ins_equal( const Instruction& /*ins*/ )
@@ -1860,7 +1918,7 @@ namespace Pol {
 	  BObject& left = *leftref;
 
 	  int _true = ( left->isEqual( right.impref() ) );
-	  leftref.set( new BObject( new BLong( _true ) ) );
+	  set_result( leftref, new BLong( _true ) );
 	}
 
 	void Executor::ins_lessthan( const Instruction& /*ins*/ )
@@ -1878,7 +1936,7 @@ namespace Pol {
 	  BObject& left = *leftref;
 
 	  int _true = ( left->isLT( right.impref() ) );
-	  leftref.set( new BObject( new BLong( _true ) ) );
+	  set_result( leftref, new BLong( _true ) );
 	}
 
 	void Executor::ins_lessequal( const Instruction& /*ins*/ )
@@ -1895,7 +1953,7 @@ namespace Pol {
 	  BObject& right = *rightref;
 	  BObject& left = *leftref;
 	  int _true = ( left->isLE( right.impref() ) );
-	  leftref.set( new BObject( new BLong( _true ) ) );
+	  set_result( leftref, new BLong( _true ) );
 	}
 	void Executor::ins_greaterthan( const Instruction& /*ins*/ )
 	{
@@ -1912,7 +1970,7 @@ namespace Pol {
 	  BObject& left = *leftref;
 
 	  int _true = ( right->isLT( left.impref() ) );
-	  leftref.set( new BObject( new BLong( _true ) ) );
+	  set_result( leftref, new BLong( _true ) );
 	}
 	void Executor::ins_greaterequal( const Instruction& /*ins*/ )
 	{
@@ -1929,7 +1987,7 @@ namespace Pol {
 	  BObject& left = *leftref;
 
 	  int _true = ( right->isLE( left.impref() ) );
-	  leftref.set( new BObject( new BLong( _true ) ) );
+	  set_result( leftref, new BLong( _true ) );
 	}
 
 	// case TOK_ARRAY_SUBSCRIPT:
@@ -2117,7 +2175,7 @@ namespace Pol {
 	  BObject& right = *rightref;
 	  BObject& left = *leftref;
 
-	  leftref.set( new BObject( new BLong( right.impref().contains( left.impref() ) ) ) );
+	  set_result( leftref, new BLong( right.impref().contains( left.impref() ) ) );
 	}
 
 	void Executor::ins_insert_into( const Instruction& /*ins*/ )
@@ -2531,8 +2589,8 @@ namespace Pol {
 								  unsigned nparams = token.lval;
 								  getParams( nparams );
 
+								  BObjectImp* imp = ValueStack.back()->impptr()->call_method( token.tokval(), *this );
 								  BObjectRef& objref = ValueStack.back();
-								  BObjectImp* imp = objref->impptr()->call_method( token.tokval(), *this );
 
 								  if ( func_result_ )
 								  {
@@ -2556,8 +2614,8 @@ namespace Pol {
 									 unsigned nparams = token.type;
 									 getParams( nparams );
 
+									 BObjectImp* imp = ValueStack.back()->impptr()->call_method_id( token.lval, *this );
 									 BObjectRef& objref = ValueStack.back();
-									 BObjectImp* imp = objref->impptr()->call_method_id( token.lval, *this );
 
 									 if ( func_result_ )
 									 {
@@ -3218,41 +3276,234 @@ namespace Pol {
 	  }
 	  catch ( std::exception& ex )
 	  {
-        fmt::Writer tmp;
-        tmp << "Exception in: "
-          << prog_->name.get()
-          << " PC=" << onPC
-          << ": "
-          << ex.what()
-          << "\n";
-        if ( !run_ok_ )
-          tmp << "run_ok_ = false\n";
-		if ( PC < nLines )
+		instr_exception( onPC, ex.what() );
+	  }
+#ifdef __unix__
+	  catch( ... )
+	  {
+		instr_exception( onPC, NULL );
+	  }
+#endif
+	}
+
+	void Executor::execInstrUnlocked()
+	{
+	  unsigned onPC = PC;
+	  try
+	  {
+		passert( run_ok_ );
+		passert( PC < nLines );
+		passert( !error_ );
+		passert( !done );
+
+		const Instruction& ins = prog_->instr[PC];
+		unlocked_pcs_.push_back( PC );
+		++PC;
+
+		( this->*( ins.func ) )( ins );
+	  }
+	  catch ( std::exception& ex )
+	  {
+		instr_exception( onPC, ex.what() );
+	  }
+#ifdef __unix__
+	  catch( ... )
+	  {
+		instr_exception( onPC, NULL );
+	  }
+#endif
+	}
+
+	void Executor::add_unlocked_cycles()
+	{
+	  if ( unlocked_pcs_.empty() )
+		return;
+	  for ( unsigned pc : unlocked_pcs_ )
+		++prog_->instr[pc].cycles;
+	  prog_->instr_cycles += unlocked_pcs_.size();
+	  escript_instr_cycles += unlocked_pcs_.size();
+	  unlocked_pcs_.clear();
+	}
+
+	// Executes up to count instructions without the per instruction checks of execInstr().
+	// Stops early when the script isn't runnable anymore or after a function or method call,
+	// since these can block the script or change its state from outside.
+	// Instructions are already decoded into their handlers by the loader, so this loop
+	// only has to dispatch. Returns the number of executed instructions.
+	unsigned Executor::execInstrs( unsigned count )
+	{
+	  if ( debugging_ || debug_level != NONE )
+	  {
+		// the debugger and tracing need to see every single instruction
+		Clib::scripts_thread_scriptPC = PC;
+		execInstr();
+		return 1;
+	  }
+
+	  unsigned executed = 0;
+	  unsigned onPC = PC;
+	  try
+	  {
+		passert( !error_ );
+		passert( !done );
+		const Instruction* instr = &prog_->instr[0];
+		while ( executed < count && run_ok_ )
 		{
-          tmp << " PC < nLines: ("
-            << PC << " < "
-            << nLines << ") \n";
-		}
-		if ( error_ )
-          tmp << "error_ = true\n";
-		if ( done )
-          tmp << "done = true\n";
+		  passert( PC < nLines );
+		  onPC = PC;
+		  Clib::scripts_thread_scriptPC = PC;
+		  const Instruction& ins = instr[PC];
 
-		seterror( true );
-        POLLOG_ERROR << tmp.str();
+		  ++ins.cycles;
+		  ++PC;
+		  ++executed;
 
-		show_context( onPC );
+		  ( this->*( ins.func ) )( ins );
+
+		  switch ( ins.token.id )
+		  {
+			case TOK_FUNC:
+			case INS_CALL_METHOD:
+			case INS_CALL_METHOD_ID:
+			  count = executed;
+			  break;
+			default:
+			  break;
+		  }
+		}
+	  }
+	  catch ( std::exception& ex )
+	  {
+		instr_exception( onPC, ex.what() );
 	  }
 #ifdef __unix__
 	  catch( ... )
+	  {
+		instr_exception( onPC, NULL );
+	  }
+#endif
+	  prog_->instr_cycles += executed;
+	  escript_instr_cycles += executed;
+	  return executed;
+	}
+
+	void Executor::instr_exception( unsigned onPC, const char* what )
+	{
+	  if ( what == NULL )
 	  {
 		seterror( true );
-        POLLOG_ERROR << "Exception in " << prog_->name.get() << ", PC=" << onPC
+		POLLOG_ERROR << "Exception in " << prog_->name.get() << ", PC=" << onPC
 		  << ": unclassified\n";
 
 		show_context( onPC );
+		return;
+	  }
+	  fmt::Writer tmp;
+	  tmp << "Exception in: "
+		<< prog_->name.get()
+		<< " PC=" << onPC
+		<< ": "
+		<< what
+		<< "\n";
+	  if ( !run_ok_ )
+		tmp << "run_ok_ = false\n";
+	  if ( PC < nLines )
+	  {
+		tmp << " PC < nLines: ("
+		  << PC << " < "
+		  << nLines << ") \n";
+	  }
+	  if ( error_ )
+		tmp << "error_ = true\n";
+	  if ( done )
+		tmp << "done = true\n";
+
+	  seterror( true );
+	  POLLOG_ERROR << tmp.str();
+
+	  show_context( onPC );
+	}
+
+	// the topmost count values on the stack only carry script data (no references
+	// into the application like items, files or config elements)
+	bool Executor::values_threadsafe( size_t count ) const
+	{
+	  if ( count > ValueStack.size() )
+		count = ValueStack.size();
+	  for ( auto itr = ValueStack.rbegin(), end = itr + count; itr != end; ++itr )
+	  {
+		switch ( ( *itr )->impptr()->type() )
+		{
+		  case BObjectImp::OTUninit:
+		  case BObjectImp::OTString:
+		  case BObjectImp::OTLong:
+		  case BObjectImp::OTDouble:
+		  case BObjectImp::OTArray:
+		  case BObjectImp::OTError:
+		  case BObjectImp::OTDictionary:
+		  case BObjectImp::OTStruct:
+			break;
+		  default:
+			return false;
+		}
+	  }
+	  return true;
+	}
+
+	// Can the instruction at PC be executed without holding the world lock?
+	// Everything which only works on the values of this executor is fine, module
+	// functions only if the module says so, and methods/members/subscripts only
+	// if the involved objects are plain script data.
+	bool Executor::next_instr_threadsafe() const
+	{
+	  if ( debugging_ || debug_level != NONE || PC >= nLines )
+		return false;
+	  const Instruction& ins = prog_->instr[PC];
+	  switch ( ins.token.id )
+	  {
+		case TOK_FUNC:
+		{
+		  const ExecutorModule* em = execmodules[ins.token.module];
+		  return em != NULL && em->is_threadsafe();
+		}
+		case INS_CALL_METHOD:
+		  return values_threadsafe( ins.token.lval + 1 );
+		case INS_CALL_METHOD_ID:
+		  return values_threadsafe( ins.token.type + 1 );
+		case INS_MULTISUBSCRIPT:
+		  return values_threadsafe( ins.token.lval + 1 );
+		case INS_MULTISUBSCRIPT_ASSIGN:
+		  return values_threadsafe( ins.token.lval + 2 );
+		case INS_GET_MEMBER:
+		case INS_GET_MEMBER_ID:
+		case INS_SET_MEMBER:
+		case INS_SET_MEMBER_CONSUME:
+		case INS_SET_MEMBER_ID:
+		case INS_SET_MEMBER_ID_CONSUME:
+		case INS_SET_MEMBER_ID_CONSUME_PLUSEQUAL:
+		case INS_SET_MEMBER_ID_CONSUME_MINUSEQUAL:
+		case INS_SET_MEMBER_ID_CONSUME_TIMESEQUAL:
+		case INS_SET_MEMBER_ID_CONSUME_DIVIDEEQUAL:
+		case INS_SET_MEMBER_ID_CONSUME_MODULUSEQUAL:
+		case INS_SUBSCRIPT_ASSIGN:
+		case INS_SUBSCRIPT_ASSIGN_CONSUME:
+		case TOK_ARRAY_SUBSCRIPT:
+		case TOK_ADDMEMBER:
+		case TOK_DELMEMBER:
+		case TOK_CHKMEMBER:
+		case INS_DICTIONARY_ADDMEMBER:
+		case INS_ADDMEMBER2:
+		case INS_ADDMEMBER_ASSIGN:
+		case TOK_INSERTINTO:
+		case TOK_IN:
+		case INS_INITFOREACH:
+		  return values_threadsafe( 3 );
+		case RSV_EXIT:
+		case CTRL_PROGEND:
+		  return false;
+		default:
+		  return true;
 	  }
-#endif
 	}
 
     std::string Executor::dbg_get_instruction(size_t atPC) const
@@ -3312,8 +3563,7 @@ namespace Pol {
 
 	  while ( runnable() )
 	  {
-		Clib::scripts_thread_scriptPC = PC;
-		execInstr();
+		execInstrs( UINT_MAX );
 	  }
 
 	  return !error_;
@@ -3405,6 +3655,22 @@ namespace Pol {
 	  return NULL;
 	}
 
+	ExecutorModule* Executor::createModule( const std::string& name )
+	{
+	  if ( module_factories_ == NULL )
+		return NULL;
+	  for ( const auto& factory : *module_factories_ )
+	  {
+		if ( stricmp( factory.name, name.c_str() ) == 0 )
+		{
+		  ExecutorModule* module = factory.create( *this );
+		  addModule( module );
+		  return module;
+		}
+	  }
+	  return NULL;
+	}
+
 	void Executor::attach_debugger()
 	{
 	  setdebugging( true );
@@ -3481,7 +3747,7 @@ namespace Pol {
         if ( bojectref != nullptr )
           size += bojectref->sizeEstimate();
       }
-      size += 3 * sizeof(BObjectRef*)+ValueStack.size() * sizeof( BObjectRef );
+      size += 3 * sizeof(BObjectRef*)+ValueStack.capacity() * sizeof( BObjectRef );
       for ( const auto& bojectref : ValueStack )
       {
         if ( bojectref != nullptr )
@@ -2,6 +2,7 @@
 History
 =======
 2009/09/05 Turley: Added struct .? and .- as shortcut for .exists() and .erase()
+2026/10/17 agent:  Added module factories, modules are only created if the program uses them
 
 Notes
 =======
@@ -30,6 +31,7 @@ Notes
 #include "fmodule.h"
 #include "eprog.h"
 
+#include <chrono>
 #include <stack>
 #include <deque>
 #include <vector>
@@ -44,9 +46,18 @@ namespace Pol {
   namespace Bscript {
 	class Executor;
 	class EScriptProgram;
+	class ExecutorModule;
 	class BLong;
 	class String;
 
+	// creates the module named name for ex, see Executor::setModuleFactories
+	struct ExecutorModuleFactory
+	{
+	  const char* name;
+	  ExecutorModule* ( *create )( Executor& ex );
+	};
+	typedef std::vector<ExecutorModuleFactory> ExecutorModuleFactories;
+
 #ifdef ESCRIPT_PROFILE
 	struct profile_instr
 	{
@@ -59,7 +70,8 @@ namespace Pol {
 	extern escript_profile_map EscriptProfileMap;
 #endif
 
-	typedef std::deque<BObjectRef> ValueStackCont;
+	// contiguous, it is reserved once per executor (see Executor::Executor)
+	typedef std::vector<BObjectRef> ValueStackCont;
 	// FIXME: how to make this a nested struct in Executor?
 	struct ReturnContext
 	{
@@ -203,12 +215,21 @@ namespace Pol {
 
 	  void addModule( ExecutorModule* module ); // NOTE, executor deletes its modules when done
 	  ExecutorModule* findModule( const std::string& name );
+	  // modules which are created by setProgram only if the program uses them,
+	  // the factories need to outlive the executor
+	  void setModuleFactories( const ExecutorModuleFactories* factories ) { module_factories_ = factories; }
 
 	  ModuleFunction* current_module_function;
 	  // NOTE: the debugger code expects these to be virtual..
 	  void execFunc( const Token& token );
 	  void innerExec( const Instruction& ins );
 	  void execInstr();
+	  unsigned execInstrs( unsigned count );
+	  // execInstr() for the script worker threads. The cycle counters of the instructions,
+	  // the program and escript_instr_cycles are shared with other executors, so only the
+	  // PC is recorded here and add_unlocked_cycles() counts it under the world lock.
+	  void execInstrUnlocked();
+	  void add_unlocked_cycles();
 
 	  void ins_nop( const Instruction& ins );
 	  void ins_jmpiftrue( const Instruction& ins );
@@ -327,6 +348,9 @@ namespace Pol {
 	  bool runnable() const;
 	  void calcrunnable();
 
+	  bool next_instr_threadsafe() const;
+	  bool values_threadsafe( size_t count ) const;
+
 	  bool halt() const;
 	  void sethalt( bool halt );
 
@@ -362,6 +386,10 @@ namespace Pol {
 	  ref_ptr<EScriptProgram> prog_;
 	  bool prog_ok_;
 	  bool viewmode_;
+	  const ExecutorModuleFactories* module_factories_;
+	  std::chrono::steady_clock::time_point created_; // for EScriptProgram::startup_ns
+
+	  ExecutorModule* createModule( const std::string& name );
 
 	  bool debugging_;
 	  enum DEBUG_STATE
@@ -384,6 +412,9 @@ namespace Pol {
 	  unsigned bp_skip_;
 
 	  BObjectImp* func_result_;
+	  std::vector<unsigned> unlocked_pcs_; // executed by execInstrUnlocked(), not yet counted
+
+	  void instr_exception( unsigned onPC, const char* what );
 
 	private: // not implemented
 	  Executor( const Executor& exec );
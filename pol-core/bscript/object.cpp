@@ -5,6 +5,7 @@ History
 2008/02/11 Turley:    ObjArray::unpack() will accept zero length Arrays and Erros from Array-Elements
 2009/09/05 Turley:    Added struct .? and .- as shortcut for .exists() and .erase()
 2009/12/21 Turley:    ._method() call fix
+2026/10/17 agent:     fork handlers for the allocator freelists
 
 Notes
 =======
@@ -34,6 +35,10 @@ Notes
 #include <unordered_map>
 #endif
 
+#if defined( PARALLEL_SCRIPTS ) && !defined( _WIN32 )
+#include <pthread.h>
+#endif
+
 #ifdef _MSC_VER
 #pragma warning(disable:4996) // deprecation warning for stricmp
 #endif
@@ -45,6 +50,32 @@ namespace Pol {
 	Clib::fixed_allocator<sizeof( BLong ), 256> blong_alloc;
 	Clib::fixed_allocator<sizeof( Double ), 256> double_alloc;
 
+#if defined( PARALLEL_SCRIPTS ) && !defined( _WIN32 )
+	namespace
+	{
+	  // script worker threads use the freelists without the world lock, a fork (snapshot save)
+	  // while one of them holds a freelist lock would leave it locked forever in the child
+	  void lock_allocators()
+	  {
+		bobject_alloc.lock_freelist();
+		uninit_alloc.lock_freelist();
+		blong_alloc.lock_freelist();
+		double_alloc.lock_freelist();
+	  }
+	  void unlock_allocators()
+	  {
+		double_alloc.unlock_freelist();
+		blong_alloc.unlock_freelist();
+		uninit_alloc.unlock_freelist();
+		bobject_alloc.unlock_freelist();
+	  }
+	  struct AllocatorForkHandlers
+	  {
+		AllocatorForkHandlers() { pthread_atfork( lock_allocators, unlock_allocators, unlock_allocators ); }
+	  } allocator_fork_handlers;
+	}
+#endif
+
 	size_t BObjectRef::sizeEstimate() const
 	{
 	  if ( get() )
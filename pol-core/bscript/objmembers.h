@@ -247,7 +247,8 @@ namespace Pol {
 	  MBR_SPEED_MOD,
 	  MBR_NAME_SUFFIX,
 	  MBR_TEMPORALLY_CRIMINAL, //210
-      MBR_LAST_TEXTCOLOR
+      MBR_LAST_TEXTCOLOR,
+      MBR_TRANSMIT_STATS
 	};
 
 
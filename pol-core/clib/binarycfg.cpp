@@ -0,0 +1,515 @@
+/*
+History
+=======
+
+Notes
+=======
+
+*/
+
+#include "binarycfg.h"
+
+#include "cfgelem.h"
+#include "logfacility.h"
+#include "stlutil.h"
+#include "strutil.h"
+
+#include "../../lib/format/format.h"
+
+#include <stdexcept>
+#include <stdio.h>
+#include <string.h>
+
+
+namespace Pol {
+  namespace Clib {
+    namespace
+    {
+      const char MAGIC[8] = { 'P', 'O', 'L', 'B', 'C', 'F', 'G', '\0' };
+      const size_t HEADER_SIZE = sizeof MAGIC + 4;
+
+      const unsigned char RECORD_NAME = 1;
+      const unsigned char RECORD_ELEM = 2;
+
+      // elements decoded per batch, and batches kept ready, when prefetching
+      const size_t PREFETCH_BATCH_SIZE = 512;
+      const size_t PREFETCH_MAX_BATCHES = 8;
+
+      void append_varint( std::string& out, size_t value )
+      {
+        while ( value >= 0x80 )
+        {
+          out += static_cast<char>( ( value & 0x7F ) | 0x80 );
+          value >>= 7;
+        }
+        out += static_cast<char>( value );
+      }
+
+      void append_string( std::string& out, const std::string& str )
+      {
+        append_varint( out, str.size() );
+        out += str;
+      }
+
+      class Decoder
+      {
+      public:
+        Decoder( const unsigned char* data, size_t size, size_t pos ) :
+          _data( data ), _size( size ), _pos( pos )
+        {}
+
+        size_t varint()
+        {
+          size_t value = 0;
+          unsigned shift = 0;
+          for ( ;; )
+          {
+            if ( _pos >= _size )
+              throw std::runtime_error( "Unexpected end of file in record" );
+            unsigned char ch = _data[_pos++];
+            if ( shift >= sizeof( size_t ) * 8 )
+              throw std::runtime_error( "Malformed length in record" );
+            value |= static_cast<size_t>( ch & 0x7F ) << shift;
+            if ( ( ch & 0x80 ) == 0 )
+              return value;
+            shift += 7;
+          }
+        }
+
+        void string( std::string& out )
+        {
+          size_t len = varint();
+          if ( len > _size - _pos )
+            throw std::runtime_error( "Unexpected end of file in string" );
+          out.assign( reinterpret_cast<const char*>( _data + _pos ), len );
+          _pos += len;
+        }
+
+        size_t pos() const { return _pos; }
+      private:
+        const unsigned char* _data;
+        size_t _size;
+        size_t _pos;
+      };
+
+      bool needs_quoting( const std::string& value )
+      {
+        if ( value.empty() )
+          return false;
+        if ( value[0] == '\"' || isspace( static_cast<unsigned char>( value[0] ) ) ||
+             isspace( static_cast<unsigned char>( value[value.size() - 1] ) ) )
+          return true;
+        return value.find( '\n' ) != std::string::npos;
+      }
+    }
+
+    BinaryConfigWriter::BinaryConfigWriter( const std::string& filename ) :
+      _filename( filename ),
+      _ofs(),
+      _names(),
+      _payload()
+    {
+      _ofs.open( filename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc );
+      if ( !_ofs.is_open() )
+        throw std::runtime_error( "Unable to create " + filename );
+
+      unsigned char header[HEADER_SIZE];
+      memcpy( header, MAGIC, sizeof MAGIC );
+      header[8] = static_cast<unsigned char>( VERSION & 0xFF );
+      header[9] = static_cast<unsigned char>( ( VERSION >> 8 ) & 0xFF );
+      header[10] = static_cast<unsigned char>( ( VERSION >> 16 ) & 0xFF );
+      header[11] = static_cast<unsigned char>( ( VERSION >> 24 ) & 0xFF );
+      _ofs.write( reinterpret_cast<const char*>( header ), sizeof header );
+    }
+
+    BinaryConfigWriter::~BinaryConfigWriter()
+    {
+      if ( _ofs.is_open() )
+        _ofs.close();
+    }
+
+    unsigned int BinaryConfigWriter::name_id( const std::string& name )
+    {
+      auto itr = _names.find( name );
+      if ( itr != _names.end() )
+        return itr->second;
+
+      unsigned int id = static_cast<unsigned int>( _names.size() );
+      _names.insert( std::make_pair( name, id ) );
+
+      std::string rec;
+      rec += static_cast<char>( RECORD_NAME );
+      append_string( rec, name );
+      _ofs.write( rec.data(), rec.size() );
+      return id;
+    }
+
+    void BinaryConfigWriter::write( const ConfigElem& elem )
+    {
+      // names go out ahead of the element that first uses them
+      _payload.clear();
+      append_varint( _payload, name_id( elem.type_ ) );
+      append_string( _payload, elem.rest_ );
+      append_varint( _payload, elem.properties.size() );
+      for ( const auto& prop : elem.properties )
+      {
+        append_varint( _payload, name_id( prop.first ) );
+        append_string( _payload, prop.second );
+      }
+
+      std::string head;
+      head += static_cast<char>( RECORD_ELEM );
+      append_varint( head, _payload.size() );
+      _ofs.write( head.data(), head.size() );
+      _ofs.write( _payload.data(), _payload.size() );
+    }
+
+    void BinaryConfigWriter::close()
+    {
+      _ofs.flush();
+      bool ok = _ofs.good();
+      _ofs.close();
+      if ( !ok )
+        throw std::runtime_error( "Error writing " + _filename );
+    }
+
+    BinaryConfigFile::BinaryConfigFile( const std::string& filename, const char *allowed_types_str ) :
+      _filename( filename ),
+      _data( NULL ),
+      _size( 0 ),
+      _pos( 0 ),
+      _file(),
+      _names(),
+      _element_count( 0 ),
+      allowed_types_(),
+      _thread(),
+      _mutex(),
+      _ready(),
+      _space(),
+      _batches(),
+      _current(),
+      _prefetching( false ),
+      _done( false ),
+      _stop( false ),
+      _error()
+    {
+      map_file();
+
+      if ( _size < HEADER_SIZE || memcmp( _data, MAGIC, sizeof MAGIC ) != 0 )
+      {
+        unmap_file();
+        ERROR_PRINT << "File " << _filename << " is not a binary configuration file\n";
+        throw std::runtime_error( "Bad header in " + _filename );
+      }
+      unsigned int version = _data[8] | ( _data[9] << 8 ) | ( _data[10] << 16 ) | ( _data[11] << 24 );
+      if ( version != BinaryConfigWriter::VERSION )
+      {
+        unmap_file();
+        ERROR_PRINT << "File " << _filename << " has unsupported version " << version << "\n";
+        throw std::runtime_error( "Unsupported version in " + _filename );
+      }
+      _pos = HEADER_SIZE;
+
+      if ( allowed_types_str != NULL )
+      {
+        ISTRINGSTREAM is( allowed_types_str );
+        std::string tag;
+        while ( is >> tag )
+          allowed_types_.insert( tag );
+      }
+    }
+
+    BinaryConfigFile::~BinaryConfigFile()
+    {
+      stop_prefetch();
+      unmap_file();
+    }
+
+    void BinaryConfigFile::map_file()
+    {
+      try
+      {
+        _file.Open( _filename );
+      }
+      catch ( std::exception& )
+      {
+        ERROR_PRINT << "Unable to open configuration file " << _filename << "\n";
+        throw std::runtime_error( "Unable to open configuration file " + _filename );
+      }
+      _file.AdviseSequential();
+      _data = _file.data();
+      _size = _file.size();
+    }
+
+    void BinaryConfigFile::unmap_file()
+    {
+      _file.Close();
+      _data = NULL;
+      _size = 0;
+    }
+
+    const std::string& BinaryConfigFile::filename() const
+    {
+      return _filename;
+    }
+
+    unsigned BinaryConfigFile::element_count() const
+    {
+      return _element_count;
+    }
+
+    bool BinaryConfigFile::decode( ConfigElem& elem )
+    {
+      elem.properties.clear();
+      elem.type_.clear();
+      elem.rest_.clear();
+      elem._source = this;
+
+      while ( _pos < _size )
+      {
+        unsigned char kind = _data[_pos++];
+        Decoder dec( _data, _size, _pos );
+        if ( kind == RECORD_NAME )
+        {
+          _names.push_back( std::string() );
+          dec.string( _names.back() );
+          _pos = dec.pos();
+        }
+        else if ( kind == RECORD_ELEM )
+        {
+          size_t len = dec.varint();
+          if ( len > _size - dec.pos() )
+            throw std::runtime_error( "Unexpected end of file in element" );
+          size_t end = dec.pos() + len;
+          Decoder body( _data, end, dec.pos() );
+
+          size_t type_id = body.varint();
+          if ( type_id >= _names.size() )
+            throw std::runtime_error( "Undefined element name" );
+          elem.type_ = _names[type_id];
+          body.string( elem.rest_ );
+
+          size_t count = body.varint();
+          std::string value;
+          for ( size_t i = 0; i < count; ++i )
+          {
+            size_t name_id = body.varint();
+            if ( name_id >= _names.size() )
+              throw std::runtime_error( "Undefined property name" );
+            body.string( value );
+            elem.properties.insert( std::make_pair( _names[name_id], value ) );
+          }
+          if ( body.pos() != end )
+            throw std::runtime_error( "Element length mismatch" );
+          _pos = end;
+
+          if ( !allowed_types_.empty() && allowed_types_.find( elem.type_ ) == allowed_types_.end() )
+          {
+            fmt::Writer os;
+            os << "Unexpected type '" << elem.type_ << "'\n";
+            os << "\tValid types are:";
+            for ( const auto& type : allowed_types_ )
+              os << " " << type;
+            throw std::runtime_error( os.str() );
+          }
+          return true;
+        }
+        else
+        {
+          throw std::runtime_error( "Unknown record type" );
+        }
+      }
+      return false;
+    }
+
+    void BinaryConfigFile::start_prefetch()
+    {
+      if ( _prefetching )
+        return;
+      _prefetching = true;
+      _thread = std::thread( [this]() { prefetch_thread(); } );
+    }
+
+    void BinaryConfigFile::prefetch_thread()
+    {
+      std::string error;
+      bool more = true;
+      while ( more )
+      {
+        std::unique_ptr<Batch> batch( new Batch );
+        try
+        {
+          while ( batch->size() < PREFETCH_BATCH_SIZE )
+          {
+            batch->emplace_back();
+            if ( !decode( batch->back() ) )
+            {
+              batch->pop_back();
+              more = false;
+              break;
+            }
+          }
+        }
+        catch ( std::exception& ex )
+        {
+          // hand out what was decoded before the error
+          batch->pop_back();
+          error = ex.what();
+          more = false;
+        }
+
+        std::unique_lock<std::mutex> lock( _mutex );
+        _space.wait( lock, [this]() { return _stop || _batches.size() < PREFETCH_MAX_BATCHES; } );
+        if ( _stop )
+          return;
+        if ( !batch->empty() )
+          _batches.push_back( std::move( batch ) );
+        if ( !more )
+        {
+          _error = error;
+          _done = true;
+        }
+        _ready.notify_one();
+      }
+    }
+
+    void BinaryConfigFile::stop_prefetch()
+    {
+      if ( !_thread.joinable() )
+        return;
+      {
+        std::lock_guard<std::mutex> lock( _mutex );
+        _stop = true;
+        _space.notify_one();
+      }
+      _thread.join();
+    }
+
+    bool BinaryConfigFile::read( ConfigElem& elem )
+    {
+      try
+      {
+        if ( !_prefetching )
+        {
+          if ( !decode( elem ) )
+            return false;
+          ++_element_count;
+          return true;
+        }
+
+        if ( !_current || _current->empty() )
+        {
+          std::unique_lock<std::mutex> lock( _mutex );
+          _ready.wait( lock, [this]() { return _done || !_batches.empty(); } );
+          if ( _batches.empty() )
+          {
+            if ( !_error.empty() )
+              throw std::runtime_error( _error );
+            return false;
+          }
+          _current = std::move( _batches.front() );
+          _batches.pop_front();
+          _space.notify_one();
+        }
+
+        ConfigElem& next = _current->front();
+        elem.type_.swap( next.type_ );
+        elem.rest_.swap( next.rest_ );
+        elem.properties.swap( next.properties );
+        elem._source = this;
+        _current->pop_front();
+        ++_element_count;
+        return true;
+      }
+      catch ( std::exception& ex )
+      {
+        display_error( ex.what() );
+        throw;
+      }
+    }
+
+    void BinaryConfigFile::display_error( const std::string& msg,
+                                          bool show_curline,
+                                          const ConfigElemBase* elem,
+                                          bool error ) const
+    {
+      fmt::Writer tmp;
+      tmp << ( error ? "Error" : "Warning" )
+        << " reading configuration file " << _filename << ":\n"
+        << "\t" << msg << "\n";
+      if ( elem != NULL && strlen( elem->type() ) > 0 )
+        tmp << "\tElement: " << elem->type() << " " << elem->rest() << "\n";
+      if ( show_curline )
+        tmp << "\tNear element: " << _element_count << "\n";
+      ERROR_PRINT << tmp.c_str();
+    }
+
+    bool convert_text_to_binary_cfg( const std::string& textfile, const std::string& binfile )
+    {
+      try
+      {
+        ConfigFile cf( textfile );
+        BinaryConfigWriter writer( binfile );
+        ConfigElem elem;
+        while ( cf.read( elem ) )
+          writer.write( elem );
+        writer.close();
+        return true;
+      }
+      catch ( std::exception& ex )
+      {
+        ERROR_PRINT << "Unable to convert " << textfile << " to " << binfile << ": " << ex.what() << "\n";
+        remove( binfile.c_str() );
+        return false;
+      }
+    }
+
+    bool convert_binary_to_text_cfg( const std::string& binfile, const std::string& textfile )
+    {
+      try
+      {
+        BinaryConfigFile bf( binfile );
+        std::ofstream ofs( textfile.c_str(), std::ios::out | std::ios::trunc );
+        if ( !ofs.is_open() )
+          throw std::runtime_error( "Unable to create " + textfile );
+
+        ConfigElem elem;
+        std::string name, value;
+        fmt::Writer out;
+        while ( bf.read( elem ) )
+        {
+          out << elem.type();
+          if ( elem.rest()[0] != '\0' )
+            out << " " << elem.rest();
+          out << "\n{\n";
+          while ( elem.remove_first_prop( &name, &value ) )
+          {
+            out << "\t" << name << "\t";
+            if ( needs_quoting( value ) )
+              out << getencodedquotedstring( value );
+            else
+              out << value;
+            out << "\n";
+          }
+          out << "}\n\n";
+          if ( out.size() >= 0x10000 )
+          {
+            ofs << out.c_str();
+            out.Clear();
+          }
+        }
+        ofs << out.c_str();
+        ofs.flush();
+        if ( !ofs.good() )
+          throw std::runtime_error( "Error writing " + textfile );
+        return true;
+      }
+      catch ( std::exception& ex )
+      {
+        ERROR_PRINT << "Unable to convert " << binfile << " to " << textfile << ": " << ex.what() << "\n";
+        remove( textfile.c_str() );
+        return false;
+      }
+    }
+  }
+}
@@ -0,0 +1,123 @@
+/*
+History
+=======
+
+Notes
+=======
+Binary form of the text config files used for the world data.
+
+Layout (all integers little endian, "varint" is LEB128):
+  header   "POLBCFG\0" u32 version
+  records  u8 kind, followed by
+    kind 1 (name)     varint length, bytes
+                      assigns the next name id, starting at 0
+    kind 2 (element)  varint payload length, payload:
+                        varint type name id, string rest,
+                        varint property count,
+                        count * ( varint name id, string value )
+  strings  varint length, bytes
+
+Element and property names are interned: each distinct name is written
+once, the first time it is used, and referenced by id afterwards.
+Values are stored exactly as ConfigElem holds them, so packed CProp
+values ("i123", "S5:hello", ...) are written without re-encoding.
+*/
+
+#ifndef CLIB_BINARYCFG_H
+#define CLIB_BINARYCFG_H
+
+#include "cfgfile.h"
+#include "mappedfile.h"
+#include "maputil.h"
+
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Pol {
+  namespace Clib {
+	class ConfigElem;
+
+	class BinaryConfigWriter
+	{
+	public:
+	  explicit BinaryConfigWriter( const std::string& filename );
+	  ~BinaryConfigWriter();
+
+	  void write( const ConfigElem& elem );
+	  void close();
+
+	  static const unsigned int VERSION = 1;
+	private:
+	  unsigned int name_id( const std::string& name );
+
+	  std::string _filename;
+	  std::ofstream _ofs;
+	  std::map<std::string, unsigned int> _names;
+	  std::string _payload;
+	};
+
+	class BinaryConfigFile : public ConfigSource
+	{
+	public:
+	  explicit BinaryConfigFile( const std::string& filename, const char *allowed_types = NULL );
+	  virtual ~BinaryConfigFile();
+
+	  // decode elements on a separate thread ahead of read()
+	  void start_prefetch();
+
+	  bool read( ConfigElem& elem );        // true=got one, false=end of file
+
+	  const std::string& filename() const;
+	  unsigned element_count() const;
+
+	  virtual void display_error( const std::string& msg,
+								  bool show_curline = true,
+								  const ConfigElemBase* elem = NULL,
+								  bool error = true ) const POL_OVERRIDE;
+
+	private:
+	  void map_file();
+	  void unmap_file();
+	  bool decode( ConfigElem& elem );
+	  void prefetch_thread();
+	  void stop_prefetch();
+
+	  std::string _filename;
+	  const unsigned char* _data;
+	  size_t _size;
+	  size_t _pos;
+	  MappedFile _file;
+	  std::vector<std::string> _names;
+	  unsigned _element_count;
+
+	  typedef std::set<std::string, ci_cmp_pred> AllowedTypesCont;
+	  AllowedTypesCont allowed_types_;
+
+	  typedef std::deque<ConfigElem> Batch;
+	  std::thread _thread;
+	  std::mutex _mutex;
+	  std::condition_variable _ready;
+	  std::condition_variable _space;
+	  std::deque<std::unique_ptr<Batch>> _batches;
+	  std::unique_ptr<Batch> _current;
+	  bool _prefetching;
+	  bool _done;
+	  bool _stop;
+	  std::string _error;
+	};
+
+	// convert a text config file to binary form and back.
+	// return false (after logging) if the input could not be read.
+	bool convert_text_to_binary_cfg( const std::string& textfile, const std::string& binfile );
+	bool convert_binary_to_text_cfg( const std::string& binfile, const std::string& textfile );
+  }
+}
+#endif
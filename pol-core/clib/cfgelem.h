@@ -58,6 +58,8 @@ namespace Pol {
 	  ~ConfigElem();
 
 	  friend class ConfigFile;
+	  friend class BinaryConfigFile;
+	  friend class BinaryConfigWriter;
 
 	  bool has_prop( const char* propname ) const;
 
@@ -693,10 +693,6 @@ ConfigFile::~ConfigFile()
 #endif
 }
 
-#if !CFGFILE_USES_IOSTREAMS
-char ConfigFile::buffer[ 1024 ];
-#endif
-
 #if CFGFILE_USES_IOSTREAMS
 // returns true if ended on a }, false if ended on EOF.
 bool ConfigFile::read_properties( ConfigElem& elem )
@@ -829,8 +825,9 @@ bool ConfigFile::readline(std::string& strbuf)
 // returns true if ended on a }, false if ended on EOF.
 bool ConfigFile::read_properties( ConfigElem& elem )
 {
-    static std::string strbuf;
-    static std::string propname, propvalue;
+    std::string& strbuf = strbuf_;
+    std::string& propname = propname_;
+    std::string& propvalue = propvalue_;
 	while (readline( strbuf ))
     {
         ++_cur_line;
@@ -860,8 +857,9 @@ bool ConfigFile::read_properties( ConfigElem& elem )
 }
 bool ConfigFile::read_properties( VectorConfigElem& elem )
 {
-    static std::string strbuf;
-    static std::string propname, propvalue;
+    std::string& strbuf = strbuf_;
+    std::string& propname = propname_;
+    std::string& propvalue = propvalue_;
 	while (readline( strbuf ))
     {
         ++_cur_line;
@@ -86,8 +86,12 @@ namespace Pol {
 	  std::ifstream ifs;
 #else
 	  FILE *fp;
-	  static char buffer[1024];
+	  char buffer[1024];
 #endif
+	  // per-instance scratch so separate files can be parsed on separate threads
+	  std::string strbuf_;
+	  std::string propname_;
+	  std::string propvalue_;
 	  int _element_line_start; // what line in the file did this elem start on?
 	  int _cur_line;
 
@@ -22,8 +22,28 @@ Remove the include in all StdAfx.h files or live with the consequences :)
 #ifdef MEMORYLEAK
 	#include "logfacility.h"
 #endif
+#ifdef PARALLEL_SCRIPTS
+	#include <atomic>
+#endif
 namespace Pol {
   namespace Clib {
+#ifdef PARALLEL_SCRIPTS
+	// the freelist is shared between the script worker threads,
+	// a simple spinlock is enough since it is only held for a few instructions
+	class fixed_allocator_lock
+	{
+	public:
+	  explicit fixed_allocator_lock( std::atomic_flag& flag ) : _flag( flag )
+	  {
+		while ( _flag.test_and_set( std::memory_order_acquire ) )
+		  ;
+	  }
+	  ~fixed_allocator_lock() { _flag.clear( std::memory_order_release ); }
+	private:
+	  std::atomic_flag& _flag;
+	};
+#endif
+
 	template<size_t N, size_t B>
 	class fixed_allocator
 	{
@@ -39,6 +59,12 @@ namespace Pol {
 	  void* allocate( size_t size );
 	  void deallocate( void* size, size_t n );
 
+#ifdef PARALLEL_SCRIPTS
+	  // holds the freelist, so a forked child can't inherit it locked by another thread
+	  void lock_freelist() { while ( lock_.test_and_set( std::memory_order_acquire ) ); }
+	  void unlock_freelist() { lock_.clear( std::memory_order_release ); }
+#endif
+
 #ifdef MEMORYLEAK
 	  fixed_allocator();
 	  ~fixed_allocator();
@@ -49,6 +75,9 @@ namespace Pol {
 	  void* refill( void );
 	private:
 	  Buffer* freelist_;
+#ifdef PARALLEL_SCRIPTS
+	  std::atomic_flag lock_ = ATOMIC_FLAG_INIT;
+#endif
 #ifdef MEMORYLEAK
 	  int buffers;
 	  int requests;
@@ -93,6 +122,9 @@ namespace Pol {
 	  if (max_requests < requests)
 		max_requests = requests;
 #endif
+#ifdef PARALLEL_SCRIPTS
+	  fixed_allocator_lock lock( lock_ );
+#endif
 
 	  Buffer* p = freelist_;
 	  if( p != NULL )
@@ -139,6 +171,9 @@ namespace Pol {
 #ifdef MEMORYLEAK
 	  requests--;
 #endif
+#ifdef PARALLEL_SCRIPTS
+	  fixed_allocator_lock lock( lock_ );
+#endif
 
 	  Buffer* buf = static_cast<Buffer*>( vp );
 	  buf->next = freelist_;
@@ -0,0 +1,173 @@
+/*
+History
+=======
+2026/10/17 agent:     created
+
+Notes
+=======
+std::map with an additional hash index for lookups.
+Iteration order stays the sorted order of the map, only find/count/erase/operator[]
+use the index. Small maps don't need it, so the index is only built once the map
+holds IndexThreshold elements. Keys which Traits::indexable() rejects are only kept
+in the map, as long as such a key is part of the map no index is used.
+
+Traits needs:
+  static bool indexable( const Key& );
+  static size_t hash( const Key& );
+  static bool equal( const Key&, const Key& ); // has to match the equivalence of Compare
+
+*/
+
+#ifndef CLIB_INDEXEDMAP_H
+#define CLIB_INDEXEDMAP_H
+
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+
+namespace Pol {
+  namespace Clib {
+
+	template <class Key, class T, class Compare, class Traits, size_t IndexThreshold = 16>
+	class IndexedMap
+	{
+	  typedef std::map<Key, T, Compare> Map;
+	public:
+	  typedef typename Map::key_type key_type;
+	  typedef typename Map::mapped_type mapped_type;
+	  typedef typename Map::value_type value_type;
+	  typedef typename Map::size_type size_type;
+	  typedef typename Map::iterator iterator;
+	  typedef typename Map::const_iterator const_iterator;
+
+	  IndexedMap() : _map(), _index(), _unindexable( 0 ) {}
+	  IndexedMap( const IndexedMap& other ) : _map( other._map ), _index(), _unindexable( other._unindexable )
+	  {
+		check_index();
+	  }
+	  IndexedMap& operator=( const IndexedMap& other )
+	  {
+		if ( this != &other )
+		{
+		  _index.reset();
+		  _map = other._map;
+		  _unindexable = other._unindexable;
+		  check_index();
+		}
+		return *this;
+	  }
+
+	  iterator begin() { return _map.begin(); }
+	  iterator end() { return _map.end(); }
+	  const_iterator begin() const { return _map.begin(); }
+	  const_iterator end() const { return _map.end(); }
+	  size_type size() const { return _map.size(); }
+	  bool empty() const { return _map.empty(); }
+
+	  iterator find( const Key& key )
+	  {
+		if ( _index && Traits::indexable( key ) )
+		{
+		  auto itr = _index->find( &key );
+		  return itr != _index->end() ? itr->second : _map.end();
+		}
+		return _map.find( key );
+	  }
+	  const_iterator find( const Key& key ) const
+	  {
+		return const_cast<IndexedMap*>( this )->find( key );
+	  }
+	  size_type count( const Key& key ) const
+	  {
+		return find( key ) != end() ? 1 : 0;
+	  }
+
+	  T& operator[]( const Key& key )
+	  {
+		iterator itr = find( key );
+		if ( itr != _map.end() )
+		  return itr->second;
+		return insert_new( key )->second;
+	  }
+
+	  void erase( iterator itr )
+	  {
+		if ( _index )
+		  _index->erase( &itr->first );
+		if ( !Traits::indexable( itr->first ) )
+		  --_unindexable;
+		_map.erase( itr );
+		check_index();
+	  }
+	  size_type erase( const Key& key )
+	  {
+		iterator itr = find( key );
+		if ( itr == _map.end() )
+		  return 0;
+		erase( itr );
+		return 1;
+	  }
+	  void clear()
+	  {
+		_index.reset();
+		_map.clear();
+		_unindexable = 0;
+	  }
+
+	  // memory used by the index, the map nodes are up to the owner
+	  size_t indexSize() const
+	  {
+		if ( !_index )
+		  return 0;
+		return _index->bucket_count() * sizeof( void* ) + _index->size() * ( sizeof( typename Index::value_type ) + sizeof( void* ) );
+	  }
+
+	private:
+	  struct IndexHash
+	  {
+		size_t operator()( const Key* key ) const { return Traits::hash( *key ); }
+	  };
+	  struct IndexEqual
+	  {
+		bool operator()( const Key* a, const Key* b ) const { return Traits::equal( *a, *b ); }
+	  };
+	  // keyed by the address of the key inside the map node, which never moves
+	  typedef std::unordered_map<const Key*, iterator, IndexHash, IndexEqual> Index;
+
+	  iterator insert_new( const Key& key )
+	  {
+		iterator itr = _map.insert( value_type( key, T() ) ).first;
+		if ( !Traits::indexable( itr->first ) )
+		{
+		  ++_unindexable;
+		  _index.reset();
+		}
+		else if ( _index )
+		  _index->insert( typename Index::value_type( &itr->first, itr ) );
+		else
+		  check_index();
+		return itr;
+	  }
+
+	  void check_index()
+	  {
+		if ( _unindexable > 0 || _map.size() < IndexThreshold / 2 )
+		{
+		  _index.reset();
+		  return;
+		}
+		if ( _index || _map.size() < IndexThreshold )
+		  return;
+		_index.reset( new Index( _map.size() ) );
+		for ( iterator itr = _map.begin(); itr != _map.end(); ++itr )
+		  _index->insert( typename Index::value_type( &itr->first, itr ) );
+	  }
+
+	  Map _map;
+	  std::unique_ptr<Index> _index;
+	  size_t _unindexable;
+	};
+  }
+}
+#endif
@@ -0,0 +1,136 @@
+/*
+History
+=======
+
+Notes
+=======
+
+*/
+
+#include "mappedfile.h"
+
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Pol {
+  namespace Clib {
+	MappedFile::MappedFile() :
+	  _filename(),
+	  _data( NULL ),
+	  _size( 0 )
+#ifdef _WIN32
+	  , _file_handle( INVALID_HANDLE_VALUE ),
+	  _mapping_handle( NULL )
+#endif
+	{}
+
+	MappedFile::MappedFile( const std::string& filename ) :
+	  _filename(),
+	  _data( NULL ),
+	  _size( 0 )
+#ifdef _WIN32
+	  , _file_handle( INVALID_HANDLE_VALUE ),
+	  _mapping_handle( NULL )
+#endif
+	{
+	  Open( filename );
+	}
+
+	MappedFile::~MappedFile()
+	{
+	  Close();
+	}
+
+	void MappedFile::Open( const std::string& filename )
+	{
+	  Close();
+	  _filename = filename;
+#ifdef _WIN32
+	  HANDLE file = CreateFileA( filename.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL );
+	  if ( file == INVALID_HANDLE_VALUE )
+		throw std::runtime_error( "Unable to open " + filename );
+	  LARGE_INTEGER filesize;
+	  if ( !GetFileSizeEx( file, &filesize ) )
+	  {
+		CloseHandle( file );
+		throw std::runtime_error( "Unable to stat " + filename );
+	  }
+	  _file_handle = file;
+	  _size = static_cast<size_t>( filesize.QuadPart );
+	  if ( _size == 0 )
+		return; // an empty file can't be mapped
+	  _mapping_handle = CreateFileMappingA( file, NULL, PAGE_READONLY, 0, 0, NULL );
+	  if ( _mapping_handle == NULL )
+	  {
+		Close();
+		throw std::runtime_error( "Unable to map " + filename );
+	  }
+	  void* p = MapViewOfFile( _mapping_handle, FILE_MAP_READ, 0, 0, 0 );
+	  if ( p == NULL )
+	  {
+		Close();
+		throw std::runtime_error( "Unable to map " + filename );
+	  }
+	  _data = static_cast<const unsigned char*>( p );
+#else
+	  int fd = ::open( filename.c_str(), O_RDONLY );
+	  if ( fd < 0 )
+		throw std::runtime_error( "Unable to open " + filename );
+	  struct stat st;
+	  if ( fstat( fd, &st ) != 0 )
+	  {
+		::close( fd );
+		throw std::runtime_error( "Unable to stat " + filename );
+	  }
+	  _size = static_cast<size_t>( st.st_size );
+	  if ( _size > 0 )
+	  {
+		void* p = mmap( NULL, _size, PROT_READ, MAP_SHARED, fd, 0 );
+		if ( p == MAP_FAILED )
+		{
+		  ::close( fd );
+		  _size = 0;
+		  throw std::runtime_error( "Unable to map " + filename );
+		}
+		_data = static_cast<const unsigned char*>( p );
+	  }
+	  ::close( fd );
+#endif
+	}
+
+	void MappedFile::Close()
+	{
+#ifdef _WIN32
+	  if ( _data != NULL )
+		UnmapViewOfFile( _data );
+	  if ( _mapping_handle != NULL )
+		CloseHandle( _mapping_handle );
+	  if ( _file_handle != INVALID_HANDLE_VALUE )
+		CloseHandle( _file_handle );
+	  _mapping_handle = NULL;
+	  _file_handle = INVALID_HANDLE_VALUE;
+#else
+	  if ( _data != NULL )
+		munmap( const_cast<unsigned char*>( _data ), _size );
+#endif
+	  _data = NULL;
+	  _size = 0;
+	}
+
+	void MappedFile::AdviseSequential() const
+	{
+#ifndef _WIN32
+	  if ( _data != NULL )
+		madvise( const_cast<unsigned char*>( _data ), _size, MADV_SEQUENTIAL );
+#endif
+	}
+  }
+}
@@ -0,0 +1,68 @@
+/*
+History
+=======
+
+Notes
+=======
+Read only view of a whole file. The pages are shared with the page cache (and
+every other process mapping the same file) and only read in when touched.
+*/
+
+#ifndef CLIB_MAPPEDFILE_H
+#define CLIB_MAPPEDFILE_H
+
+#include <boost/noncopyable.hpp>
+
+#include <string>
+#include <cstddef>
+
+namespace Pol {
+  namespace Clib {
+
+	class MappedFile : boost::noncopyable
+	{
+	public:
+	  MappedFile();
+	  explicit MappedFile( const std::string& filename );
+	  ~MappedFile();
+
+	  // throws if the file can't be opened or mapped
+	  void Open( const std::string& filename );
+	  void Close();
+
+	  bool is_open() const;
+	  const unsigned char* data() const;
+	  size_t size() const;
+	  const std::string& filename() const;
+
+	  // hint that the file is read from front to back
+	  void AdviseSequential() const;
+	private:
+	  std::string _filename;
+	  const unsigned char* _data;
+	  size_t _size;
+#ifdef _WIN32
+	  void* _file_handle;
+	  void* _mapping_handle;
+#endif
+	};
+
+	inline bool MappedFile::is_open() const
+	{
+	  return _data != NULL;
+	}
+	inline const unsigned char* MappedFile::data() const
+	{
+	  return _data;
+	}
+	inline size_t MappedFile::size() const
+	{
+	  return _size;
+	}
+	inline const std::string& MappedFile::filename() const
+	{
+	  return _filename;
+	}
+  }
+}
+#endif
@@ -11,6 +11,7 @@ Notes
 #define CLIB_MAPUTIL_H
 
 #include "clib.h"
+#include <cctype>
 #include <cstring>
 #include <string>
 
@@ -29,6 +30,18 @@ namespace Pol {
 		return stricmp( x1.c_str(), x2.c_str() ) < 0;
 	  }
 	};
+
+	// hash matching ci_cmp_pred, equal strings in any case get the same value
+	inline size_t ci_hash( const std::string& x )
+	{
+	  size_t h = 2166136261u;
+	  for ( const char c : x )
+	  {
+		h ^= static_cast<size_t>( tolower( static_cast<unsigned char>( c ) ) );
+		h *= 16777619u;
+	  }
+	  return h;
+	}
   }
 }
 #ifdef _MSC_VER
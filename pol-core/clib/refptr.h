@@ -25,6 +25,12 @@ Remove the include in all StdAfx.h files or live with the consequences :)
 
 #define REFERER_PARAM(x)
 
+// PARALLEL_SCRIPTS: scripts may run on several threads at once (see run_ready()),
+// so the reference count has to be atomic.
+#ifdef PARALLEL_SCRIPTS
+#include <atomic>
+#endif
+
 class ref_counted
 {
 // Construction
@@ -51,7 +57,11 @@ public:
 #endif
     // Representation
 protected:
+#ifdef PARALLEL_SCRIPTS
+    std::atomic<unsigned int> _count;
+#else
     unsigned int _count;
+#endif
 #if REFPTR_DEBUG
     unsigned int _cumulative_references;
     unsigned int _instance;
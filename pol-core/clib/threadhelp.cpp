@@ -8,6 +8,7 @@ History
 2007/03/08 Shinigami: added pthread_exit and _endhreadex to close threads
 2008/03/02 Nando: Added bool dec_child to create_thread, used to dec_child_thread_count()
                   if there is an error on create_thread. Will fix some of the zombies.
+2026/10/17 agent:     fork handlers for the thread map lock
 
 Notes
 =======
@@ -122,6 +123,8 @@ namespace Pol {
 
     static pthread_attr_t create_detached_attr;
 
+    void threadmap_lock();
+    void threadmap_unlock();
 
     void init_threadhelp()
     {
@@ -139,6 +142,11 @@ namespace Pol {
       res = pthread_mutex_init( &threadmap_sem, &threadmap_sem_attr );
       passert_always( res == 0 );
 
+      // a fork (snapshot save) while another thread (un)registers would leave the
+      // map locked forever in the child
+      res = pthread_atfork( threadmap_lock, threadmap_unlock, threadmap_unlock );
+      passert_always( res == 0 );
+
       res = pthread_attr_init( &create_detached_attr );
       passert_always( res == 0 );
       res = pthread_attr_setdetachstate( &create_detached_attr, PTHREAD_CREATE_DETACHED );
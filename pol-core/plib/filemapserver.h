@@ -27,6 +27,7 @@ namespace Pol {
 	  virtual ~FileMapServer() {}
 
 	  virtual MAPCELL GetMapCell( unsigned short x, unsigned short y ) const POL_OVERRIDE;
+	  virtual bool threadsafe() const POL_OVERRIDE { return false; } // the current block is cached
       virtual size_t sizeEstimate( ) const POL_OVERRIDE;
 	protected:
 	  mutable Clib::BinaryFile _mapfile;
@@ -0,0 +1,50 @@
+/*
+History
+=======
+
+Notes
+=======
+
+*/
+
+#include "mappedmapserver.h"
+
+#include "../clib/passert.h"
+
+#include <stdexcept>
+
+namespace Pol {
+  namespace Plib {
+	MappedMapServer::MappedMapServer( const RealmDescriptor& descriptor ) :
+	  MapServer( descriptor, true ),
+	  _mapfile( descriptor.path( "base.dat" ) ),
+	  _mapblocks( reinterpret_cast<const MAPBLOCK*>( _mapfile.data() ) )
+	{
+	  size_t n_blocks = ( _descriptor.width >> MAPBLOCK_SHIFT ) * ( _descriptor.height >> MAPBLOCK_SHIFT );
+	  if ( _mapfile.size() < n_blocks * sizeof( MAPBLOCK ) )
+		throw std::runtime_error( _mapfile.filename() + " is too small for the realm size." );
+	}
+
+	MappedMapServer::~MappedMapServer()
+	{}
+
+	MAPCELL MappedMapServer::GetMapCell( unsigned short x, unsigned short y ) const
+	{
+	  passert( x < _descriptor.width && y < _descriptor.height );
+
+	  unsigned short xblock = x >> MAPBLOCK_SHIFT;
+	  unsigned short xcell = x &   MAPBLOCK_CELLMASK;
+	  unsigned short yblock = y >> MAPBLOCK_SHIFT;
+	  unsigned short ycell = y &   MAPBLOCK_CELLMASK;
+
+	  int block_index = yblock * ( _descriptor.width >> MAPBLOCK_SHIFT ) + xblock;
+	  return _mapblocks[block_index].cell[xcell][ycell];
+	}
+
+	size_t MappedMapServer::sizeEstimate() const
+	{
+	  // the map itself lives in the page cache
+	  return sizeof( *this ) + MapServer::sizeEstimate();
+	}
+  }
+}
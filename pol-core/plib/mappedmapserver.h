@@ -0,0 +1,43 @@
+/*
+History
+=======
+
+Notes
+=======
+MapServer reading base.dat and the solids files through a file mapping.
+Nothing is copied at startup, pages are read in when first used and shared
+with every other process mapping the same realm.
+*/
+
+#ifndef PLIB_MAPPEDMAPSERVER_H
+#define PLIB_MAPPEDMAPSERVER_H
+
+#include "../clib/compilerspecifics.h"
+#include "../clib/mappedfile.h"
+
+#include "mapblock.h"
+#include "mapcell.h"
+#include "mapserver.h"
+
+namespace Pol {
+  namespace Plib {
+	class MappedMapServer : public MapServer
+	{
+	public:
+	  explicit MappedMapServer( const RealmDescriptor& descriptor );
+	  virtual ~MappedMapServer();
+
+	  virtual MAPCELL GetMapCell( unsigned short x, unsigned short y ) const POL_OVERRIDE;
+	  virtual size_t sizeEstimate() const POL_OVERRIDE;
+
+	private:
+	  Clib::MappedFile _mapfile;
+	  const MAPBLOCK* _mapblocks;
+
+	  // not implemented:
+	  MappedMapServer& operator=( const MappedMapServer& );
+	  MappedMapServer( const MappedMapServer& );
+	};
+  }
+}
+#endif
@@ -11,6 +11,7 @@ Notes
 
 #include "filemapserver.h"
 #include "inmemorymapserver.h"
+#include "mappedmapserver.h"
 #include "mapblock.h"
 #include "mapshape.h"
 #include "mapsolid.h"
@@ -24,8 +25,19 @@ Notes
 
 namespace Pol {
   namespace Plib {
-	MapServer::MapServer( const RealmDescriptor& descriptor ) :
-	  _descriptor( descriptor )
+	MapServer::MapServer( const RealmDescriptor& descriptor, bool mapped ) :
+	  _descriptor( descriptor ),
+	  _index1(),
+	  _index2( NULL ),
+	  _index2_count( 0 ),
+	  _shapedata( NULL ),
+	  _shapedata_count( 0 ),
+	  _mapped( mapped ),
+	  _index2_buf(),
+	  _shapedata_buf(),
+	  _solidx1_file(),
+	  _solidx2_file(),
+	  _solids_file()
 	{
 	  LoadSolids();
 
@@ -42,39 +54,72 @@ namespace Pol {
 	{
 	  std::string filename = _descriptor.path( "solids.dat" );
 
-      Clib::BinaryFile infile(filename, std::ios::in);
-	  infile.ReadVector( _shapedata );
+	  if ( _mapped )
+	  {
+		_solids_file.Open( filename );
+		_shapedata = reinterpret_cast<const SOLIDS_ELEM*>( _solids_file.data() );
+		_shapedata_count = _solids_file.size() / sizeof( SOLIDS_ELEM );
+	  }
+	  else
+	  {
+		Clib::BinaryFile infile( filename, std::ios::in );
+		infile.ReadVector( _shapedata_buf );
+		_shapedata = _shapedata_buf.empty() ? NULL : &_shapedata_buf[0];
+		_shapedata_count = _shapedata_buf.size();
+	  }
 	}
 
 	void MapServer::LoadSecondLevelIndex()
 	{
       std::string filename = _descriptor.path("solidx2.dat");
 
-      Clib::BinaryFile infile(filename, std::ios::in);
-      std::fstream::pos_type filesize = infile.FileSize();
-      if (filesize < std::fstream::pos_type(SOLIDX2_FILLER_SIZE))
-          throw std::runtime_error(filename + " must have size of at least " + Clib::decint(SOLIDX2_FILLER_SIZE) + " bytes.");
+	  size_t filesize;
+	  if ( _mapped )
+	  {
+		_solidx2_file.Open( filename );
+		filesize = _solidx2_file.size();
+	  }
+	  else
+	  {
+		Clib::BinaryFile infile( filename, std::ios::in );
+		filesize = static_cast<size_t>( infile.FileSize() );
+		if ( filesize >= SOLIDX2_FILLER_SIZE && ( filesize - SOLIDX2_FILLER_SIZE ) % sizeof( SOLIDX2_ELEM ) == 0 )
+		{
+		  _index2_buf.resize( ( filesize - SOLIDX2_FILLER_SIZE ) / sizeof( SOLIDX2_ELEM ) );
+		  infile.Seek( SOLIDX2_FILLER_SIZE );
+		  if ( !_index2_buf.empty() )
+			infile.Read( &_index2_buf[0], _index2_buf.size() );
+		}
+	  }
+	  if ( filesize < SOLIDX2_FILLER_SIZE )
+		throw std::runtime_error( filename + " must have size of at least " + Clib::decint( SOLIDX2_FILLER_SIZE ) + " bytes." );
 
-      std::fstream::pos_type databytes = filesize - std::fstream::pos_type(SOLIDX2_FILLER_SIZE);
+	  size_t databytes = filesize - SOLIDX2_FILLER_SIZE;
 	  if ( ( databytes % sizeof( SOLIDX2_ELEM ) ) != 0 )
-          throw std::runtime_error(filename + " does not contain an integral number of elements.");
+		throw std::runtime_error( filename + " does not contain an integral number of elements." );
+
+	  _index2_count = databytes / sizeof( SOLIDX2_ELEM );
+	  if ( _mapped )
+		_index2 = reinterpret_cast<const SOLIDX2_ELEM*>( _solidx2_file.data() + SOLIDX2_FILLER_SIZE );
+	  else
+		_index2 = _index2_buf.empty() ? NULL : &_index2_buf[0];
 
-	  size_t count = static_cast<size_t>( databytes / sizeof( SOLIDX2_ELEM ) );
-	  _index2.resize( count );
-	  infile.Seek( SOLIDX2_FILLER_SIZE );
-	  infile.Read( &_index2[0], count );
+	  // a mapped index is checked in GetMapShapes instead, so startup doesn't touch every page
+	  if ( _mapped )
+		return;
 
 	  // integrity check
-	  for ( const auto &elem : _index2 )
+	  for ( size_t i = 0; i < _index2_count; ++i )
 	  {
-		passert( elem.baseindex < _shapedata.size() );
+		const SOLIDX2_ELEM& elem = _index2[i];
+		passert( elem.baseindex < _shapedata_count );
 
 		for ( unsigned x = 0; x < SOLIDX_X_SIZE; ++x )
 		{
 		  for ( unsigned y = 0; y < SOLIDX_Y_SIZE; ++y )
 		  {
 			size_t idx = elem.baseindex + elem.addindex[x][y];
-			passert( idx < _shapedata.size() );
+			passert( idx < _shapedata_count );
 		  }
 		}
 	  }
@@ -84,9 +129,18 @@ namespace Pol {
 	{
       std::string filename = _descriptor.path("solidx1.dat");
 
+	  size_t n_blocks = ( _descriptor.width / SOLIDX_X_SIZE ) * ( _descriptor.height / SOLIDX_Y_SIZE );
+	  if ( _mapped )
+	  {
+		// the file offsets are turned into second-level index entries in SecondLevelElem
+		_solidx1_file.Open( filename );
+		if ( _solidx1_file.size() < n_blocks * sizeof( unsigned int ) )
+		  throw std::runtime_error( filename + " is too small for the realm size." );
+		return;
+	  }
+
       Clib::BinaryFile infile(filename, std::ios::in);
 
-	  size_t n_blocks = ( _descriptor.width / SOLIDX_X_SIZE ) * ( _descriptor.height / SOLIDX_Y_SIZE );
 	  _index1.resize( n_blocks );
 
 	  for ( size_t i = 0; i < n_blocks; ++i )
@@ -97,7 +151,9 @@ namespace Pol {
 		{
 		  // tmp is an offset, in the file..  turn it into a pointer into the second-level index.
 		  tmp = ( tmp - SOLIDX2_FILLER_SIZE ) / sizeof( SOLIDX2_ELEM );
-		  _index1[i] = &_index2.at( tmp );
+		  if ( tmp >= _index2_count )
+			throw std::runtime_error( filename + " points beyond the end of solidx2.dat." );
+		  _index1[i] = &_index2[tmp];
 		}
 		else
 		{
@@ -106,6 +162,18 @@ namespace Pol {
 	  }
 	}
 
+	const SOLIDX2_ELEM* MapServer::SecondLevelElem( size_t block ) const
+	{
+	  if ( !_mapped )
+		return _index1[block];
+
+	  unsigned int offset = reinterpret_cast<const unsigned int*>( _solidx1_file.data() )[block];
+	  size_t index = ( offset - SOLIDX2_FILLER_SIZE ) / sizeof( SOLIDX2_ELEM );
+	  if ( offset < SOLIDX2_FILLER_SIZE || index >= _index2_count )
+		throw std::runtime_error( _descriptor.path( "solidx1.dat" ) + " points beyond the end of solidx2.dat." );
+	  return &_index2[index];
+	}
+
 	void MapServer::GetMapShapes( MapShapeList& shapes, unsigned short x, unsigned short y, unsigned int anyflags ) const
 	{
 	  passert( x < _descriptor.width && y < _descriptor.height );
@@ -129,8 +197,10 @@ namespace Pol {
 		unsigned short ycell = y &   SOLIDX_Y_CELLMASK;
 
 		size_t block = yblock * ( _descriptor.width >> SOLIDX_X_SHIFT ) + xblock;
-		SOLIDX2_ELEM* pIndex2 = _index1[block];
-		unsigned int index = pIndex2->baseindex + pIndex2->addindex[xcell][ycell];
+		const SOLIDX2_ELEM* pIndex2 = SecondLevelElem( block );
+		size_t index = static_cast<size_t>( pIndex2->baseindex ) + pIndex2->addindex[xcell][ycell];
+		if ( _mapped && index >= _shapedata_count )
+		  throw std::runtime_error( _descriptor.path( "solidx2.dat" ) + " points beyond the end of solids.dat." );
 		const SOLIDS_ELEM* pElem = &_shapedata[index];
 		for ( ;; )
 		{
@@ -151,17 +221,26 @@ namespace Pol {
 
 	MapServer* MapServer::Create( const RealmDescriptor& descriptor )
 	{
-	  if ( descriptor.mapserver_type == "memory" )
+	  return Create( descriptor, descriptor.mapserver_type );
+	}
+
+	MapServer* MapServer::Create( const RealmDescriptor& descriptor, const std::string& type )
+	{
+	  if ( type == "memory" )
 	  {
 		return new InMemoryMapServer( descriptor );
 	  }
-	  else if ( descriptor.mapserver_type == "file" )
+	  else if ( type == "file" )
 	  {
 		return new FileMapServer( descriptor );
 	  }
+	  else if ( type == "mapped" )
+	  {
+		return new MappedMapServer( descriptor );
+	  }
 	  else
 	  {
-          throw std::runtime_error("Undefined mapserver type: " + descriptor.mapserver_type);
+          throw std::runtime_error("Undefined mapserver type: " + type);
 	  }
 	}
 
@@ -170,8 +249,9 @@ namespace Pol {
       size_t size = sizeof( *this );
       size += _descriptor.sizeEstimate();
       size += 3 * sizeof(SOLIDX2_ELEM**)+_index1.capacity() * sizeof( SOLIDX2_ELEM* );
-      size += 3 * sizeof(SOLIDX2_ELEM*)+_index2.capacity() * sizeof( SOLIDX2_ELEM );
-      size += 3 * sizeof(SOLIDS_ELEM*)+_shapedata.capacity() * sizeof( SOLIDS_ELEM );
+      // mapped files are not counted, they live in the page cache
+      size += 3 * sizeof(SOLIDX2_ELEM*)+_index2_buf.capacity() * sizeof( SOLIDX2_ELEM );
+      size += 3 * sizeof(SOLIDS_ELEM*)+_shapedata_buf.capacity() * sizeof( SOLIDS_ELEM );
       return size;
     }
   }
@@ -13,6 +13,8 @@ Notes
 #include "mapsolid.h"
 #include "realmdescriptor.h"
 
+#include "../clib/mappedfile.h"
+
 #include <vector>
 
 namespace Pol {
@@ -24,27 +26,42 @@ namespace Pol {
 	{
 	public:
 	  static MapServer* Create( const RealmDescriptor& descriptor );
+	  // type is one of the mapserver types of realm.cfg: "memory", "file" or "mapped"
+	  static MapServer* Create( const RealmDescriptor& descriptor, const std::string& type );
 
 	  virtual ~MapServer();
 
 	  virtual MAPCELL GetMapCell( unsigned short x, unsigned short y ) const = 0;
 	  void GetMapShapes( MapShapeList& list, unsigned short x, unsigned short y, unsigned int anyflags ) const;
+	  // true if GetMapCell can be called from several threads at once
+	  virtual bool threadsafe() const { return true; }
       virtual size_t sizeEstimate( ) const;
 
 	protected:
-	  explicit MapServer( const RealmDescriptor& descriptor );
+	  // mapped: use the solids files through a file mapping instead of reading them
+	  explicit MapServer( const RealmDescriptor& descriptor, bool mapped = false );
 
 	  RealmDescriptor _descriptor;
 
 	private:
-	  // the indexes and shape data are always loaded into memory.
-	  std::vector< SOLIDX2_ELEM* > _index1; // points into _index2
-      std::vector< SOLIDX2_ELEM > _index2;
-      std::vector< SOLIDS_ELEM > _shapedata;
+	  // the indexes and shape data are always in memory, read or mapped.
+	  std::vector< const SOLIDX2_ELEM* > _index1; // points into _index2, empty when mapped
+	  const SOLIDX2_ELEM* _index2;
+	  size_t _index2_count;
+	  const SOLIDS_ELEM* _shapedata;
+	  size_t _shapedata_count;
+
+	  bool _mapped;
+	  std::vector< SOLIDX2_ELEM > _index2_buf;
+	  std::vector< SOLIDS_ELEM > _shapedata_buf;
+	  Clib::MappedFile _solidx1_file;
+	  Clib::MappedFile _solidx2_file;
+	  Clib::MappedFile _solids_file;
 
 	  void LoadSolids();
 	  void LoadSecondLevelIndex();
 	  void LoadFirstLevelIndex();
+	  const SOLIDX2_ELEM* SecondLevelElem( size_t block ) const;
 
 	  // not implemented:
 	  MapServer& operator=( const MapServer& );
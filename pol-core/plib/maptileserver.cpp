@@ -12,15 +12,47 @@ Notes
 #include "maptile.h"
 #include "realmdescriptor.h"
 
+#include <stdexcept>
+
 namespace Pol {
   namespace Plib {
 	MapTileServer::MapTileServer( const RealmDescriptor& descriptor ) :
 	  _descriptor( descriptor ),
-	  _file( _descriptor.path( "maptile.dat" ), std::ios::in ),
-	  _cur_block_index( -1L )
+	  _file(),
+	  _cur_block_index( -1L ),
+	  _mapped_file(),
+	  _blocks( NULL )
 	{
-	  _file.Read( _cur_block );
-	  _cur_block_index = 0;
+	  Open( descriptor.mapserver_type == "mapped" );
+	}
+
+	MapTileServer::MapTileServer( const RealmDescriptor& descriptor, bool mapped ) :
+	  _descriptor( descriptor ),
+	  _file(),
+	  _cur_block_index( -1L ),
+	  _mapped_file(),
+	  _blocks( NULL )
+	{
+	  Open( mapped );
+	}
+
+	void MapTileServer::Open( bool mapped )
+	{
+	  std::string filename = _descriptor.path( "maptile.dat" );
+	  if ( mapped )
+	  {
+		_mapped_file.Open( filename );
+		size_t n_blocks = ( _descriptor.width >> MAPTILE_SHIFT ) * ( _descriptor.height >> MAPTILE_SHIFT );
+		if ( _mapped_file.size() < n_blocks * sizeof( MAPTILE_BLOCK ) )
+		  throw std::runtime_error( filename + " is too small for the realm size." );
+		_blocks = reinterpret_cast<const MAPTILE_BLOCK*>( _mapped_file.data() );
+	  }
+	  else
+	  {
+		_file.Open( filename, std::ios::in );
+		_file.Read( _cur_block );
+		_cur_block_index = 0;
+	  }
 	}
 
 	MapTileServer::~MapTileServer()
@@ -34,6 +66,8 @@ namespace Pol {
 	  unsigned short ycell = y &   MAPTILE_CELLMASK;
 
 	  int block_index = yblock * ( _descriptor.width >> MAPTILE_SHIFT ) + xblock;
+	  if ( _blocks != NULL )
+		return _blocks[block_index].cell[xcell][ycell];
 	  if ( block_index != _cur_block_index )
 	  {
 		size_t offset = block_index * sizeof _cur_block;
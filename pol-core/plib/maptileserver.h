@@ -11,6 +11,7 @@ Notes
 #define PLIB_LANDTILESERVER_H
 
 #include "../clib/binaryfile.h"
+#include "../clib/mappedfile.h"
 
 #include "maptile.h"
 #include "realmdescriptor.h"
@@ -19,7 +20,10 @@ namespace Pol {
 	class MapTileServer
 	{
 	public:
+	  // mapped with the "mapped" mapserver type
 	  explicit MapTileServer( const RealmDescriptor& descriptor );
+	  // mapped: use maptile.dat through a file mapping instead of reading one block at a time
+	  MapTileServer( const RealmDescriptor& descriptor, bool mapped );
 	  ~MapTileServer();
 
 	  MAPTILE_CELL GetMapTile( unsigned short x, unsigned short y );
@@ -27,9 +31,14 @@ namespace Pol {
 	private:
 	  RealmDescriptor _descriptor;
 
+	  void Open( bool mapped );
+
 	  Clib::BinaryFile _file;
 	  int _cur_block_index;
 	  MAPTILE_BLOCK _cur_block;
+
+	  Clib::MappedFile _mapped_file;
+	  const MAPTILE_BLOCK* _blocks; // only if mapped
 	};
   }
 }
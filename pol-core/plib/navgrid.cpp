@@ -0,0 +1,307 @@
+/*
+History
+=======
+
+Notes
+=======
+
+*/
+
+#include "navgrid.h"
+
+#include "mapserver.h"
+#include "mapshape.h"
+#include "mapsolid.h"
+#include "realmdescriptor.h"
+
+#include "../clib/compileassert.h"
+#include "../clib/fileutil.h"
+#include "../clib/logfacility.h"
+#include "../clib/passert.h"
+#include "../clib/strutil.h"
+#include "../clib/timer.h"
+
+#include "../pol/uconst.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace Pol {
+  namespace Plib {
+	namespace
+	{
+	  const char NAVGRID_MAGIC[8] = { 'P', 'O', 'L', 'N', 'A', 'V', 'G', '\0' };
+	  const u32 NAVGRID_VERSION = 2;
+	  const unsigned TILES_PER_BLOCK = SOLIDX_X_SIZE * SOLIDX_Y_SIZE;
+
+	  // the realm files the grid is built from
+	  const char* const NAVGRID_SOURCES[] = { "base.dat", "solids.dat", "solidx1.dat", "solidx2.dat" };
+	  const unsigned NAVGRID_SOURCE_COUNT = 4;
+
+	  struct NAVGRID_SOURCE
+	  {
+		u32 size;
+		u32 timestamp;
+	  };
+
+	  struct NAVGRID_HEADER
+	  {
+		char magic[8];
+		u32 version;
+		u16 width;
+		u16 height;
+		u32 block_count;
+		u32 shape_count;
+		NAVGRID_SOURCE sources[NAVGRID_SOURCE_COUNT];
+	  };
+
+	  void read_sources( const RealmDescriptor& descriptor, NAVGRID_SOURCE* sources )
+	  {
+		for ( unsigned i = 0; i < NAVGRID_SOURCE_COUNT; ++i )
+		{
+		  std::string filename = descriptor.path( NAVGRID_SOURCES[i] );
+		  sources[i].size = static_cast<u32>( Clib::filesize( filename.c_str() ) );
+		  sources[i].timestamp = Clib::GetFileTimestamp( filename.c_str() );
+		}
+	  }
+
+	  unsigned blocks_per_row( unsigned short width )
+	  {
+		return ( width + SOLIDX_X_SIZE - 1 ) >> SOLIDX_X_SHIFT;
+	  }
+
+	  unsigned block_count( unsigned short width, unsigned short height )
+	  {
+		return blocks_per_row( width ) * ( ( height + SOLIDX_Y_SIZE - 1 ) >> SOLIDX_Y_SHIFT );
+	  }
+
+	  // the checks of Realm::standheight against the other shapes which don't depend on
+	  // the old z: a shape overlapping the standing space, and the lowest shape above.
+	  void set_clearance( NAVGRID_SHAPE* begin, NAVGRID_SHAPE* end )
+	  {
+		for ( NAVGRID_SHAPE* shape = begin; shape != end; ++shape )
+		{
+		  int top = shape->z + shape->height;
+		  int ceiling = NAVGRID_SHAPE::NO_CEILING;
+		  bool obstructed = false;
+		  for ( const NAVGRID_SHAPE* other = begin; other != end; ++other )
+		  {
+			if ( ( other->flags & ( FLAG::MOVELAND | FLAG::MOVESEA | FLAG::BLOCKING ) ) == 0 )
+			  continue;
+			if ( top < other->z && other->z < ceiling )
+			  ceiling = other->z;
+			if ( other->z < top + PLAYER_CHARACTER_HEIGHT && other->z + other->height > top )
+			  obstructed = true;
+		  }
+		  shape->ceiling = static_cast<s16>( ceiling );
+		  shape->obstructed = obstructed ? 1 : 0;
+		  shape->unused = 0;
+		}
+	  }
+	}
+	assertsize( NAVGRID_HEADER, 56 );
+
+	NavGrid::NavGrid( unsigned short width, unsigned short height ) :
+	  _width( width ),
+	  _height( height ),
+	  _blocks_per_row( blocks_per_row( width ) ),
+	  _file(),
+	  _block_base( NULL ),
+	  _tile_offset( NULL ),
+	  _shapes( NULL )
+	{}
+
+	NavGrid* NavGrid::Load( const RealmDescriptor& descriptor, const MapServer& mapserver )
+	{
+	  std::string filename = descriptor.path( "navgrid.dat" );
+	  try
+	  {
+		std::unique_ptr<NavGrid> grid( new NavGrid( descriptor.width, descriptor.height ) );
+		if ( !Clib::FileExists( filename ) || !grid->Open( filename, descriptor ) )
+		{
+		  POLLOG_INFO << "Building navigation grid " << filename << ": ";
+		  Tools::Timer<> timer;
+		  Create( descriptor, mapserver );
+		  POLLOG_INFO << "Completed in " << timer.ellapsed() << " ms.\n";
+		  if ( !grid->Open( filename, descriptor ) )
+			throw std::runtime_error( "file is invalid after rebuilding" );
+		}
+		return grid.release();
+	  }
+	  catch ( std::exception& ex )
+	  {
+		ERROR_PRINT << "Unable to use navigation grid " << filename << ": " << ex.what() << "\n";
+		return NULL;
+	  }
+	}
+
+	void NavGrid::Create( const RealmDescriptor& descriptor, const MapServer& mapserver )
+	{
+	  unsigned per_row = blocks_per_row( descriptor.width );
+	  unsigned blocks = block_count( descriptor.width, descriptor.height );
+
+	  std::vector<u32> block_base;
+	  std::vector<u16> tile_offset( blocks * TILES_PER_BLOCK, 0 );
+	  std::vector<NAVGRID_SHAPE> shapes;
+	  block_base.reserve( blocks + 1 );
+	  MapShapeList list;
+
+	  for ( unsigned block = 0; block < blocks; ++block )
+	  {
+		unsigned x_base = ( block % per_row ) << SOLIDX_X_SHIFT;
+		unsigned y_base = ( block / per_row ) << SOLIDX_Y_SHIFT;
+		size_t base = shapes.size();
+		block_base.push_back( static_cast<u32>( base ) );
+		for ( unsigned xcell = 0; xcell < SOLIDX_X_SIZE; ++xcell )
+		{
+		  for ( unsigned ycell = 0; ycell < SOLIDX_Y_SIZE; ++ycell )
+		  {
+			if ( shapes.size() - base > 0xFFFF )
+			  throw std::runtime_error( "too many shapes in the block at " + Clib::decint( x_base ) + "," + Clib::decint( y_base ) );
+			tile_offset[block * TILES_PER_BLOCK + ( xcell << SOLIDX_Y_SHIFT ) + ycell] = static_cast<u16>( shapes.size() - base );
+
+			unsigned x = x_base + xcell;
+			unsigned y = y_base + ycell;
+			if ( x >= descriptor.width || y >= descriptor.height )
+			  continue;
+			list.clear();
+			mapserver.GetMapShapes( list, static_cast<unsigned short>( x ), static_cast<unsigned short>( y ), SHAPE_FLAGS );
+			size_t first = shapes.size();
+			for ( const auto& shape : list )
+			{
+			  NAVGRID_SHAPE navshape;
+			  navshape.z = shape.z;
+			  navshape.height = static_cast<u8>( shape.height );
+			  navshape.flags = static_cast<u8>( shape.flags );
+			  shapes.push_back( navshape );
+			}
+			if ( first != shapes.size() )
+			  set_clearance( &shapes[first], &shapes[0] + shapes.size() );
+		  }
+		}
+	  }
+	  block_base.push_back( static_cast<u32>( shapes.size() ) );
+
+	  NAVGRID_HEADER header;
+	  memset( &header, 0, sizeof header );
+	  memcpy( header.magic, NAVGRID_MAGIC, sizeof header.magic );
+	  header.version = NAVGRID_VERSION;
+	  header.width = descriptor.width;
+	  header.height = descriptor.height;
+	  header.block_count = blocks;
+	  header.shape_count = static_cast<u32>( shapes.size() );
+	  read_sources( descriptor, header.sources );
+
+	  // written under a temporary name, a running server may have the old file mapped
+	  std::string filename = descriptor.path( "navgrid.dat" );
+	  std::string tmpname = filename + ".tmp";
+	  {
+		std::ofstream ofs;
+		ofs.exceptions( std::ios_base::failbit | std::ios_base::badbit );
+		ofs.open( tmpname.c_str(), std::ios::out | std::ios::binary | std::ios::trunc );
+		ofs.write( reinterpret_cast<const char*>( &header ), sizeof header );
+		ofs.write( reinterpret_cast<const char*>( &block_base[0] ), block_base.size() * sizeof( u32 ) );
+		if ( !tile_offset.empty() )
+		  ofs.write( reinterpret_cast<const char*>( &tile_offset[0] ), tile_offset.size() * sizeof( u16 ) );
+		if ( !shapes.empty() )
+		  ofs.write( reinterpret_cast<const char*>( &shapes[0] ), shapes.size() * sizeof( NAVGRID_SHAPE ) );
+	  }
+	  Clib::RemoveFile( filename );
+	  if ( rename( tmpname.c_str(), filename.c_str() ) != 0 )
+		throw std::runtime_error( "Unable to rename " + tmpname + " to " + filename );
+	}
+
+	bool NavGrid::Open( const std::string& filename, const RealmDescriptor& descriptor )
+	{
+	  _file.Open( filename );
+	  if ( _file.size() < sizeof( NAVGRID_HEADER ) )
+	  {
+		_file.Close();
+		return false;
+	  }
+	  const NAVGRID_HEADER* header = reinterpret_cast<const NAVGRID_HEADER*>( _file.data() );
+	  NAVGRID_SOURCE sources[NAVGRID_SOURCE_COUNT];
+	  read_sources( descriptor, sources );
+
+	  size_t blocks = block_count( _width, _height );
+	  size_t expected_size = sizeof( NAVGRID_HEADER )
+		+ ( blocks + 1 ) * sizeof( u32 )
+		+ blocks * TILES_PER_BLOCK * sizeof( u16 )
+		+ static_cast<size_t>( header->shape_count ) * sizeof( NAVGRID_SHAPE );
+	  if ( memcmp( header->magic, NAVGRID_MAGIC, sizeof header->magic ) != 0 ||
+		   header->version != NAVGRID_VERSION ||
+		   header->width != _width || header->height != _height ||
+		   header->block_count != blocks ||
+		   memcmp( header->sources, sources, sizeof sources ) != 0 ||
+		   _file.size() != expected_size )
+	  {
+		_file.Close();
+		return false;
+	  }
+
+	  _block_base = reinterpret_cast<const u32*>( _file.data() + sizeof( NAVGRID_HEADER ) );
+	  _tile_offset = reinterpret_cast<const u16*>( _block_base + blocks + 1 );
+	  _shapes = reinterpret_cast<const NAVGRID_SHAPE*>( _tile_offset + blocks * TILES_PER_BLOCK );
+	  if ( _block_base[blocks] != header->shape_count )
+	  {
+		_file.Close();
+		return false;
+	  }
+	  return true;
+	}
+
+	const NAVGRID_SHAPE* NavGrid::tile_shapes( unsigned short x, unsigned short y, const NAVGRID_SHAPE** end ) const
+	{
+	  passert( x < _width && y < _height );
+
+	  unsigned block = ( y >> SOLIDX_Y_SHIFT ) * _blocks_per_row + ( x >> SOLIDX_X_SHIFT );
+	  unsigned tile = ( ( x & SOLIDX_X_CELLMASK ) << SOLIDX_Y_SHIFT ) | ( y & SOLIDX_Y_CELLMASK );
+	  const u16* offsets = _tile_offset + block * TILES_PER_BLOCK;
+	  const NAVGRID_SHAPE* block_shapes = _shapes + _block_base[block];
+
+	  *end = ( tile + 1 < TILES_PER_BLOCK ) ? block_shapes + offsets[tile + 1] : _shapes + _block_base[block + 1];
+	  return block_shapes + offsets[tile];
+	}
+
+	void NavGrid::GetMapShapes( MapShapeList& shapes, unsigned short x, unsigned short y, unsigned int anyflags ) const
+	{
+	  const NAVGRID_SHAPE* end;
+	  MapShape shape;
+	  for ( const NAVGRID_SHAPE* itr = tile_shapes( x, y, &end ); itr != end; ++itr )
+	  {
+		if ( itr->flags & anyflags )
+		{
+		  shape.z = itr->z;
+		  shape.height = itr->height;
+		  shape.flags = itr->flags;
+		  shapes.push_back( shape );
+		}
+	  }
+	}
+
+	const NAVGRID_SHAPE* NavGrid::GetTileShapes( MapShapeList& shapes, unsigned short x, unsigned short y ) const
+	{
+	  const NAVGRID_SHAPE* end;
+	  const NAVGRID_SHAPE* begin = tile_shapes( x, y, &end );
+	  MapShape shape;
+	  for ( const NAVGRID_SHAPE* itr = begin; itr != end; ++itr )
+	  {
+		shape.z = itr->z;
+		shape.height = itr->height;
+		shape.flags = itr->flags;
+		shapes.push_back( shape );
+	  }
+	  return begin;
+	}
+
+	size_t NavGrid::sizeEstimate() const
+	{
+	  // the grid itself is mapped, not allocated
+	  return sizeof( *this );
+	}
+  }
+}
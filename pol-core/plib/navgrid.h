@@ -0,0 +1,97 @@
+/*
+History
+=======
+
+Notes
+=======
+Navigation grid of a realm: the map and static shapes which matter for walking
+(MOVELAND, MOVESEA, BLOCKING, GRADUAL, OVERFLIGHT), stored per tile in the order
+MapServer::GetMapShapes returns them. Each shape also carries the clearance of
+its top against the other shapes of the tile, which is what Realm::standheight
+otherwise works out by comparing every walkable surface with every other shape.
+It is built from base.dat and the solids files and kept in navgrid.dat, which is
+memory mapped and rebuilt once these files change (uoconvert map). Items and
+multis are added at query time as before, only they still have to be compared.
+
+Layout of navgrid.dat:
+  NAVGRID_HEADER
+  u32 block_base[block_count + 1]           first shape of each 16x16 block
+  u16 tile_offset[block_count][16][16]      first shape of a tile, relative to its block
+  NAVGRID_SHAPE shapes[shape_count]
+*/
+
+#ifndef PLIB_NAVGRID_H
+#define PLIB_NAVGRID_H
+
+#include "mapcell.h"
+
+#include "../clib/compileassert.h"
+#include "../clib/mappedfile.h"
+#include "../clib/rawtypes.h"
+
+#include <boost/noncopyable.hpp>
+
+#include <string>
+
+namespace Pol {
+  namespace Plib {
+	class MapServer;
+	class MapShapeList;
+	class RealmDescriptor;
+
+	// a map shape can start at z -129 (map cell z -128), so z doesn't fit into SOLIDS_ELEM
+	struct NAVGRID_SHAPE
+	{
+	  s16 z;
+	  u8 height;
+	  u8 flags;
+	  // standing on top of the shape, against the blocking (MOVELAND, MOVESEA, BLOCKING)
+	  // map and static shapes of the tile:
+	  s16 ceiling;    // lowest z of a blocking shape starting above the top, NO_CEILING if none
+	  u8 obstructed;  // a blocking shape reaches into the PLAYER_CHARACTER_HEIGHT above the top
+	  u8 unused;
+
+	  enum { NO_CEILING = 0x7FFF };
+	};
+	assertsize( NAVGRID_SHAPE, 8 );
+
+	class NavGrid : boost::noncopyable
+	{
+	public:
+	  enum
+	  {
+		// a query with other flags has to ask the MapServer
+		SHAPE_FLAGS = FLAG::MOVE_FLAGS | FLAG::OVERFLIGHT
+	  };
+
+	  // maps navgrid.dat of the realm, building it first if it is missing or outdated.
+	  // returns NULL (after logging) if that fails.
+	  static NavGrid* Load( const RealmDescriptor& descriptor, const MapServer& mapserver );
+	  // (re)writes navgrid.dat of the realm, throws on error
+	  static void Create( const RealmDescriptor& descriptor, const MapServer& mapserver );
+
+	  // same result as MapServer::GetMapShapes for anyflags within SHAPE_FLAGS.
+	  // only reads the mapped file, so it can be used from any thread.
+	  void GetMapShapes( MapShapeList& shapes, unsigned short x, unsigned short y, unsigned int anyflags ) const;
+	  // appends all shapes of the tile to shapes, unfiltered, and returns their records:
+	  // shapes[n + i] belongs to the returned [i] for n the size of shapes before the call.
+	  const NAVGRID_SHAPE* GetTileShapes( MapShapeList& shapes, unsigned short x, unsigned short y ) const;
+
+	  size_t sizeEstimate() const;
+	private:
+	  NavGrid( unsigned short width, unsigned short height );
+	  bool Open( const std::string& filename, const RealmDescriptor& descriptor );
+
+	  unsigned short _width;
+	  unsigned short _height;
+	  unsigned _blocks_per_row;
+	  const NAVGRID_SHAPE* tile_shapes( unsigned short x, unsigned short y, const NAVGRID_SHAPE** end ) const;
+
+	  Clib::MappedFile _file;
+	  const u32* _block_base;
+	  const u16* _tile_offset;
+	  const NAVGRID_SHAPE* _shapes;
+	};
+  }
+}
+#endif
@@ -17,6 +17,7 @@ Notes
 #include "mapserver.h"
 #include "staticserver.h"
 #include "maptileserver.h"
+#include "navgrid.h"
 
 #include "../pol/uworld.h"
 #include "../pol/mobile/charactr.h"
@@ -34,10 +35,14 @@ namespace Pol {
 	  _offline_count( 0 ),
 	  _toplevel_item_count( 0 ),
 	  _multi_count( 0 ),
+	  _pathfind_count( 0 ),
 	  _mapserver( MapServer::Create( _descriptor ) ),
 	  _staticserver( new StaticServer( _descriptor ) ),
-	  _maptileserver( new MapTileServer( _descriptor ) )
+	  _maptileserver( new MapTileServer( _descriptor ) ),
+	  _navgrid()
 	{
+	  if ( _descriptor.navgrid )
+		_navgrid.reset( NavGrid::Load( _descriptor, *_mapserver ) );
 
 	  size_t gridwidth = width( ) / Core::WGRID_SIZE;
 	  size_t gridheight = height( ) / Core::WGRID_SIZE;
@@ -63,7 +68,8 @@ namespace Pol {
 	  _mobile_count( 0 ),
       _offline_count( 0 ),
 	  _toplevel_item_count( 0 ),
-      _multi_count( 0 )
+      _multi_count( 0 ),
+	  _pathfind_count( 0 )
 	{
 	  size_t gridwidth = width( ) / Core::WGRID_SIZE;
 	  size_t gridheight = height( ) / Core::WGRID_SIZE;
@@ -114,6 +120,9 @@ namespace Pol {
           size += 3 * sizeof(void**)+zone[x][y].npcs.capacity() * sizeof( void* );
           size += 3 * sizeof(void**)+zone[x][y].items.capacity() * sizeof( void* );
           size += 3 * sizeof(void**)+zone[x][y].multis.capacity() * sizeof( void* );
+          size += 3 * sizeof(void**)+zone[x][y].tile_items.bucket_count() * sizeof( void* );
+          for ( const auto& tile : zone[x][y].tile_items )
+            size += 5 * sizeof(void*)+tile.second.capacity() * sizeof( void* );
         }
       }
 
@@ -122,7 +131,8 @@ namespace Pol {
       size += _descriptor.sizeEstimate()
         + ((!_mapserver) ? 0 : _mapserver->sizeEstimate())
         + ((!_staticserver) ? 0 : _staticserver->sizeEstimate())
-        + ((!_maptileserver) ? 0 : _maptileserver->sizeEstimate());
+        + ((!_maptileserver) ? 0 : _maptileserver->sizeEstimate())
+        + ((!_navgrid) ? 0 : _navgrid->sizeEstimate());
       return size;
     }
 
@@ -47,8 +47,11 @@ namespace Pol {
   namespace Plib {
 	class MapServer;
 	class MapShapeList;
+	struct MapShape;
 	struct MAPTILE_CELL;
 	class MapTileServer;
+	class NavGrid;
+	struct NAVGRID_SHAPE;
 	class StaticServer;
 	
 
@@ -87,6 +90,12 @@ namespace Pol {
       unsigned int toplevel_item_count();
       unsigned int multi_count();
 
+      // FindPath searches of a pathfinding thread which use the realm,
+      // it can't be deleted until they are done
+      void add_pathfind();
+      void remove_pathfind();
+      unsigned int pathfind_count();
+
 	  bool walkheight( unsigned short x, unsigned short y, short oldz,
 					   short* newz,
 					   Multi::UMulti** pmulti, Items::Item** pwalkon,
@@ -98,6 +107,15 @@ namespace Pol {
 					   Multi::UMulti** pmulti, Items::Item** pwalkon,
 					   short* gradual_boost = NULL );
 
+	  // walkheight over the map and statics plus the given shapes of dynamic objects
+	  // (items, multis) on that tile, for a walking mobile. Doesn't look at the world,
+	  // so it can be called without the world lock if has_threadsafe_mapserver()
+	  // (which is always the case with a navgrid).
+	  // shapes and possible_shapes are used as scratch space.
+	  bool walkheight( MapShapeList& shapes, std::vector<const MapShape*>& possible_shapes,
+					   unsigned short x, unsigned short y, short oldz, short* newz ) const;
+	  bool has_threadsafe_mapserver() const;
+
 	  bool lowest_walkheight( unsigned short x, unsigned short y, short oldz,
 							  short* newz,
 							  Multi::UMulti** pmulti, Items::Item** pwalkon,
@@ -145,6 +163,34 @@ namespace Pol {
 							   short oldz, bool* result,
 							   short* newz,
 							   short* gradual_boost = NULL );
+	  static void standheight( Core::MOVEMODE movemode,
+							   MapShapeList& shapes,
+							   short oldz, bool* result,
+							   short* newz,
+							   short* gradual_boost,
+							   std::vector<const MapShape*>& possible_shapes );
+	  // shapes[navgrid_begin..] are navgrid shapes, navshapes their records. Their precomputed
+	  // clearance replaces comparing them with the other navgrid shapes, and the ones without
+	  // anyflags are skipped (anyflags has to contain MOVELAND, MOVESEA and BLOCKING).
+	  static void standheight( Core::MOVEMODE movemode,
+							   MapShapeList& shapes,
+							   size_t navgrid_begin,
+							   const NAVGRID_SHAPE* navshapes,
+							   unsigned int anyflags,
+							   short oldz, bool* result,
+							   short* newz,
+							   short* gradual_boost,
+							   std::vector<const MapShape*>& possible_shapes );
+	  // standheight over the shapes of dynamic objects already in shapes plus the
+	  // map and static shapes of x,y with anyflags, from the navgrid if there is one
+	  void walk_standheight( Core::MOVEMODE movemode,
+							 MapShapeList& shapes,
+							 unsigned short x, unsigned short y,
+							 unsigned int anyflags,
+							 short oldz, bool* result,
+							 short* newz,
+							 short* gradual_boost,
+							 std::vector<const MapShape*>& possible_shapes ) const;
 
 	  static void lowest_standheight( Core::MOVEMODE movemode,
 									  MapShapeList& shapes,
@@ -178,11 +224,13 @@ namespace Pol {
       unsigned int _offline_count;
       unsigned int _toplevel_item_count;
       unsigned int _multi_count;
+      unsigned int _pathfind_count;
 
 	public:
 	  std::unique_ptr<MapServer> _mapserver;
 	  std::unique_ptr<StaticServer> _staticserver;
 	  std::unique_ptr<MapTileServer> _maptileserver;
+	  std::unique_ptr<NavGrid> _navgrid; // only with "navgrid 1" in realm.cfg
 	private:
 	  // not implemented:
 	  Realm& operator=( const Realm& );
@@ -226,6 +274,16 @@ namespace Pol {
         --_multi_count;
     }
 
+    inline void Realm::add_pathfind() {
+        ++_pathfind_count;
+    }
+    inline void Realm::remove_pathfind() {
+        --_pathfind_count;
+    }
+    inline unsigned int Realm::pathfind_count() {
+        return _pathfind_count;
+    }
+
   }
 }
 #endif
@@ -41,7 +41,8 @@ namespace Pol {
 	  num_map_patches( elem.remove_unsigned( "num_map_patches", 0 ) ),
 	  num_static_patches( elem.remove_unsigned( "num_static_patches", 0 ) ),
 	  season( elem.remove_unsigned( "season", 1 ) ),
-	  mapserver_type( Clib::strlower( elem.remove_string( "mapserver", "memory" ) ) )
+	  mapserver_type( Clib::strlower( elem.remove_string( "mapserver", "memory" ) ) ),
+	  navgrid( elem.remove_bool( "navgrid", false ) )
 	{}
 	RealmDescriptor::RealmDescriptor() :
 	  name( "" ),
@@ -53,7 +54,8 @@ namespace Pol {
 	  num_map_patches( 0 ),
 	  num_static_patches( 0 ),
 	  season( 0 ),
-	  mapserver_type( "" )
+	  mapserver_type( "" ),
+	  navgrid( false )
 	{}
 
     size_t RealmDescriptor::sizeEstimate() const
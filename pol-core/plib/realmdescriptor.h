@@ -35,7 +35,8 @@ namespace Pol {
 	  const unsigned num_map_patches;
 	  const unsigned num_static_patches;
 	  const unsigned season;
-	  const std::string mapserver_type;    // "memory" or "file"
+	  const std::string mapserver_type;    // "memory", "file" or "mapped"
+	  const bool navgrid;             // walk over navgrid.dat instead of the mapserver
 
 	  std::string path( const std::string& filename ) const;
 	  bool operator==( const RealmDescriptor& rdesc ) const
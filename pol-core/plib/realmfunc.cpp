@@ -24,6 +24,7 @@ In standingheight checks there is a nasty bug. Items NOT locked down
 #include "systemstate.h"
 #include "mapshape.h"
 #include "maptileserver.h"
+#include "navgrid.h"
 
 #include "../pol/tiles.h"
 #include "../pol/mobile/charactr.h"
@@ -73,6 +74,27 @@ namespace Pol {
 							 bool* result_out, short * newz_out, short* gradual_boost )
 	{
 	  static std::vector<const MapShape*> possible_shapes;
+	  standheight( movemode, shapes, oldz, result_out, newz_out, gradual_boost, possible_shapes );
+	}
+
+	void Realm::standheight( Core::MOVEMODE movemode,
+							 MapShapeList& shapes,
+							 short oldz,
+							 bool* result_out, short * newz_out, short* gradual_boost,
+							 std::vector<const MapShape*>& possible_shapes )
+	{
+	  standheight( movemode, shapes, shapes.size(), NULL, 0, oldz, result_out, newz_out, gradual_boost, possible_shapes );
+	}
+
+	void Realm::standheight( Core::MOVEMODE movemode,
+							 MapShapeList& shapes,
+							 size_t navgrid_begin,
+							 const NAVGRID_SHAPE* navshapes,
+							 unsigned int anyflags,
+							 short oldz,
+							 bool* result_out, short * newz_out, short* gradual_boost,
+							 std::vector<const MapShape*>& possible_shapes )
+	{
 	  possible_shapes.clear();
 	  bool land_ok = ( movemode & Core::MOVEMODE_LAND ) ? true : false;
 	  bool sea_ok = ( movemode & Core::MOVEMODE_SEA ) ? true : false;
@@ -88,9 +110,12 @@ namespace Pol {
 	  short newz = -200;
 
 	  // first check only possible walkon shapes and build a list
-	  for ( const auto &shape : shapes )
+	  for ( size_t i = 0; i < shapes.size(); ++i )
 	  {
+		const MapShape& shape = shapes[i];
 		unsigned int flags = shape.flags;
+		if ( i >= navgrid_begin && ( flags & anyflags ) == 0 )
+		  continue;
 		short ztop = shape.z + shape.height;
 #if ENABLE_POLTEST_OUTPUT
 		if (static_debug_on)
@@ -133,8 +158,19 @@ namespace Pol {
 		{
 		  bool result = true;
 		  newz = pos_shape->z + pos_shape->height;
-		  for ( const auto &shape : shapes )
+		  // a navgrid shape only has to be compared with the dynamic ones
+		  size_t pos_index = pos_shape - &shapes[0];
+		  size_t check_end = shapes.size();
+		  if ( pos_index >= navgrid_begin )
 		  {
+			const NAVGRID_SHAPE& navshape = navshapes[pos_index - navgrid_begin];
+			if ( navshape.obstructed || navshape.ceiling <= oldz + 9 )
+			  continue;
+			check_end = navgrid_begin;
+		  }
+		  for ( size_t i = 0; i < check_end; ++i )
+		  {
+			const MapShape& shape = shapes[i];
 			if ( ( shape.flags & ( FLAG::MOVELAND | FLAG::MOVESEA | FLAG::BLOCKING ) ) == 0 )
 			  continue;
 			int shape_top = shape.z + shape.height;
@@ -297,8 +333,10 @@ namespace Pol {
 
 	void Realm::readdynamics( MapShapeList& vec, unsigned short x, unsigned short y, Core::ItemsVector& walkon_items, bool doors_block )
 	{
-	  Core::ZoneItems& witems = Core::getzone( x, y, this ).items;
-	  for ( const auto &item : witems )
+	  const Core::ZoneItems* titems = Core::get_tile_items( x, y, this );
+	  if ( titems == NULL )
+		return;
+	  for ( const auto &item : *titems )
 	  {
 		if ( ( item->x == x ) && ( item->y == y ) )
 		{
@@ -338,6 +376,7 @@ namespace Pol {
 	  }
 
 	  static MapShapeList shapes;
+	  static std::vector<const MapShape*> possible_shapes;
 	  static MultiList mvec;
 	  static Core::ItemsVector walkon_items;
 	  shapes.clear();
@@ -349,11 +388,10 @@ namespace Pol {
 	  if ( movemode & Core::MOVEMODE_FLY )
 		flags |= FLAG::OVERFLIGHT;
 	  readmultis( shapes, x, y, flags, mvec );
-	  getmapshapes( shapes, x, y, flags );
 
 	  bool result;
-	  standheight( movemode, shapes, oldz,
-				   &result, newz, gradual_boost );
+	  walk_standheight( movemode, shapes, x, y, flags, oldz,
+						&result, newz, gradual_boost, possible_shapes );
 
 	  if ( result && ( pwalkon != NULL ) )
 	  {
@@ -380,6 +418,39 @@ namespace Pol {
 	  return result;
 	}
 
+	bool Realm::walkheight( MapShapeList& shapes, std::vector<const MapShape*>& possible_shapes,
+							unsigned short x, unsigned short y, short oldz, short* newz ) const
+	{
+	  bool result;
+	  walk_standheight( Core::MOVEMODE_LAND, shapes, x, y, FLAG::MOVE_FLAGS, oldz, &result, newz, NULL, possible_shapes );
+	  return result;
+	}
+
+	void Realm::walk_standheight( Core::MOVEMODE movemode, MapShapeList& shapes,
+								  unsigned short x, unsigned short y, unsigned int anyflags,
+								  short oldz, bool* result, short* newz, short* gradual_boost,
+								  std::vector<const MapShape*>& possible_shapes ) const
+	{
+	  const Realm* base = is_shadowrealm ? baserealm : this;
+	  if ( base->_navgrid != nullptr && ( anyflags & ~NavGrid::SHAPE_FLAGS ) == 0 )
+	  {
+		size_t navgrid_begin = shapes.size();
+		const NAVGRID_SHAPE* navshapes = base->_navgrid->GetTileShapes( shapes, x, y );
+		standheight( movemode, shapes, navgrid_begin, navshapes, anyflags, oldz, result, newz, gradual_boost, possible_shapes );
+	  }
+	  else
+	  {
+		base->_mapserver->GetMapShapes( shapes, x, y, anyflags );
+		standheight( movemode, shapes, oldz, result, newz, gradual_boost, possible_shapes );
+	  }
+	}
+
+	bool Realm::has_threadsafe_mapserver() const
+	{
+	  const Realm* base = is_shadowrealm ? baserealm : this;
+	  return base->_navgrid != nullptr || base->_mapserver->threadsafe();
+	}
+
 	// new Z given new X, Y, and old Z.
 	//dave: todo: return false if walking onto a custom house and not in the list of editing players, and no cmdlevel
 	bool Realm::walkheight( const Mobile::Character* chr, unsigned short x, unsigned short y, short oldz,
@@ -393,6 +464,7 @@ namespace Pol {
 	  }
 
 	  static MapShapeList shapes;
+	  static std::vector<const MapShape*> possible_shapes;
 	  static MultiList mvec;
 	  static Core::ItemsVector walkon_items;
 	  shapes.clear();
@@ -404,11 +476,10 @@ namespace Pol {
 	  if ( chr->movemode & Core::MOVEMODE_FLY )
 		flags |= FLAG::OVERFLIGHT;
 	  readmultis( shapes, x, y, flags, mvec );
-	  getmapshapes( shapes, x, y, flags );
 
 	  bool result;
-	  standheight( chr->movemode, shapes, oldz,
-				   &result, newz, gradual_boost );
+	  walk_standheight( chr->movemode, shapes, x, y, flags, oldz,
+						&result, newz, gradual_boost, possible_shapes );
 
 	  if ( result && ( pwalkon != NULL ) )
 	  {
@@ -790,10 +861,11 @@ namespace Pol {
 
 	void Realm::getmapshapes( MapShapeList& shapes, unsigned short x, unsigned short y, unsigned int anyflags ) const
 	{
-	  if ( is_shadowrealm )
-		baserealm->_mapserver->GetMapShapes( shapes, x, y, anyflags );
+	  const Realm* base = is_shadowrealm ? baserealm : this;
+	  if ( base->_navgrid != nullptr && ( anyflags & ~NavGrid::SHAPE_FLAGS ) == 0 )
+		base->_navgrid->GetMapShapes( shapes, x, y, anyflags );
 	  else
-		_mapserver->GetMapShapes( shapes, x, y, anyflags );
+		base->_mapserver->GetMapShapes( shapes, x, y, anyflags );
 	}
   }
 }
@@ -59,11 +59,11 @@ namespace Pol {
     bool Realm::dynamic_item_blocks_los( const Core::LosObj& att, const Core::LosObj& target,
 										 unsigned short x, unsigned short y, short z ) const
 	{
-      unsigned short wx, wy;
-      Core::zone_convert_clip( x, y, this, &wx, &wy );
-      Core::ZoneItems& witems = zone[wx][wy].items;
+      const Core::ZoneItems* titems = Core::get_tile_items( x, y, this );
+	  if ( titems == NULL )
+		return false;
 
-	  for ( const auto &item : witems )
+	  for ( const auto &item : *titems )
 	  {
 		if ( ( item->x == x ) &&
 			 ( item->y == y ) )
@@ -25,26 +25,78 @@ namespace Pol {
   namespace Plib {
 	StaticServer::StaticServer( const RealmDescriptor& descriptor ) :
 	  _descriptor( descriptor ),
-	  _index(),
-	  _statics()
+	  _index( NULL ),
+	  _index_count( 0 ),
+	  _statics( NULL ),
+	  _statics_count( 0 ),
+	  _index_buf(),
+	  _statics_buf(),
+	  _index_file(),
+	  _statics_file(),
+	  _mapped( false )
 	{
+	  Load( descriptor.mapserver_type == "mapped" );
+	}
+
+	StaticServer::StaticServer( const RealmDescriptor& descriptor, bool mapped ) :
+	  _descriptor( descriptor ),
+	  _index( NULL ),
+	  _index_count( 0 ),
+	  _statics( NULL ),
+	  _statics_count( 0 ),
+	  _index_buf(),
+	  _statics_buf(),
+	  _index_file(),
+	  _statics_file(),
+	  _mapped( false )
+	{
+	  Load( mapped );
+	}
+
+	void StaticServer::Load( bool mapped )
+	{
+	  _mapped = mapped;
+	  if ( mapped )
+	  {
+		_index_file.Open( _descriptor.path( "statidx.dat" ) );
+		_index = reinterpret_cast<const STATIC_INDEX*>( _index_file.data() );
+		_index_count = _index_file.size() / sizeof( STATIC_INDEX );
+	  }
+	  else
+	  {
         Clib::BinaryFile index_file(_descriptor.path("statidx.dat"), std::ios::in);
-	  index_file.ReadVector( _index );
-	  if ( _index.empty() )
+		index_file.ReadVector( _index_buf );
+		_index = _index_buf.empty() ? NULL : &_index_buf[0];
+		_index_count = _index_buf.size();
+	  }
+	  if ( _index_count == 0 )
 	  {
 		std::string message = "Empty file: " + _descriptor.path( "statidx.dat" );
 		throw std::runtime_error( message );
 	  }
 
-      Clib::BinaryFile statics_file(_descriptor.path("statics.dat"), std::ios::in);
-	  statics_file.ReadVector( _statics );
-	  if ( _statics.empty() )
+	  if ( mapped )
+	  {
+		_statics_file.Open( _descriptor.path( "statics.dat" ) );
+		_statics = reinterpret_cast<const STATIC_ENTRY*>( _statics_file.data() );
+		_statics_count = _statics_file.size() / sizeof( STATIC_ENTRY );
+	  }
+	  else
+	  {
+        Clib::BinaryFile statics_file(_descriptor.path("statics.dat"), std::ios::in);
+		statics_file.ReadVector( _statics_buf );
+		_statics = _statics_buf.empty() ? NULL : &_statics_buf[0];
+		_statics_count = _statics_buf.size();
+	  }
+	  if ( _statics_count == 0 )
 	  {
         std::string message = "Empty file: " + _descriptor.path("statics.dat");
         throw std::runtime_error(message);
 	  }
 
-	  Validate();
+	  // mapped blocks are checked when they are used, so startup doesn't read the whole index
+	  if ( !mapped )
+		Validate();
 	}
 
 	StaticServer::~StaticServer()
@@ -70,14 +122,14 @@ namespace Pol {
 	  unsigned short y_block = y / STATICBLOCK_CHUNK;
 
 	  size_t block_index = y_block * ( _descriptor.width >> STATICBLOCK_SHIFT ) + x_block;
-	  if ( block_index + 1 >= _index.size() )
+	  if ( block_index + 1 >= _index_count )
 	  {
 		std::string message = "statics integrity error(1): x=" + Clib::tostring( x ) + ", y=" + Clib::tostring( y );
         throw std::runtime_error(message);
 	  }
 	  unsigned int first_entry_index = _index[block_index].index;
 	  unsigned int num = _index[block_index + 1].index - first_entry_index;
-	  if ( first_entry_index + num > _statics.size() )
+	  if ( first_entry_index + num > _statics_count )
 	  {
 		std::string message = "statics integrity error(2): x=" + Clib::tostring( x ) + ", y=" + Clib::tostring( y );
         throw std::runtime_error(message);
@@ -87,6 +139,8 @@ namespace Pol {
 	bool StaticServer::findstatic( unsigned short x, unsigned short y, unsigned short objtype ) const
 	{
 	  passert( x < _descriptor.width && y < _descriptor.height );
+	  if ( _mapped )
+		ValidateBlock( x, y );
 
 	  unsigned short x_block = x >> STATICBLOCK_SHIFT;
 	  unsigned short y_block = y >> STATICBLOCK_SHIFT;
@@ -114,6 +168,8 @@ namespace Pol {
 	void StaticServer::getstatics( StaticEntryList& statics, unsigned short x, unsigned short y ) const
 	{
 	  passert( x < _descriptor.width && y < _descriptor.height );
+	  if ( _mapped )
+		ValidateBlock( x, y );
 
 	  unsigned short x_block = x >> STATICBLOCK_SHIFT;
 	  unsigned short y_block = y >> STATICBLOCK_SHIFT;
@@ -140,8 +196,9 @@ namespace Pol {
     size_t StaticServer::sizeEstimate() const
     {
       size_t size = sizeof( *this ) + _descriptor.sizeEstimate();
-      size += 3 * sizeof(STATIC_INDEX*)+_index.capacity() * sizeof( STATIC_INDEX );
-      size += 3 * sizeof(STATIC_ENTRY*)+_statics.capacity( ) * sizeof( STATIC_ENTRY );
+      // mapped files are not counted, they live in the page cache
+      size += 3 * sizeof(STATIC_INDEX*)+_index_buf.capacity() * sizeof( STATIC_INDEX );
+      size += 3 * sizeof(STATIC_ENTRY*)+_statics_buf.capacity( ) * sizeof( STATIC_ENTRY );
       return size;
     }
   }
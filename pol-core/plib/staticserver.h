@@ -12,6 +12,9 @@ Notes
 #define PLIB_STATICSERVER_H
 
 #include "realmdescriptor.h"
+
+#include "../clib/mappedfile.h"
+
 #include <vector>
 
 namespace Pol {
@@ -24,7 +27,10 @@ namespace Pol {
 	class StaticServer
 	{
 	public:
+	  // mapped with the "mapped" mapserver type
 	  explicit StaticServer( const RealmDescriptor& descriptor );
+	  // mapped: use statidx.dat and statics.dat through a file mapping instead of reading them
+	  StaticServer( const RealmDescriptor& descriptor, bool mapped );
 	  ~StaticServer();
 	  StaticServer & operator=( const StaticServer & ) { return *this; }
 
@@ -32,14 +38,23 @@ namespace Pol {
 	  void getstatics( StaticEntryList& statics, unsigned short x, unsigned short y ) const;
       size_t sizeEstimate() const;
 	protected:
+	  void Load( bool mapped );
 	  void Validate() const;
 	  void ValidateBlock( unsigned short x, unsigned short y ) const;
 
 	private:
 	  RealmDescriptor _descriptor;
 
-	  std::vector<STATIC_INDEX> _index;
-      std::vector<STATIC_ENTRY> _statics;
+	  const STATIC_INDEX* _index;
+	  size_t _index_count;
+	  const STATIC_ENTRY* _statics;
+	  size_t _statics_count;
+
+	  std::vector<STATIC_INDEX> _index_buf;
+      std::vector<STATIC_ENTRY> _statics_buf;
+	  Clib::MappedFile _index_file;
+	  Clib::MappedFile _statics_file;
+	  bool _mapped;
 	};
   }
 }
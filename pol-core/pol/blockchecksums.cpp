@@ -0,0 +1,182 @@
+/*
+History
+=======
+2026/10/17 agent:     created
+
+Notes
+=======
+
+*/
+
+#include "blockchecksums.h"
+
+#include "clidata.h"
+#include "uofile.h"
+#include "ustruct.h"
+
+#include "../plib/systemstate.h"
+
+#include <cstdio>
+
+#ifdef _MSC_VER
+#pragma warning(disable:4996) // disable deprecation warning fopen
+#endif
+
+namespace Pol {
+  namespace Core {
+	namespace {
+	  const u32 CHECKSUM_FILE_MAGIC = 0x4b484342; // "BCHK"
+	  const u32 CHECKSUM_FILE_VERSION = 1;
+
+	  // FNV-1a
+	  const u32 FNV_BASIS = 2166136261u;
+	  inline void fnv( u32& hash, u32 value, unsigned bytes )
+	  {
+		for ( unsigned i = 0; i < bytes; ++i )
+		{
+		  hash ^= ( value >> ( i * 8 ) ) & 0xFF;
+		  hash *= 16777619u;
+		}
+	  }
+	}
+
+	BlockChecksums::BlockChecksums() :
+	  _width( 0 ),
+	  _height( 0 ),
+	  _settings( 0 ),
+	  _checksums()
+	{}
+
+	void BlockChecksums::calculate( unsigned short width, unsigned short height, bool map, bool statics, u32 settings )
+	{
+	  _width = width;
+	  _height = height;
+	  _settings = settings;
+	  _checksums.assign( x_blocks() * y_blocks(), 0 );
+
+	  std::vector<USTRUCT_STATIC> srecs;
+	  for ( unsigned x_block = 0; x_block < x_blocks(); ++x_block )
+	  {
+		for ( unsigned y_block = 0; y_block < y_blocks(); ++y_block )
+		{
+		  unsigned short x_base = static_cast<unsigned short>( x_block * BLOCK_SIZE );
+		  unsigned short y_base = static_cast<unsigned short>( y_block * BLOCK_SIZE );
+		  u32 hash = FNV_BASIS;
+		  if ( map )
+		  {
+			for ( unsigned short x = x_base; x < x_base + BLOCK_SIZE; ++x )
+			{
+			  for ( unsigned short y = y_base; y < y_base + BLOCK_SIZE; ++y )
+			  {
+				USTRUCT_MAPINFO mi;
+				rawmapinfo( x, y, &mi );
+				fnv( hash, mi.landtile, 2 );
+				fnv( hash, static_cast<u8>( mi.z ), 1 );
+			  }
+			}
+		  }
+		  if ( statics )
+		  {
+			int count;
+			readstaticblock( &srecs, &count, x_base, y_base );
+			fnv( hash, count, 4 );
+			for ( int i = 0; i < count; ++i )
+			{
+			  const USTRUCT_STATIC& srec = srecs[i];
+			  fnv( hash, srec.graphic, 2 );
+			  fnv( hash, static_cast<u8>( srec.x_offset ), 1 );
+			  fnv( hash, static_cast<u8>( srec.y_offset ), 1 );
+			  fnv( hash, static_cast<u8>( srec.z ), 1 );
+			  fnv( hash, srec.hue, 2 );
+			}
+		  }
+		  _checksums[x_block * y_blocks() + y_block] = hash;
+		}
+	  }
+	}
+
+	bool BlockChecksums::load( const std::string& filename, unsigned short width, unsigned short height, u32 settings )
+	{
+	  FILE* fp = fopen( filename.c_str(), "rb" );
+	  if ( fp == NULL )
+		return false;
+	  u32 header[4];
+	  bool ok = fread( header, sizeof header, 1, fp ) == 1 &&
+		header[0] == CHECKSUM_FILE_MAGIC &&
+		header[1] == CHECKSUM_FILE_VERSION &&
+		header[2] == ( static_cast<u32>( width ) << 16 | height ) &&
+		header[3] == settings;
+	  if ( ok )
+	  {
+		_width = width;
+		_height = height;
+		_settings = settings;
+		_checksums.resize( x_blocks() * y_blocks() );
+		ok = _checksums.empty() || fread( &_checksums[0], sizeof( u32 ) * _checksums.size(), 1, fp ) == 1;
+	  }
+	  fclose( fp );
+	  if ( !ok )
+		_checksums.clear();
+	  return ok;
+	}
+
+	bool BlockChecksums::save( const std::string& filename ) const
+	{
+	  FILE* fp = fopen( filename.c_str(), "wb" );
+	  if ( fp == NULL )
+		return false;
+	  u32 header[4] = { CHECKSUM_FILE_MAGIC, CHECKSUM_FILE_VERSION, static_cast<u32>( _width ) << 16 | _height, _settings };
+	  fwrite( header, sizeof header, 1, fp );
+	  if ( !_checksums.empty() )
+		fwrite( &_checksums[0], sizeof( u32 ) * _checksums.size(), 1, fp );
+	  bool ok = !ferror( fp );
+	  fclose( fp );
+	  return ok;
+	}
+
+	bool BlockChecksums::changed( const BlockChecksums& older, unsigned x_block, unsigned y_block ) const
+	{
+	  if ( older._checksums.size() != _checksums.size() || older._settings != _settings )
+		return true;
+	  unsigned index = x_block * y_blocks() + y_block;
+	  return _checksums[index] != older._checksums[index];
+	}
+
+	bool BlockChecksums::changed( const BlockChecksums& older, int x1, int y1, int x2, int y2 ) const
+	{
+	  if ( x1 < 0 )
+		x1 = 0;
+	  if ( y1 < 0 )
+		y1 = 0;
+	  if ( x2 >= _width )
+		x2 = _width - 1;
+	  if ( y2 >= _height )
+		y2 = _height - 1;
+	  for ( unsigned x_block = x1 / BLOCK_SIZE; x_block <= x2 / BLOCK_SIZE; ++x_block )
+	  {
+		for ( unsigned y_block = y1 / BLOCK_SIZE; y_block <= y2 / BLOCK_SIZE; ++y_block )
+		{
+		  if ( changed( older, x_block, y_block ) )
+			return true;
+		}
+	  }
+	  return false;
+	}
+
+	u32 BlockChecksums::settings_checksum( const std::vector<u32>& cfg_values )
+	{
+	  u32 hash = FNV_BASIS;
+	  for ( const auto& value : cfg_values )
+		fnv( hash, value, 4 );
+	  fnv( hash, Plib::systemstate.config.max_tile_id, 4 );
+	  for ( unsigned tile = 0; tile <= Plib::systemstate.config.max_tile_id; ++tile )
+	  {
+		fnv( hash, tile_uoflags( static_cast<unsigned short>( tile ) ), 4 );
+		fnv( hash, static_cast<u8>( tileheight( static_cast<unsigned short>( tile ) ) ), 1 );
+	  }
+	  for ( unsigned landtile = 0; landtile < LANDTILE_COUNT; ++landtile )
+		fnv( hash, landtile_uoflags( static_cast<unsigned short>( landtile ) ), 4 );
+	  return hash;
+	}
+  }
+}
@@ -0,0 +1,59 @@
+/*
+History
+=======
+2026/10/17 agent:     created, used by uoconvert for incremental map and statics conversion
+
+Notes
+=======
+Checksums of the uo source data (map*.mul, statics*.mul and their difs) per 8x8 block.
+uoconvert stores them beside the generated realm files, the next conversion only has to
+regenerate the blocks whose checksum changed.
+The settings checksum covers everything else the conversion depends on (tiledata and
+uoconvert.cfg flags), if it differs all blocks count as changed.
+
+*/
+
+#ifndef BLOCKCHECKSUMS_H
+#define BLOCKCHECKSUMS_H
+
+#include "../clib/rawtypes.h"
+
+#include <string>
+#include <vector>
+
+namespace Pol {
+  namespace Core {
+	class BlockChecksums
+	{
+	public:
+	  static const unsigned BLOCK_SIZE = 8;
+
+	  BlockChecksums();
+
+	  // checksums of the currently loaded uo data, needs rawmapfullread() / rawstaticfullread()
+	  void calculate( unsigned short width, unsigned short height, bool map, bool statics, u32 settings );
+
+	  // false if the file is missing or was written for a different map size or settings
+	  bool load( const std::string& filename, unsigned short width, unsigned short height, u32 settings );
+	  bool save( const std::string& filename ) const;
+
+	  // did the source block (in block coordinates) change compared to the older checksums
+	  bool changed( const BlockChecksums& older, unsigned x_block, unsigned y_block ) const;
+	  // same for all source blocks touching the area (in map coordinates, clipped to the map)
+	  bool changed( const BlockChecksums& older, int x1, int y1, int x2, int y2 ) const;
+
+	  // checksum of tiledata and the given uoconvert.cfg settings
+	  static u32 settings_checksum( const std::vector<u32>& cfg_values );
+
+	private:
+	  unsigned x_blocks() const { return _width / BLOCK_SIZE; }
+	  unsigned y_blocks() const { return _height / BLOCK_SIZE; }
+
+	  unsigned short _width;
+	  unsigned short _height;
+	  u32 _settings;
+	  std::vector<u32> _checksums; // x_block * y_blocks() + y_block, like the uo files
+	};
+  }
+}
+#endif
@@ -10,10 +10,37 @@ Notes
 #ifndef __DECAY_H
 #define __DECAY_H
 
+#include "gameclck.h"
+
+#include "../clib/rawtypes.h"
+
+#include <functional>
+
 namespace Pol {
+  namespace Items {
+	class Item;
+  }
   namespace Core {
+	// item on the ground which may decay once the gameclock passes decayat
+	struct DecayEntry
+	{
+	  DecayEntry( gameclock_t decayat, u32 serial ) : decayat( decayat ), serial( serial ) {}
+	  gameclock_t decayat;
+	  u32 serial;
+	};
+	// priority_queue keeps the largest element on top, so earlier decayat has to compare greater
+	class DecayComparer : public std::less<DecayEntry>
+	{
+	public:
+	  bool operator()( const DecayEntry& x, const DecayEntry& y ) const
+	  {
+		return x.decayat > y.decayat;
+	  }
+	};
+
+	void schedule_decay( Items::Item* item );
 	void decay_items();
-	void decay_single_zone();
+	void decay_thread( void* );
   }
 }
 #endif
@@ -0,0 +1,201 @@
+/*
+History
+=======
+2026/10/17 agent:     created, replaces the std::map<unsigned short, boost::any> of UObject
+
+Notes
+=======
+Storage for the members which are seldom set (mods, resistances, name suffix).
+Most objects have none of them, so an empty store is a single null pointer.
+Set members are kept sorted by id in small vectors of their own type, a value of 0
+(or an empty string) removes the member.
+
+*/
+
+#ifndef H_DYNPROPERTIES
+#define H_DYNPROPERTIES
+
+#include "../clib/rawtypes.h"
+
+#include <boost/noncopyable.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace Pol {
+  namespace Core {
+
+	class DynProps : boost::noncopyable
+	{
+	public:
+	  DynProps() : _members() {}
+
+	  // integral members, stored as s16
+	  template <typename T>
+	  T get( u16 id ) const
+	  {
+		static_assert( std::is_integral<T>::value && sizeof( T ) <= sizeof( s16 ), "DynProps only stores small integers and strings" );
+		return static_cast<T>( getInt( id ) );
+	  }
+	  template <typename T>
+	  void set( u16 id, T value )
+	  {
+		static_assert( std::is_integral<T>::value && sizeof( T ) <= sizeof( s16 ), "DynProps only stores small integers and strings" );
+		setInt( id, static_cast<s16>( value ) );
+	  }
+
+	  size_t size() const
+	  {
+		return _members ? _members->ints.size() + _members->strings.size() : 0;
+	  }
+	  size_t estimatedSize() const;
+
+	private:
+	  struct IntMember
+	  {
+		u16 id;
+		s16 value;
+	  };
+	  struct StringMember
+	  {
+		u16 id;
+		std::string value;
+	  };
+	  struct Members
+	  {
+		std::vector<IntMember> ints;
+		std::vector<StringMember> strings;
+	  };
+
+	  template <class V>
+	  static typename V::const_iterator find( const V& vec, u16 id )
+	  {
+		auto itr = std::lower_bound( vec.begin(), vec.end(), id,
+									 []( const typename V::value_type& m, u16 i ) { return m.id < i; } );
+		return ( itr != vec.end() && itr->id == id ) ? itr : vec.end();
+	  }
+	  template <class V>
+	  static typename V::iterator find_insert( V& vec, u16 id )
+	  {
+		return std::lower_bound( vec.begin(), vec.end(), id,
+								 []( const typename V::value_type& m, u16 i ) { return m.id < i; } );
+	  }
+
+	  s16 getInt( u16 id ) const;
+	  void setInt( u16 id, s16 value );
+	  std::string getString( u16 id ) const;
+	  void setString( u16 id, const std::string& value );
+	  void releaseIfEmpty();
+
+	  std::unique_ptr<Members> _members;
+	};
+
+	// std::string members
+	template <>
+	inline std::string DynProps::get<std::string>( u16 id ) const
+	{
+	  return getString( id );
+	}
+	template <>
+	inline void DynProps::set<std::string>( u16 id, std::string value )
+	{
+	  setString( id, value );
+	}
+
+	inline s16 DynProps::getInt( u16 id ) const
+	{
+	  if ( !_members )
+		return 0;
+	  auto itr = find( _members->ints, id );
+	  return itr != _members->ints.end() ? itr->value : 0;
+	}
+
+	inline void DynProps::setInt( u16 id, s16 value )
+	{
+	  if ( value == 0 )
+	  {
+		if ( !_members )
+		  return;
+		auto itr = find_insert( _members->ints, id );
+		if ( itr != _members->ints.end() && itr->id == id )
+		{
+		  _members->ints.erase( itr );
+		  releaseIfEmpty();
+		}
+		return;
+	  }
+	  if ( !_members )
+		_members.reset( new Members );
+	  auto itr = find_insert( _members->ints, id );
+	  if ( itr != _members->ints.end() && itr->id == id )
+		itr->value = value;
+	  else
+	  {
+		IntMember member;
+		member.id = id;
+		member.value = value;
+		_members->ints.insert( itr, member );
+	  }
+	}
+
+	inline std::string DynProps::getString( u16 id ) const
+	{
+	  if ( !_members )
+		return "";
+	  auto itr = find( _members->strings, id );
+	  return itr != _members->strings.end() ? itr->value : "";
+	}
+
+	inline void DynProps::setString( u16 id, const std::string& value )
+	{
+	  if ( value.empty() )
+	  {
+		if ( !_members )
+		  return;
+		auto itr = find_insert( _members->strings, id );
+		if ( itr != _members->strings.end() && itr->id == id )
+		{
+		  _members->strings.erase( itr );
+		  releaseIfEmpty();
+		}
+		return;
+	  }
+	  if ( !_members )
+		_members.reset( new Members );
+	  auto itr = find_insert( _members->strings, id );
+	  if ( itr != _members->strings.end() && itr->id == id )
+		itr->value = value;
+	  else
+	  {
+		StringMember member;
+		member.id = id;
+		member.value = value;
+		_members->strings.insert( itr, member );
+	  }
+	}
+
+	inline void DynProps::releaseIfEmpty()
+	{
+	  if ( _members->ints.empty() && _members->strings.empty() )
+		_members.reset();
+	}
+
+	inline size_t DynProps::estimatedSize() const
+	{
+	  size_t size = sizeof( DynProps );
+	  if ( _members )
+	  {
+		size += sizeof( Members )
+		  + _members->ints.capacity() * sizeof( IntMember )
+		  + _members->strings.capacity() * sizeof( StringMember );
+		for ( const auto& member : _members->strings )
+		  size += member.value.capacity();
+	  }
+	  return size;
+	}
+  }
+}
+#endif
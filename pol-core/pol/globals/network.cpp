@@ -18,6 +18,7 @@
 #include "../mobile/charactr.h"
 #include "../servdesc.h"
 #include "../sqlscrobj.h"
+#include "../tooltips.h"
 
 namespace Pol {
 namespace Core {
@@ -48,6 +49,7 @@ namespace Core {
 	ext_handler_table(),
 	packetsSingleton(new Network::PacketsSingleton()),
 	clientTransmit(new Network::ClientTransmit()),
+	tooltip_cache(new TooltipCache()),
   #ifdef PERGON
 	auxthreadpool(new threadhelp::DynTaskThreadPool("AuxPool")),  // TODO: seems to work activate by default? maybe add a cfg entry for max number of threads
 #endif
@@ -115,6 +117,7 @@ namespace Core {
     auxthreadpool.release();
 #endif
 	banned_ips.clear();
+	tooltip_cache->clear();
 #ifdef _WIN32
 	closesocket( polsocket.listen_socket );
 #else
@@ -28,6 +28,7 @@ namespace Pol {
   }
 namespace Core {
   class MessageTypeFilter;
+  class TooltipCache;
   class ServerDescription;
   class SQLService;
 
@@ -86,6 +87,7 @@ namespace Core {
 	  std::unique_ptr<Network::PacketsSingleton> packetsSingleton;
 
 	  std::unique_ptr<Network::ClientTransmit> clientTransmit;
+	  std::unique_ptr<TooltipCache> tooltip_cache;
 
 #ifdef PERGON
 	  std::unique_ptr<threadhelp::DynTaskThreadPool> auxthreadpool;
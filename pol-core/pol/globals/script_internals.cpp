@@ -1,14 +1,128 @@
 #include "script_internals.h"
 
 #include "../../clib/stlutil.h"
+#include "../../clib/threadhelp.h"
 
+#include "../pathfind.h"
 #include "../uoexec.h"
+#include "../module/osmod.h"
 
 namespace Pol {
 namespace Core {
   ScriptEngineInternalManager scriptEngineInternalManager;
 
+  HoldList::HoldList() :
+	_slots( WHEEL_SIZE + 1 ),
+	_cursor( 0 ),
+	_size( 0 )
+  {
+  }
+
+  HoldList::iterator::iterator( HoldList* wheel, size_t slot, Slot::iterator itr ) :
+	_wheel( wheel ),
+	_slot( slot ),
+	_itr( itr )
+  {
+  }
+
+  void HoldList::iterator::skip_empty()
+  {
+	while ( _slot <= WHEEL_SIZE && _itr == _wheel->_slots[_slot].end() )
+	{
+	  if ( ++_slot <= WHEEL_SIZE )
+		_itr = _wheel->_slots[_slot].begin();
+	}
+  }
+
+  HoldList::iterator& HoldList::iterator::operator++( )
+  {
+	++_itr;
+	skip_empty();
+	return *this;
+  }
+
+  HoldList::iterator HoldList::insert( const value_type& value )
+  {
+	if ( _size == 0 )
+	  _cursor = polclock();
+	// the clock was already handled by front_due(), so it has to wake up at the next call
+	size_t slot = ( value.first - _cursor < 0 ) ? static_cast<size_t>( WHEEL_SIZE ) : slot_of( value.first );
+	Slot& list = _slots[slot];
+	++_size;
+	return iterator( this, slot, list.insert( list.end(), value ) );
+  }
+
+  void HoldList::erase( iterator itr )
+  {
+	_slots[itr._slot].erase( itr._itr );
+	--_size;
+  }
+
+  HoldList::iterator HoldList::begin()
+  {
+	iterator itr( this, 0, _slots[0].begin() );
+	itr.skip_empty();
+	return itr;
+  }
+
+  HoldList::iterator HoldList::end()
+  {
+	return iterator( this, WHEEL_SIZE + 1, Slot::iterator() );
+  }
+
+  UOExecutor* HoldList::front_due( polclock_t now )
+  {
+	if ( !overdue().empty() )
+	  return overdue().front().second;
+	if ( _size == 0 )
+	{
+	  _cursor = now + 1;
+	  return NULL;
+	}
+	for ( ; _cursor - now <= 0; ++_cursor )
+	{
+	  for ( const auto& entry : _slots[slot_of( _cursor )] )
+	  {
+		if ( entry.first == _cursor )
+		  return entry.second;
+	  }
+	}
+	return NULL;
+  }
+
+  polclock_t HoldList::clocks_until_next( polclock_t now ) const
+  {
+	if ( _size == 0 )
+	  return -1;
+	if ( !overdue().empty() )
+	  return 0;
+	// usually the next one is found within one turn of the wheel
+	for ( polclock_t tick = _cursor; tick - _cursor < WHEEL_SIZE; ++tick )
+	{
+	  for ( const auto& entry : _slots[slot_of( tick )] )
+	  {
+		if ( entry.first == tick )
+		  return ( tick - now > 0 ) ? tick - now : 0;
+	  }
+	}
+	polclock_t next = 0;
+	bool found = false;
+	for ( const auto& slot : _slots )
+	{
+	  for ( const auto& entry : slot )
+	  {
+		if ( !found || entry.first - next < 0 )
+		{
+		  next = entry.first;
+		  found = true;
+		}
+	  }
+	}
+	return ( next - now > 0 ) ? next - now : 0;
+  }
+
   ScriptEngineInternalManager::ScriptEngineInternalManager() :
+	interactive_runlist(),
 	runlist(),
 	ranlist(),
 	holdlist(),
@@ -17,7 +131,9 @@ namespace Core {
 	priority_divide(1),
 	scrstore(),
 	pidlist(),
-	next_pid(0)
+	next_pid(0),
+	worker_pool(),
+	pathfind_service()
   {
   
   }
@@ -30,9 +146,20 @@ namespace Core {
   // will be deleted by cleanup_scripts()
   // Therefore, any object that owns an executor must be destroyed 
   // before cleanup_scripts() is called.
+  void ScriptEngineInternalManager::add_runnable( UOExecutor* ex )
+  {
+	ex->scheduled = true;
+	if ( ex->os_module->priority >= INTERACTIVE_PRIORITY )
+	  interactive_runlist.push_back( ex );
+	else
+	  runlist.push_back( ex );
+  }
+
   void ScriptEngineInternalManager::deinitialize()
   {
+	worker_pool.reset();
 	scrstore.clear();
+	Clib::delete_all( interactive_runlist );
 	Clib::delete_all( runlist );
 	while ( !holdlist.empty() )
 	{
@@ -9,19 +9,83 @@
 #include "../polclock.h"
 #include <boost/noncopyable.hpp>
 #include <deque>
+#include <iterator>
+#include <list>
 #include <set>
 #include <map>
+#include <memory>
+#include <vector>
 
 namespace Pol {
+namespace threadhelp {
+  class TaskThreadPool;
+}
 namespace Core {
   class UOExecutor;
+  class PathfindService;
 
   typedef std::deque<UOExecutor*> ExecList;
   typedef std::set<UOExecutor*> NoTimeoutHoldList;
-  typedef std::multimap<Core::polclock_t, Core::UOExecutor*> HoldList;
   typedef std::map< std::string, ref_ptr<Bscript::EScriptProgram>, Clib::ci_cmp_pred > ScriptStorage;
   typedef std::map<unsigned int, UOExecutor*> PidList;
 
+  // Timer wheel for the scripts which sleep with a timeout.
+  // Every slot holds the scripts waking up at a polclock tick modulo WHEEL_SIZE,
+  // so insert and erase are O(1) and front_due() only visits the ticks which passed.
+  // Scripts inserted with a clock which was already handled wait in an extra
+  // overdue slot, the iterators stay valid until the entry is erased.
+  class HoldList
+  {
+  public:
+	typedef std::pair<polclock_t, UOExecutor*> value_type;
+	typedef std::list<value_type> Slot;
+	enum { WHEEL_SIZE = 1024 }; // ~10 seconds of polclock ticks
+
+	class iterator : public std::iterator<std::forward_iterator_tag, value_type>
+	{
+	public:
+	  iterator() : _wheel( nullptr ), _slot( 0 ), _itr() {}
+	  value_type& operator*( ) const { return *_itr; }
+	  value_type* operator->( ) const { return &*_itr; }
+	  iterator& operator++( );
+	  bool operator==( const iterator& other ) const
+	  {
+		return _slot == other._slot && ( _slot > WHEEL_SIZE || _itr == other._itr );
+	  }
+	  bool operator!=( const iterator& other ) const { return !( *this == other ); }
+	private:
+	  friend class HoldList;
+	  iterator( HoldList* wheel, size_t slot, Slot::iterator itr );
+	  void skip_empty();
+	  HoldList* _wheel;
+	  size_t _slot;
+	  Slot::iterator _itr;
+	};
+
+	HoldList();
+
+	iterator insert( const value_type& value );
+	void erase( iterator itr );
+	iterator begin();
+	iterator end();
+	size_t size() const { return _size; }
+	bool empty() const { return _size == 0; }
+
+	// first script whose clock is <= now, NULL if none. It stays in the list.
+	UOExecutor* front_due( polclock_t now );
+	// clocks until the next script wakes up (0 if one is due), -1 if empty
+	polclock_t clocks_until_next( polclock_t now ) const;
+
+  private:
+	static size_t slot_of( polclock_t clock ) { return static_cast<unsigned int>( clock ) & ( WHEEL_SIZE - 1 ); }
+	Slot& overdue() { return _slots[WHEEL_SIZE]; }
+	const Slot& overdue() const { return _slots[WHEEL_SIZE]; }
+
+	std::vector<Slot> _slots; // WHEEL_SIZE slots + overdue slot
+	polclock_t _cursor; // next tick which front_due() has to look at
+	size_t _size;
+  };
+
   class ScriptEngineInternalManager : boost::noncopyable
   {
   public:
@@ -30,6 +94,13 @@ namespace Core {
 
 	  void deinitialize();
 
+	  // queues a runnable script: scripts of players (priority >= INTERACTIVE_PRIORITY)
+	  // are run first during the next pass, everything else waits for its turn in runlist
+	  void add_runnable( UOExecutor* ex );
+	  bool has_runnable() const { return !interactive_runlist.empty() || !runlist.empty(); }
+	  static const unsigned char INTERACTIVE_PRIORITY = 100;
+
+	  ExecList interactive_runlist;
 	  ExecList runlist;
 	  ExecList ranlist;
 	  HoldList holdlist;
@@ -39,6 +110,8 @@ namespace Core {
 	  ScriptStorage scrstore;
 	  PidList pidlist;
 	  unsigned int next_pid;
+	  std::unique_ptr<threadhelp::TaskThreadPool> worker_pool; // only used with ScriptWorkerThreads
+	  std::unique_ptr<PathfindService> pathfind_service; // only used with PathfindingThreads
   };
 
   extern ScriptEngineInternalManager scriptEngineInternalManager;
@@ -7,8 +7,6 @@ namespace Core {
 
   StateManager::StateManager() :
 	last_checkpoint(),
-	cycles_per_decay_worldzone(0),
-	cycles_until_decay_worldzone(0),
 	gflag_enforce_container_limits(true),
 	gflag_in_system_load(false),
 	gflag_in_system_startup(false),
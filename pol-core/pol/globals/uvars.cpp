@@ -50,6 +50,7 @@ Notes
 #include "../musicrgn.h"
 #include "../npctmpl.h"
 #include "../party.h"
+#include "../pathfind.h"
 #include "../polsem.h"
 #include "../proplist.h"
 #include "../realms.h"
@@ -161,9 +162,11 @@ namespace Pol {
 	  landtiles(),
 	  landtiles_loaded(false),
 	  listen_points(),
+	  global_listen_points(),
 	  wwwroot_pkg(nullptr),
 	  mime_types(),
 	  task_queue(),
+	  decay_queue(),
 	  Global_Ignore_CProps(),
 	  target_cursors(),
 	  textcmds(),
@@ -187,6 +190,8 @@ namespace Pol {
 
 	  networkManager.deinialize();
 	  deinit_ipc_vars();
+	  // running searches use the realms
+	  scriptEngineInternalManager.pathfind_service.reset();
 
 	  if ( Plib::systemstate.config.log_script_cycles )
 		log_all_script_cycle_counts( false );
@@ -285,6 +290,7 @@ namespace Pol {
               world_delete( item );
             }
             realm->zone[wx][wy].items.clear();
+            realm->zone[wx][wy].tile_items.clear();
           }
 		}
 
@@ -18,6 +18,7 @@ Notes
 #include "../action.h"
 #include "../clidata.h"
 #include "../cmdlevel.h"
+#include "../decay.h"
 #include "../layers.h"
 #include "../menu.h"
 #include "../region.h"
@@ -109,6 +110,7 @@ namespace Pol {
 	typedef std::map< u16 /* graphic */, Multi::BoatShape* > BoatShapes;
 	typedef std::map<UOExecutor*, ListenPoint*> ListenPoints;
 	typedef std::priority_queue< ScheduledTask*, std::vector<ScheduledTask*>, SchComparer > TaskQueue;
+	typedef std::priority_queue< DecayEntry, std::vector<DecayEntry>, DecayComparer > DecayQueue;
 	typedef std::set<std::string> PropSet;
 
 	typedef void( *TextCmdFunc )( Network::Client* );
@@ -214,11 +216,14 @@ namespace Pol {
 	  bool landtiles_loaded;
 
 	  ListenPoints listen_points;
+	  // listen points not kept in the zones of a realm, checked on every speech
+	  std::vector<ListenPoint*> global_listen_points;
 
 	  Plib::Package* wwwroot_pkg;
 	  std::map<std::string, std::string> mime_types;
 
 	  TaskQueue task_queue;
+	  DecayQueue decay_queue;
 
 	  PropSet Global_Ignore_CProps;
 
@@ -45,6 +45,7 @@ Notes
 #include "../stackcfg.h" 
 #include "../tooltips.h"
 #include "../uoscrobj.h"
+#include "../decay.h"
 #include "../gameclck.h"
 #include "../globals/uvars.h"
 
@@ -859,6 +860,7 @@ namespace Pol {
 	void Item::on_movable_changed()
 	{
 		update_item_to_inrange( this );
+		Core::schedule_decay( this );
 	}
 
 	void Item::on_invisible_changed()
@@ -940,6 +942,7 @@ namespace Pol {
 	  if ( decayat_gameclock_ != 0 )
 	  {
         decayat_gameclock_ = Core::read_gameclock( ) + seconds;
+		Core::schedule_decay( this );
 	  }
 	}
 
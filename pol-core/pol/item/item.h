@@ -76,6 +76,8 @@ namespace Pol {
 
 	  bool is_gotten() const;
 	  void is_gotten( bool newvalue );
+	  bool in_world() const;
+	  void in_world( bool newvalue );
 
 	  bool invisible() const;
 	  void invisible( bool newvalue );
@@ -86,6 +88,9 @@ namespace Pol {
 
 	  void set_decay_after( unsigned int seconds );
 	  bool should_decay( unsigned int gameclock ) const;
+	  unsigned int decayat() const;
+	  unsigned int decay_queued() const;
+	  void decay_queued( unsigned int gameclock );
 	  void restart_decay_timer();
 	  void disable_decay();
 
@@ -203,6 +208,7 @@ namespace Pol {
 	  Mobile::Character* gotten_by;
 	protected:
 	  unsigned int decayat_gameclock_;
+	  unsigned int decay_queued_gameclock_; // entry in gamestate.decay_queue, 0 if none
 	  unsigned int sellprice_;
 	  unsigned int buyprice_;
 	  u16 amount_;
@@ -210,6 +216,7 @@ namespace Pol {
 	  bool movable_;
 	  bool inuse_;
 	  bool is_gotten_;
+	  bool in_world_;
 	  bool invisible_;
 
 	  u8 slot_index_;
@@ -273,6 +280,31 @@ namespace Pol {
 		is_gotten_ = newvalue;
 	}
 
+	inline bool Item::in_world() const
+	{
+	  return in_world_;
+	}
+
+	inline void Item::in_world( bool newvalue )
+	{
+		in_world_ = newvalue;
+	}
+
+	inline unsigned int Item::decayat() const
+	{
+	  return decayat_gameclock_;
+	}
+
+	inline unsigned int Item::decay_queued() const
+	{
+	  return decay_queued_gameclock_;
+	}
+
+	inline void Item::decay_queued( unsigned int gameclock )
+	{
+	  decay_queued_gameclock_ = gameclock;
+	}
+
 	inline bool Item::invisible() const
 	{
 	  return invisible_;
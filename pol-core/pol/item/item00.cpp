@@ -30,6 +30,7 @@ namespace Pol {
 	  container( NULL ),
 	  gotten_by( NULL ),
 	  decayat_gameclock_( 0 ),
+	  decay_queued_gameclock_( 0 ),
 	  sellprice_( UINT_MAX ), //dave changed 1/15/3 so 0 means 0, not default to itemdesc value
 	  buyprice_( UINT_MAX ),  //dave changed 1/15/3 so 0 means 0, not default to itemdesc value
 	  amount_( 1 ),
@@ -37,6 +38,7 @@ namespace Pol {
 	  movable_( id.default_movable() ),
 	  inuse_( false ),
 	  is_gotten_( 0 ),
+	  in_world_( false ),
 	  invisible_( id.invisible ),
 	  slot_index_( 0 ),
 	  _itemdesc( nullptr ),
@@ -92,6 +94,7 @@ namespace Pol {
         + sizeof( Core::UContainer* )/* container*/
         + sizeof( Mobile::Character* )/* gotten_by*/
         + sizeof(int)/* decayat_gameclock_*/
+        + sizeof(int)/* decay_queued_gameclock_*/
         +sizeof(int)/* sellprice_*/
         +sizeof(int)/* buyprice_*/
         +sizeof(u16)/* amount_*/
@@ -99,6 +102,7 @@ namespace Pol {
         +sizeof(bool)/* movable_*/
         +sizeof(bool)/* inuse_*/
         +sizeof(bool)/* is_gotten_*/
+        +sizeof(bool)/* in_world_*/
         +sizeof(bool)/* invisible_*/
         +sizeof(u8)/* slot_index_*/
         +sizeof(const ItemDesc *)/* _itemdesc*/
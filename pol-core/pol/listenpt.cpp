@@ -2,6 +2,7 @@
 History
 =======
 2009/11/24 Turley:    Added realm check
+2026/10/17 agent:     Listen points are kept in the zones of their object, speech only visits nearby zones
 
 
 Notes
@@ -19,22 +20,90 @@ Notes
 #include "ufunc.h"
 #include "uoexec.h"
 #include "uoscrobj.h"
+#include "uworld.h"
 #include "globals/uvars.h"
 
+#include "../plib/realm.h"
+
+#include <algorithm>
 #include <map>
 
 namespace Pol {
   namespace Core {
+	namespace {
+	  ZoneListenPoints& listen_point_list( const ListenPoint* lp )
+	  {
+		if ( lp->zone_realm == NULL )
+		  return gamestate.global_listen_points;
+		return lp->zone_realm->zone[lp->zone_x][lp->zone_y].listen_points;
+	  }
+
+	  void unlink_listen_point( ListenPoint* lp )
+	  {
+		ZoneListenPoints& points = listen_point_list( lp );
+		ZoneListenPoints::iterator itr = std::find( points.begin(), points.end(), lp );
+		passert( itr != points.end() );
+		points.erase( itr );
+	  }
+
+	  // realm NULL puts the point into the global list
+	  void link_listen_point( ListenPoint* lp, Plib::Realm* realm, unsigned short x, unsigned short y )
+	  {
+		if ( lp->range > LISTENPT_MAX_ZONE_RANGE )
+		  realm = NULL;
+		lp->zone_realm = realm;
+		if ( realm != NULL )
+		  zone_convert( x, y, &lp->zone_x, &lp->zone_y, realm );
+		else
+		  lp->zone_x = lp->zone_y = 0;
+		listen_point_list( lp ).push_back( lp );
+	  }
+
+	  void relink_listen_point( ListenPoint* lp, Plib::Realm* realm, unsigned short x, unsigned short y )
+	  {
+		if ( lp->range > LISTENPT_MAX_ZONE_RANGE )
+		  realm = NULL;
+		if ( lp->zone_realm == realm &&
+			 ( realm == NULL || ( lp->zone_x == ( x >> WGRID_SHIFT ) && lp->zone_y == ( y >> WGRID_SHIFT ) ) ) )
+		  return;
+		unlink_listen_point( lp );
+		link_listen_point( lp, realm, x, y );
+	  }
+
+	  // the world position the points of obj are kept at, false if obj is not directly in the world
+	  bool listen_position( UObject* obj )
+	  {
+		if ( obj->ismobile() || obj->ismulti() )
+		  return obj->realm != NULL;
+		Items::Item* item = static_cast<Items::Item*>( obj );
+		return item->container == NULL && item->in_world();
+	  }
+
+	  void delete_listen_point( ListenPoint* lp )
+	  {
+		gamestate.listen_points.erase( lp->uoexec );
+		delete lp;
+	  }
+	}
 
 	ListenPoint::ListenPoint( UObject* obj, UOExecutor* uoexec, int range, int flags ) :
 	  object( obj ),
 	  uoexec( uoexec ),
 	  range( range ),
-	  flags( flags )
-	{}
+	  flags( flags ),
+	  zone_realm( NULL ),
+	  zone_x( 0 ),
+	  zone_y( 0 )
+	{
+	  ++obj->listen_point_count;
+	  link_listen_point( this, listen_position( obj ) ? obj->realm : NULL, obj->x, obj->y );
+	}
 
 	ListenPoint::~ListenPoint()
-	{}
+	{
+	  unlink_listen_point( this );
+	  --object->listen_point_count;
+	}
 
 	const char* TextTypeToString( u8 texttype )
 	{
@@ -51,34 +120,25 @@ namespace Pol {
 								 const u16* p_wtext /*=nullptr*/, const char* p_lang /*=nullptr*/,
 								 int p_wtextlen /*=0*/, Bscript::ObjArray* speechtokens /*=nullptr*/ )
 	{
-	  for ( ListenPoints::iterator itr = gamestate.listen_points.begin(), end = gamestate.listen_points.end(); itr != end; )
+	  auto sayto = [&]( ZoneListenPoints& points )
 	  {
-		ListenPoint* lp = ( *itr ).second;
-		if ( lp->object->orphan() )
-		{
-		  ListenPoints::iterator next = itr;
-		  ++next;
-		  gamestate.listen_points.erase( itr );
-		  delete lp;
-		  itr = next;
-		  end = gamestate.listen_points.end();
-		}
-		else
+		for ( size_t i = 0; i < points.size(); )
 		{
+		  ListenPoint* lp = points[i];
+		  if ( lp->object->orphan() )
+		  {
+			delete_listen_point( lp ); // removes it from points
+			continue;
+		  }
+		  ++i;
 		  if ( !speaker->dead() || ( lp->flags&LISTENPT_HEAR_GHOSTS ) )
 		  {
 			if ( settingsManager.ssopt.seperate_speechtoken )
 			{
 			  if ( speechtokens != NULL && ( ( lp->flags & LISTENPT_HEAR_TOKENS ) == 0 ) )
-			  {
-				++itr;
 				continue;
-			  }
 			  else if ( speechtokens == NULL && ( lp->flags & LISTENPT_NO_SPEECH ) )
-			  {
-				++itr;
 				continue;
-			  }
 			}
 			const UObject* toplevel = lp->object->toplevel_owner();
 			if ( ( speaker->realm == toplevel->realm ) && ( inrangex( speaker, toplevel->x, toplevel->y, lp->range ) ) )
@@ -92,21 +152,61 @@ namespace Pol {
 				TextTypeToString( texttype ) ) );
 			}
 		  }
-		  ++itr;
 		}
+	  };
+
+	  sayto( gamestate.global_listen_points );
+	  if ( speaker->realm == NULL )
+		return;
+	  unsigned short wxL, wyL, wxH, wyH;
+	  zone_convert_clip( speaker->x - LISTENPT_MAX_ZONE_RANGE, speaker->y - LISTENPT_MAX_ZONE_RANGE, speaker->realm, &wxL, &wyL );
+	  zone_convert_clip( speaker->x + LISTENPT_MAX_ZONE_RANGE, speaker->y + LISTENPT_MAX_ZONE_RANGE, speaker->realm, &wxH, &wyH );
+	  for ( unsigned short wx = wxL; wx <= wxH; ++wx )
+	  {
+		for ( unsigned short wy = wyL; wy <= wyH; ++wy )
+		  sayto( speaker->realm->zone[wx][wy].listen_points );
 	  }
 	}
 
+	void move_listen_points( UObject* obj, Plib::Realm* oldrealm, unsigned short oldx, unsigned short oldy,
+							 Plib::Realm* newrealm, unsigned short newx, unsigned short newy )
+	{
+	  if ( obj->listen_point_count == 0 )
+		return;
+
+	  // collected first, relinking changes the lists
+	  std::vector<ListenPoint*> found;
+	  auto collect = [&]( const ZoneListenPoints& points )
+	  {
+		for ( const auto& lp : points )
+		{
+		  if ( lp->object.get() == obj )
+			found.push_back( lp );
+		}
+	  };
+	  if ( oldrealm != NULL )
+		collect( getzone( oldx, oldy, oldrealm ).listen_points );
+	  if ( found.size() < obj->listen_point_count )
+		collect( gamestate.global_listen_points );
+	  if ( found.size() < obj->listen_point_count )
+	  {
+		// the position was changed without telling the world
+		found.clear();
+		for ( const auto& lp_pair : gamestate.listen_points )
+		{
+		  if ( lp_pair.second->object.get() == obj )
+			found.push_back( lp_pair.second );
+		}
+	  }
+	  for ( const auto& lp : found )
+		relink_listen_point( lp, newrealm, newx, newy );
+	}
+
 	void deregister_from_speech_events( UOExecutor* uoexec )
 	{
-	  //ListenPoint lp( NULL, uoexec, 0, 0 );
 	  ListenPoints::iterator itr = gamestate.listen_points.find( uoexec );
 	  if ( itr != gamestate.listen_points.end() ) // could have been cleaned up in sayto_listening_points
-	  {
-		ListenPoint* lp = ( *itr ).second;
-		gamestate.listen_points.erase( uoexec );
-		delete lp;
-	  }
+		delete_listen_point( itr->second );
 	}
 
 	void register_for_speech_events( UObject* obj, UOExecutor* uoexec, int range, int flags )
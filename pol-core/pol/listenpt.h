@@ -22,6 +22,9 @@ namespace Pol {
   namespace Mobile {
 	class Character;
   }
+  namespace Plib {
+	class Realm;
+  }
   namespace Core {
 	class UObject;
 	class UOExecutor;
@@ -36,6 +39,11 @@ namespace Pol {
 	  UOExecutor* uoexec;
 	  int range;
 	  int flags;
+
+	  // zone the point is kept in, realm is NULL for gamestate.global_listen_points
+	  Plib::Realm* zone_realm;
+	  unsigned short zone_x;
+	  unsigned short zone_y;
 	};
 
 	const char* TextTypeToString( u8 texttype ); //DAVE
@@ -47,8 +55,17 @@ namespace Pol {
 	const int LISTENPT_HEAR_TOKENS = 0x02;
 	const int LISTENPT_NO_SPEECH = 0x04;
 
+	// Listen points on mobiles and on items or multis lying in the world are kept in the zone
+	// of their object, so speech only visits the zones around the speaker. Points on items in
+	// containers and points with a larger range than this are checked on every speech.
+	const int LISTENPT_MAX_ZONE_RANGE = 32;
+
 	void register_for_speech_events( UObject* obj, UOExecutor* uoexec, int range, int flags );
 	void deregister_from_speech_events( UOExecutor* uoexec );
+	// called by the world when a listening object is added, moved or removed,
+	// newrealm is NULL if obj left the world
+	void move_listen_points( UObject* obj, Plib::Realm* oldrealm, unsigned short oldx, unsigned short oldy,
+							 Plib::Realm* newrealm, unsigned short newx, unsigned short newy );
 	void clear_listen_points();
 
 	Bscript::BObjectImp* GetListenPoints();
@@ -131,6 +131,7 @@ Notes
 #include "../statmsg.h"
 #include "../syshook.h"
 #include "../target.h"
+#include "../tooltips.h"
 #include "../uconst.h"
 #include "../ufunc.h"
 #include "../ufuncstd.h"
@@ -2814,27 +2815,34 @@ namespace Pol {
       using namespace Network;
 	  if ( chr == NULL ) return;
 	  RemoveObjectPkt msgremove( chr->serial_ext );
-	  PktHelper::PacketOut<PktOut_77> msgmove;
+	  Core::MoveBroadcast moves( chr );
 	  PktHelper::PacketOut<PktOut_17> msgpoison;
 	  PktHelper::PacketOut<PktOut_17> msginvul;
 	  PktHelper::PacketOut<PktOut_78> msgcreate;
-	  build_send_move( chr, msgmove.Get() );
 	  build_poisonhealthbar( chr, msgpoison.Get() );
 	  build_invulhealthbar( chr, msginvul.Get() );
 	  build_owncreate( chr, msgcreate.Get() );
 
-      Core::WorldIterator<Core::OnlinePlayerFilter>::InVisualRange( chr, [&]( Character* zonechr )
+      auto propagate = [&]( Character* zonechr )
       {
         Client *client = zonechr->client;
         if ( zonechr == chr )
           return;
+        Network::KnownObjects& known = client->gd->known_objects;
+        const Network::KnownObjects::Entry* entry = known.find( chr->serial_ext );
+        if ( !Core::inrange( zonechr, chr ) )
+        {
+          // if we just walked out of range of this character, send its
+          // client a remove object, or else a ghost character will remain.
+          if ( entry != NULL )
+            send_remove_character( client, chr, msgremove );
+          return;
+        }
         if ( !zonechr->is_visible_to_me( chr ) )
           return;
         /* The two characters exist, and are in range of each other.
-        Character 'chr''s lastx and lasty coordinates are valid.
-        SO, if lastx/lasty are out of range of client->chr, we
-        should send a 'create' type message.  If they are in range,
-        we should just send a move.
+        If the client already knows 'chr' we just send a move,
+        otherwise a 'create' type message.
         */
 		if ( chr->move_reason == Character::MULTIMOVE )
         {
@@ -2846,6 +2854,8 @@ namespace Pol {
 				if ( chr->invul() ) //if invul send 0x17 for newer clients
 					send_invulhealthbar( client, chr );
 
+				// the boat packet moved it on the client, keep forget_outside in step
+				known.sent( chr );
 				return;
 			}
 			else
@@ -2861,29 +2871,37 @@ namespace Pol {
 				send_owncreate( client, chr, msgcreate.Get( ), msgpoison.Get( ), msginvul.Get( ) );
 			}
         }
-        else if ( Core::inrange( zonechr->x, zonechr->y, chr->lastx, chr->lasty ) )
+        else if ( entry != NULL )
         {
-          send_move( client, chr, msgmove.Get( ), msgpoison.Get( ), msginvul.Get( ) );
+          moves.add( client );
+          if ( entry->rev != chr->rev() && ( client->UOExpansionFlag & AOS ) )
+            send_object_cache( client, chr );
+          known.sent( chr );
         }
         else
         {
           send_owncreate( client, chr, msgcreate.Get( ), msgpoison.Get( ), msginvul.Get( ) );
         }
-      } );
+      };
 
-      // iter over all old in range players and send remove
-      Core::WorldIterator<Core::OnlinePlayerFilter>::InRange( chr->lastx, chr->lasty, chr->realm, RANGE_VISUAL, [&]( Character* zonechr )
+      // one pass over the zones around the old and the new position, unless they are far apart
+      int dx = abs( chr->x - chr->lastx );
+      int dy = abs( chr->y - chr->lasty );
+      if ( dx <= 2 * RANGE_VISUAL && dy <= 2 * RANGE_VISUAL )
       {
-        Client *client = zonechr->client;
-        if ( !zonechr->is_visible_to_me( chr ) )
-          return;
-
-        if ( Core::inrange( zonechr, chr ) ) // already handled
-          return;
-        // if we just walked out of range of this character, send its
-        // client a remove object, or else a ghost character will remain.
-        send_remove_character( client, chr, msgremove );
-      } );
+        Core::WorldIterator<Core::OnlinePlayerFilter>::InBox(
+          static_cast<u16>( std::max( std::min( chr->x, chr->lastx ) - RANGE_VISUAL, 0 ) ),
+          static_cast<u16>( std::max( std::min( chr->y, chr->lasty ) - RANGE_VISUAL, 0 ) ),
+          static_cast<u16>( std::max( chr->x, chr->lastx ) + RANGE_VISUAL ),
+          static_cast<u16>( std::max( chr->y, chr->lasty ) + RANGE_VISUAL ),
+          chr->realm, propagate );
+      }
+      else
+      {
+        Core::WorldIterator<Core::OnlinePlayerFilter>::InVisualRange( chr, propagate );
+        Core::WorldIterator<Core::OnlinePlayerFilter>::InRange( chr->lastx, chr->lasty, chr->realm, RANGE_VISUAL, propagate );
+      }
+      moves.send();
 	}
 
 	void Character::getpos_ifmove( Core::UFACING i_facing, unsigned short* px, unsigned short* py )
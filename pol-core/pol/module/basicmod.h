@@ -73,6 +73,8 @@ namespace Pol {
 
 	  BasicExecutorModule( Bscript::Executor& exec ) : ExecutorModule( "Basic", exec ) {}
 
+	  virtual bool is_threadsafe() const POL_OVERRIDE { return true; }
+
 	  // class machinery
 	protected:
 	  virtual Bscript::BObjectImp* execFunc( unsigned idx ) POL_OVERRIDE;
@@ -5,6 +5,7 @@ History
 2006/09/26 Shinigami: GCC 3.4.x fix - added "template<>" to TmplExecutorModule
 2007/06/17 Shinigami: added config.world_data_path
 2009/12/21 Turley:    ._method() call fix
+2026/10/17 agent:     datastore bookkeeping for snapshot saves
 
 Notes
 =======
@@ -35,6 +36,7 @@ Notes
 #include "../globals/ucfg.h"
 
 #include <fstream>
+#include <vector>
 
 namespace Pol {
 
@@ -736,7 +738,8 @@ namespace Pol {
 
 		if ( dsf->unload )
 		{
-		  if ( dsf->dfcontents.get() != NULL )
+		  // contents changed since they were written (during a snapshot save) stay loaded
+		  if ( dsf->dfcontents.get() != NULL && !dsf->dfcontents->dirty )
 		  {
 			if ( dsf->dfcontents->count() == 1 )
 			{
@@ -747,5 +750,66 @@ namespace Pol {
 		}
 	  }
 	}
+
+	namespace
+	{
+	  struct DataStoreFileVersions
+	  {
+		std::string descriptor;
+		unsigned delversion;
+		unsigned oldversion;
+		unsigned version;
+		bool dirty;
+	  };
+	  std::vector<DataStoreFileVersions> snapshot_versions;
+	}
+
+	// The snapshot save writes the datastore in a forked child, which can't hand the new
+	// file versions back. The server does the same bookkeeping as write_datastore() without
+	// writing and keeps the previous versions in case the snapshot fails.
+	void snapshot_datastore()
+	{
+	  snapshot_versions.clear();
+	  for ( Core::DataStore::iterator itr = Core::configurationbuffer.datastore.begin(); itr != Core::configurationbuffer.datastore.end(); ++itr )
+	  {
+		DataStoreFile* dsf = ( *itr ).second;
+		bool dirty = dsf->dfcontents.get() && dsf->dfcontents->dirty;
+		DataStoreFileVersions versions = { itr->first, dsf->delversion, dsf->oldversion, dsf->version, dirty };
+		snapshot_versions.push_back( versions );
+
+		dsf->delversion = dsf->oldversion;
+		dsf->oldversion = dsf->version;
+		if ( dirty )
+		{
+		  ++dsf->version;
+		  dsf->dfcontents->dirty = false;
+		}
+	  }
+	}
+
+	void finish_datastore_snapshot( bool success )
+	{
+	  if ( success )
+	  {
+		commit_datastore();
+	  }
+	  else
+	  {
+		// the files the child wrote are overwritten by the next save
+		for ( const auto& versions : snapshot_versions )
+		{
+		  Core::DataStore::iterator itr = Core::configurationbuffer.datastore.find( versions.descriptor );
+		  if ( itr == Core::configurationbuffer.datastore.end() )
+			continue;
+		  DataStoreFile* dsf = ( *itr ).second;
+		  dsf->delversion = versions.delversion;
+		  dsf->oldversion = versions.oldversion;
+		  dsf->version = versions.version;
+		  if ( versions.dirty && dsf->dfcontents.get() )
+			dsf->dfcontents->dirty = true;
+		}
+	  }
+	  snapshot_versions.clear();
+	}
   }
 }
\ No newline at end of file
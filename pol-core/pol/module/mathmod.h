@@ -20,6 +20,8 @@ namespace Pol {
       MathExecutorModule( Bscript::Executor& exec ) :
 		Bscript::TmplExecutorModule<MathExecutorModule>( "math", exec ) {};
 
+	  virtual bool is_threadsafe() const POL_OVERRIDE { return true; }
+
 	  Bscript::BObjectImp* mf_Sin();
 	  Bscript::BObjectImp* mf_ASin();
 	  Bscript::BObjectImp* mf_Cos();
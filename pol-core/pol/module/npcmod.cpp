@@ -891,10 +891,10 @@ namespace Pol {
 	  const String* propname_str;
 	  if ( exec.getStringParam( 0, propname_str ) )
 	  {
-          std::string val;
-		if ( npc.getprop( propname_str->value(), val ) )
+          BObjectImp* val = npc.getpropimp( propname_str->value() );
+		if ( val != NULL )
 		{
-		  return BObjectImp::unpack( val.c_str() );
+		  return val;
 		}
 		else
 		{
@@ -913,7 +913,7 @@ namespace Pol {
 	  if ( exec.getStringParam( 0, propname_str ) )
 	  {
 		BObjectImp* propval = getParamImp( 1 );
-		npc.setprop( propname_str->value(), propval->pack() );
+		npc.setpropimp( propname_str->value(), *propval );
 		return new BLong( 1 );
 	  }
 	  else
@@ -751,13 +751,13 @@ namespace Pol {
         {
             Core::scriptEngineInternalManager.holdlist.erase(hold_itr_);
             in_hold_list_ = NO_LIST;
-            Core::scriptEngineInternalManager.runlist.push_back(static_cast<Core::UOExecutor*>(&exec));
+            Core::scriptEngineInternalManager.add_runnable(static_cast<Core::UOExecutor*>(&exec));
         }
         else if (in_hold_list_ == NOTIMEOUT_LIST)
         {
             Core::scriptEngineInternalManager.notimeoutholdlist.erase(static_cast<Core::UOExecutor*>(&exec));
             in_hold_list_ = NO_LIST;
-            Core::scriptEngineInternalManager.runlist.push_back(static_cast<Core::UOExecutor*>(&exec));
+            Core::scriptEngineInternalManager.add_runnable(static_cast<Core::UOExecutor*>(&exec));
         }
         else if (in_hold_list_ == DEBUGGER_LIST)
         {
@@ -772,7 +772,7 @@ namespace Pol {
     {
         Core::scriptEngineInternalManager.debuggerholdlist.erase(static_cast<Core::UOExecutor*>(&exec));
         in_hold_list_ = NO_LIST;
-        Core::scriptEngineInternalManager.runlist.push_back(static_cast<Core::UOExecutor*>(&exec));
+        Core::scriptEngineInternalManager.add_runnable(static_cast<Core::UOExecutor*>(&exec));
     }
 
     const int SCRIPTOPT_NO_INTERRUPT = 1;
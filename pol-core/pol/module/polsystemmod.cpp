@@ -7,6 +7,7 @@ History
                       explicitly.
 2009/11/30 Turley:    added MD5Encrypt(string)
 2010/03/28 Shinigami: Transmit Pointer as Pointer and not Int as Pointer within decay_thread_shadow
+2026/10/17 agent:     DeleteRealm refuses a realm while FindPath searches of the pathfinding threads use it
 
 Notes
 =======
@@ -51,7 +52,6 @@ Notes
 
 namespace Pol {
   namespace Core {
-    void decay_thread_shadow( void* );
     void reload_configuration( );
   }
   namespace Module {
@@ -426,14 +426,6 @@ namespace Pol {
       if ( Core::defined_realm( realm_name->value( ) ) )
 		return new BError( "Realmname already defined." );
       Core::add_realm( realm_name->value( ), baserealm );
-      if ( Core::settingsManager.ssopt.decay_items )
-	  {
-#ifndef PERGON
-        std::ostringstream thname;
-		thname << "Decay_" << realm_name->value();
-        threadhelp::start_thread( Core::decay_thread_shadow, thname.str( ).c_str( ), (void*)Core::find_realm( realm_name->value( ) ) );
-#endif
-	  }
 	  return new BLong( 1 );
 	}
 
@@ -457,6 +449,8 @@ namespace Pol {
 		return new BError( "Items in Realm." );
       if (realm->multi_count() > 0)
           return new BError("Multis in Realm.");
+      if (realm->pathfind_count() > 0)
+          return new BError("FindPath searches running in Realm.");
 
       Core::remove_realm( realm_name->value( ) );
 	  return new BLong( 1 );
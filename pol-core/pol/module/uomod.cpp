@@ -103,6 +103,7 @@ Notes
 #include "../pktin.h"
 #include "../polcfg.h"
 #include "../polclass.h"
+#include "../polsem.h"
 #include "../poltype.h"
 #include "../realms.h"
 #include "../savedata.h"
@@ -115,7 +116,7 @@ Notes
 #include "../ufunc.h"
 #include "../umanip.h"
 #include "../uofile.h"
-#include "../uopathnode.h"
+#include "../pathfind.h"
 #include "../uoscrobj.h"
 #include "../ustruct.h"
 #include "../globals/uvars.h"
@@ -132,6 +133,7 @@ Notes
 #include "../containr.h"
 #include "../globals/state.h"
 #include "../globals/object_storage.h"
+#include "../globals/script_internals.h"
 
 #include "../../clib/cfgelem.h"
 #include "../../clib/cfgfile.h"
@@ -1800,10 +1802,10 @@ namespace Pol {
 	  if ( getUObjectParam( exec, 0, uobj ) &&
 		   getStringParam( 1, propname_str ) )
 	  {
-		std::string val;
-		if ( uobj->getprop( propname_str->value(), val ) )
+		BObjectImp* val = uobj->getpropimp( propname_str->value() );
+		if ( val != NULL )
 		{
-		  return BObjectImp::unpack( val.c_str() );
+		  return val;
 		}
 		else
 		{
@@ -1824,7 +1826,7 @@ namespace Pol {
 		   getStringParam( 1, propname_str ) )
 	  {
 		BObjectImp* propval = getParamImp( 2 );
-		uobj->setprop( propname_str->value(), propval->pack() );
+		uobj->setpropimp( propname_str->value(), *propval );
 		return new BLong( 1 );
 	  }
 	  else
@@ -1874,10 +1876,10 @@ namespace Pol {
 	  const String* propname_str;
 	  if ( getStringParam( 0, propname_str ) )
 	  {
-		std::string val;
-		if ( gamestate.global_properties->getprop( propname_str->value(), val ) )
+		BObjectImp* val = gamestate.global_properties->getpropimp( propname_str->value() );
+		if ( val != NULL )
 		{
-		  return BObjectImp::unpack( val.c_str() );
+		  return val;
 		}
 		else
 		{
@@ -1896,7 +1898,7 @@ namespace Pol {
 	  if ( exec.getStringParam( 0, propname_str ) )
 	  {
 		BObjectImp* propval = exec.getParamImp( 1 );
-		gamestate.global_properties->setprop( propname_str->value(), propval->pack() );
+		gamestate.global_properties->setpropimp( propname_str->value(), *propval );
 		return new BLong( 1 );
 	  }
 	  else
@@ -2860,7 +2862,7 @@ namespace Pol {
             std::unique_ptr<ObjArray> newarr(new ObjArray());
             
             for (const auto &objitr : Pol::Core::objStorageManager.objecthash) {
-                UObject* obj = objitr.second.get();
+                UObject* obj = objitr.get();
                 if (!obj->ismobile() || obj->isa(UObject::CLASS_NPC))
                     continue;
 
@@ -5089,97 +5091,91 @@ namespace Pol {
 		return new BError( "Invalid parameter" );
 	}
 
-	//  Birdy :  (Notes on Pathfinding)
+	//  Notes on Pathfinding
 	//
-	//  This implimentation of pathfinding is actually from a very nice stl based A*
-	//  implimentation.  It will, within reason, succeed in finding a path in a wide
-	//  variety of circumstance, including traversing stairs and multiple level
-	//  structures.
-	//
-	//  Unfortunately, it, or my POL support classes implimenting it, seems to at times
-	//  generate corrupted results in finding a path.  These corruptions take the form
-	//  of basically looping within the result list, or linking in non-closed list nodes
-	//  which may be on the open list and generate more looping or which may have even
-	//  been deleted by the algorithm, generally causing an illegal reference and crash.
-	//
-	//  Thus far, the above senerio has only been replicated, though fairly reliably, in
-	//  cases where there are many many(about 100) npc's trying to pathfind at the same time,
-	//  in close proximity to one another.
-	//
-	//  "Looping" will, of course, cause the shard to hang while the pathfinding routine
-	//  tries to build the child list for the solution set.  An illegal reference will
-	//  cause the shard to crash most likely.  Neither is tollerable of course, so I have
-	//  put in two safeguards against this.
-	//
-	//  Safeguard #1) As we go through the nodes in the solution, I make sure each of them
-	//				is on the Closed List.  If not, the pathfind errors out with a
-	//				"Solution Corrupt!" error.  This is an attempt to short circuit any
-	//				solution containing erroneous nodes in it.
-	//
-	//  Safeguard #2) I keep a vector of the nodes in the solution as we go through them.
-	//				Before adding each node to the vector, I search that vector for that
-	//				node.  If that vector already contains the node, the pathfind errors
-	//				out with a "Solution Corrupt!" error.  THis is an attempt to catch
-	//				the cases where Closed List nodes have looped for some reason.
-	//
-	//  These two safeguards should not truly be necessary for this algorithm, and take up
-	//  space and time to guard against.  Thus, finding out why these problems are occurring
-	//  in the first place would be great, as we could fix that instead and remove these
-	//  checks.  If necessary to live with long term, then the solution vector should probably
-	//  be made into a hash table for quick lookups.
-	//
-	//  I have also implimented a sort blocking list that is supposed to represent those
-	//  spots that mobiles occupy and are thus not walkable on.  This is only maintained if
-	//  the mobilesBlock parameter passed from escript is true.  It would probably be good
-	//  to make this a hash table.  It may be said that it is a good idea to pre-process all
-	//  blocking spots on the map, but this would hinder the ability to manage 3d shifts, or
-	//  probably be prohibitive if an attempt were made to check for traversal at all possible
-	//  various z's.  So it may be that checking such at the time of the search for the path
-	//  is ultimately the best means of handling this.
-	//
-	//  Other details that may be nice to have here might be a method for interacting with
-	//  escript, letting escript tell the pathfinder to ignore doors, and then the pathfinder
-	//  putting in the solution list an indication to escript that at the given node a door
-	//  was encountered, so that AI can open the door before attempting to traverse that
-	//  path.  Providing the user the ability to define an array of objects which are to be
-	//  considered as blocking, or an array of objects which are to be ignored even if they
-	//  are blocking might be nice as well.  The former could be easily implimented by
-	//  adding to the mobile's blocking list.  The latter may be more difficult to do
-	//  considering if the item blocks, the walk function will not let you traverse it, and
-	//  it is the walk function that we use to accurately replicate the ability of the
-	//  mobile to traverse from one place to the next.  Additional functionality of some
-	//  sort may be necessary to do this, or making a copy of the walk function and putting
-	//  in a special walk function strictly for pathfinding which can take this array into
-	//  account.
-	//
-	//  For now, however, these concerns are all unaddressed.  I wish to see if this
-	//  function works and is useful, and also would prefer to find some way to track down
-	//  the corruption of the solution nodes before adding more complexity to the problem.
-	//
-	//  Other than the below function, the following files will be added to CVS to support
-	//  it in the src module.  They are :
-	//
-	//  stlastar.h  --  virtually untouched by me really, it is the original author's
-	//				  implimentation, pretty nicely done and documented if you are
-	//				  interested in learning about A*.
-	//
-	//  fsa.h	   --  a "fixed size allocation" module which I toy with enabling and
-	//				  disabling.  Using it is supposed to get you some speed, but it
-	//				  limits your maps because it will only allocate a certain # of
-	//				  nodes at once, and after that, it will return out of memory.
-	//				  Presently, it is disabled, but will be submitted to CVS for
-	//				  completion in case we wish to use it later.
-	//
-	//  uopathnode.h -- this is stricly my work, love it or hate it, it's pretty quick
-	//				  and dirty, and can stand to be cleaned up, optimized, and so forth.
-	//				  I have the name field and function in there to allow for some
-	//				  debugging, though the character array could probably be removed to
-	//				  make the nodes smaller.  I didn't find it mattered particularly, since
-	//				  these puppies are created and destroyed at a pretty good clip.
-	//				  It is this class that encapsulates the necessary functionality to
-	//				  make the otherwise fairly generic stlastar class work.
+	//  FindPath runs an A* search (see pathfind.h) over the tiles inside a box around
+	//  the start and end position, using the same walkheight checks as a walking
+	//  mobile, so stairs and multiple level structures are traversed.
+	//  Mobiles in the box are collected once before the search and block the tiles
+	//  they stand on if FP_IGNORE_MOBILES is not set.
+	//  A search gives up with "Out of memory." once it has visited more nodes than
+	//  the limit, to keep large unreachable areas from stalling the script thread.
+	//  With PathfindingThreads the items and multis of the box are copied as well and
+	//  the search runs on a pathfinding thread while the script sleeps.
 
-	typedef Plib::AStarSearch<UOPathState> UOSearch;
+	// array of structs{x,y,z}, the result of FindPath
+	ObjArray* path_to_array( const std::vector<PathStep>& path )
+	{
+	  std::unique_ptr<ObjArray> nodeArray( new ObjArray() );
+	  for ( const auto& step : path )
+	  {
+		std::unique_ptr<BStruct> nextStep( new BStruct );
+		nextStep->addMember( "x", new BLong( step.x ) );
+		nextStep->addMember( "y", new BLong( step.y ) );
+		nextStep->addMember( "z", new BLong( step.z ) );
+		nodeArray->addElement( nextStep.release() );
+	  }
+	  return nodeArray.release();
+	}
+
+	BObjectImp* findpath_result( PathFinder::Result result, const std::vector<PathStep>& path )
+	{
+	  if ( result == PathFinder::PATH_FOUND )
+		return path_to_array( path );
+	  else if ( result == PathFinder::PATH_OUT_OF_NODES )
+		return new BError( "Out of memory." );
+	  else
+		return new BError( "Failed to find a path." );
+	}
+
+	struct FindPathJob
+	{
+	  PathRequest req;
+	  weak_ptr<UOExecutor> script; // only touched under the PolLock
+	};
+
+	// search on a pathfinding thread, the script sleeps until the result is there
+	BObjectImp* background_findpath( UOExecutor& uoexec, PathRequest& req )
+	{
+	  snapshot_dynamics( req );
+	  std::shared_ptr<FindPathJob> job( new FindPathJob { PathRequest(), weak_ptr<UOExecutor>( nullptr ) } );
+	  std::swap( job->req, req );
+	  job->script = uoexec.weakptr;
+	  // keeps DeleteRealm away until the search has finished
+	  job->req.realm->add_pathfind();
+
+	  if ( scriptEngineInternalManager.pathfind_service == nullptr )
+		scriptEngineInternalManager.pathfind_service.reset( new PathfindService( Plib::systemstate.config.pathfinding_threads ) );
+	  scriptEngineInternalManager.pathfind_service->push( [job]( PathFinder& pathfinder )
+	  {
+		std::vector<PathStep> path;
+		PathFinder::Result result = PathFinder::PATH_NOT_FOUND;
+		try
+		{
+		  result = pathfinder.find( job->req, path );
+		}
+		catch ( std::exception& ex )
+		{
+		  // the realm and the script below still have to be released
+		  ERROR_PRINT << "FindPath exception: " << ex.what() << "\n";
+		  path.clear();
+		}
+
+		PolLock lck;
+		job->req.realm->remove_pathfind();
+		if ( Plib::systemstate.config.loglevel >= 12 )
+          POLLOG.Format( "[FindPath]   expanded {} of {} nodes\n" ) << pathfinder.expanded_nodes() << pathfinder.visited_nodes();
+		if ( job->script.exists() ) // the script may have been killed meanwhile
+		{
+		  UOExecutor* ex = job->script.get_weakptr();
+		  ex->ValueStack.back().set( new BObject( findpath_result( result, path ) ) );
+		  ex->os_module->revive();
+		}
+		job->script.clear();
+	  } );
+	  uoexec.os_module->suspend();
+	  return new BLong( 0 );
+	}
 
 	BObjectImp* UOExecutorModule::mf_FindPath()
 	{
@@ -5215,9 +5211,18 @@ namespace Pol {
 		if ( !realm ) return new BError( "Realm not found" );
 		if ( !realm->valid( x1, y1, z1 ) ) return new BError( "Start Coordinates Invalid for Realm" );
 		if ( !realm->valid( x2, y2, z2 ) ) return new BError( "End Coordinates Invalid for Realm" );
-		UOSearch * astarsearch;
-		unsigned int SearchState;
-		astarsearch = new UOSearch;
+
+		PathRequest req;
+		req.realm = realm;
+		req.x1 = x1;
+		req.y1 = y1;
+		req.z1 = z1;
+		req.x2 = x2;
+		req.y2 = y2;
+		req.z2 = z2;
+		// passed to realm->walkheight
+		req.doors_block = ( flags & FP_IGNORE_DOORS ) ? false : true;
+
 		short xL, xH, yL, yH;
 
 		if ( x1 < x2 )
@@ -5251,6 +5256,11 @@ namespace Pol {
 		if ( yH >= realm->height() )
 		  yH = realm->height() - 1;
 
+		req.xL = xL;
+		req.xH = xH;
+		req.yL = yL;
+		req.yH = yH;
+
 		if ( Plib::systemstate.config.loglevel >= 12 )
 		{
           POLLOG.Format( "[FindPath] Calling FindPath({}, {}, {}, {}, {}, {}, {}, 0x{:X}, {})\n" )
@@ -5258,13 +5268,12 @@ namespace Pol {
           POLLOG.Format( "[FindPath]   search for Blockers inside {} {} {} {}\n" ) << xL << yL << xH << yH;
 		}
 
-		AStarBlockers theBlockers( xL, xH, yL, yH );
-
 		if ( !( flags & FP_IGNORE_MOBILES ) )
 		{
           WorldIterator<MobileFilter>::InBox( xL, yL, xH, yH, realm, [&]( Mobile::Character* chr )
           {
-            theBlockers.AddBlocker( chr->x, chr->y, chr->z );
+            PathStep blocker = { static_cast<short>( chr->x ), static_cast<short>( chr->y ), chr->z };
+            req.blockers.push_back( blocker );
 
             if ( Plib::systemstate.config.loglevel >= 12 )
               POLLOG.Format( "[FindPath]	 add Blocker {} at {} {} {}\n" )
@@ -5272,62 +5281,26 @@ namespace Pol {
           } );
 		}
 
-		// passed via GetSuccessors to realm->walkheight
-		bool doors_block = ( flags & FP_IGNORE_DOORS ) ? false : true;
-
 		if ( Plib::systemstate.config.loglevel >= 12 )
 		{
           POLLOG.Format( "[FindPath]   use StartNode {} {} {}\n" ) << x1 << y1 << z1;
           POLLOG.Format( "[FindPath]   use EndNode {} {} {}\n" ) << x2 << y2 << z2;
 		}
 
-		// Create a start state
-		UOPathState nodeStart( x1, y1, z1, realm, &theBlockers );
-		// Define the goal state
-		UOPathState nodeEnd( x2, y2, z2, realm, &theBlockers );
-		// Set Start and goal states
-		astarsearch->SetStartAndGoalStates( nodeStart, nodeEnd );
-		do
-		{
-		  SearchState = astarsearch->SearchStep( doors_block );
-		} while ( SearchState == UOSearch::SEARCH_STATE_SEARCHING );
-		if ( SearchState == UOSearch::SEARCH_STATE_SUCCEEDED )
-		{
-		  UOPathState *node = astarsearch->GetSolutionStart();
-		  ObjArray* nodeArray = NULL;
-		  BStruct* nextStep = NULL;
+		// critical scripts and scripts run to completion can't sleep
+		if ( Plib::systemstate.config.pathfinding_threads && uoexec.scheduled && !uoexec.os_module->critical &&
+			 realm->has_threadsafe_mapserver() )
+		  return background_findpath( uoexec, req );
 
-		  nodeArray = new ObjArray();
-		  while ( ( node = astarsearch->GetSolutionNext() ) != NULL )
-		  {
-			nextStep = new BStruct;
-			nextStep->addMember( "x", new BLong( node->x ) );
-			nextStep->addMember( "y", new BLong( node->y ) );
-			nextStep->addMember( "z", new BLong( node->z ) );
-			nodeArray->addElement( nextStep );
-		  }
-		  astarsearch->FreeSolutionNodes();
-		  delete astarsearch;
-		  return nodeArray;
-		}
-		else if ( SearchState == UOSearch::SEARCH_STATE_FAILED )
-		{
-		  delete astarsearch;
-		  return new BError( "Failed to find a path." );
-		}
-		else if ( SearchState == UOSearch::SEARCH_STATE_OUT_OF_MEMORY )
-		{
-		  delete astarsearch;
-		  return new BError( "Out of memory." );
-		}
-		else if ( SearchState == UOSearch::SEARCH_STATE_SOLUTION_CORRUPTED )
-		{
-		  delete astarsearch;
-		  return new BError( "Solution Corrupted!" );
-		}
+		// only used by scripts, which run under the world lock; keeps its memory between calls
+		static PathFinder pathfinder;
+		std::vector<PathStep> path;
+		PathFinder::Result result = pathfinder.find( req, path );
+
+		if ( Plib::systemstate.config.loglevel >= 12 )
+          POLLOG.Format( "[FindPath]   expanded {} of {} nodes\n" ) << pathfinder.expanded_nodes() << pathfinder.visited_nodes();
 
-		delete astarsearch;
-		return new BError( "Pathfind Error." );
+		return findpath_result( result, path );
 	  }
 	  else
 	  {
@@ -1632,6 +1632,10 @@ namespace Pol {
 	  {
 		add_script( arr, *itr, "Running" );
 	  }
+	  for ( ExecList::iterator itr = scriptEngineInternalManager.interactive_runlist.begin(); itr != scriptEngineInternalManager.interactive_runlist.end(); ++itr )
+	  {
+		add_script( arr, *itr, "Running" );
+	  }
 	  return arr;
 	}
 
@@ -1646,6 +1650,10 @@ namespace Pol {
 	  {
 		add_script( arr, *itr, "Running" );
 	  }
+	  for ( ExecList::iterator itr = scriptEngineInternalManager.interactive_runlist.begin(); itr != scriptEngineInternalManager.interactive_runlist.end(); ++itr )
+	  {
+		add_script( arr, *itr, "Running" );
+	  }
 	  for ( HoldList::iterator itr = scriptEngineInternalManager.holdlist.begin(); itr != scriptEngineInternalManager.holdlist.end(); ++itr )
 	  {
 		add_script( arr, ( *itr ).second, "Sleeping" );
@@ -1683,6 +1691,8 @@ namespace Pol {
 		elem->addMember( "invocations", new BLong( eprog->invocations ) );
 		u64 cycles_per_invoc = eprog->instr_cycles / ( eprog->invocations ? eprog->invocations : 1 );
 		elem->addMember( "instr_per_invoc", new Double( static_cast<double>( cycles_per_invoc ) ) );
+		u64 startup_per_invoc = eprog->startup_ns / ( eprog->invocations ? eprog->invocations : 1 );
+		elem->addMember( "startup_ns_per_invoc", new Double( static_cast<double>( startup_per_invoc ) ) );
         double cycle_percent = total_instr != 0 ?
 		  (static_cast<double>(eprog->instr_cycles) / total_instr * 100.0)
 		  : 0;
@@ -1772,7 +1782,7 @@ namespace Pol {
       {
 		FLEXLOG( log ) << "Time ;ProcessSize ;RealmSize ;PacketSize ;Misc ;ScriptCount ;ScriptSize ;ScriptStoreCount ;ScriptStoreSize ;ObjCount ;ObjSize ;AccountCount ;AccountSize ;ClientCount ;ClientSize ;"
           << "ObjItemCount ;ObjItemSize ;ObjContCount ;ObjContSize ;ObjCharCount ;ObjCharSize ;ObjNpcCount ;ObjNpcSize ;ObjWeaponCount ;ObjWeaponSize ; ObjArmorCount ;ObjArmorSize ;ObjMultiCount ;ObjMultiSize ;"
-          << "ConfigCount ;ConfigSize ;ItemdescCount ;ItemdescSize";
+          << "ConfigCount ;ConfigSize ;ItemdescCount ;ItemdescSize ;DynPropObjCount ;DynPropCount ;DynPropSize";
 #ifdef DEBUG_FLYWEIGHT
         for ( int i = 0; i < boost_utils::debug_flyweight_queries.size(); ++i )
           FLEXLOG( log ) << " ;FlyWeightBucket" << i << "Count ;FlyWeightBucket"<<i<<"Size";
@@ -1792,8 +1802,8 @@ namespace Pol {
 
       
       ObjectHash::OH_const_iterator hs_citr = objStorageManager.objecthash.begin(), hs_cend = objStorageManager.objecthash.end();
-      size_t objsize = 0;
-      size_t objcount = std::distance( hs_citr, hs_cend );
+      size_t objsize = objStorageManager.objecthash.sizeEstimate();
+      size_t objcount = objStorageManager.objecthash.size();
 
       size_t obj_item_size = 0;
       size_t obj_cont_size = 0;
@@ -1809,13 +1819,22 @@ namespace Pol {
       size_t obj_weapon_count = 0;
       size_t obj_armor_count = 0;
       size_t obj_multi_count = 0;
+      // members stored in DynProps, included in the sizes above
+      size_t dynprop_obj_count = 0;
+      size_t dynprop_count = 0;
+      size_t dynprop_size = 0;
 
       for ( ; hs_citr != hs_cend; ++hs_citr )
       {
-        size_t size = ( sizeof(void*)* 3 + 1 ) / 2;
-        const UObjectRef& ref = ( *hs_citr ).second;
-        size += ref->estimatedSize();
+        const UObjectRef& ref = *hs_citr;
+        size_t size = ref->estimatedSize();
         objsize += size;
+        if ( ref->dynprops().size() )
+        {
+          ++dynprop_obj_count;
+          dynprop_count += ref->dynprops().size();
+          dynprop_size += ref->dynprops().estimatedSize() - sizeof( DynProps );
+        }
         if ( ref->isa( UObject::CLASS_ITEM ) )
         {
           obj_item_size += size;
@@ -1877,7 +1896,8 @@ namespace Pol {
       size_t itemdescsize = Items::itemdescSizeEstimate( &itemdesccount );
 
 	  size_t miscsize = Core::gamestate.global_properties->estimatedSize()
-		+ Core::Menu::estimateMenuSize();
+		+ Core::Menu::estimateMenuSize()
+		+ Core::networkManager.tooltip_cache->estimateSize();
 
 
 	  FLEXLOG( log ) << GET_LOG_FILESTAMP << ";"
@@ -1898,7 +1918,8 @@ namespace Pol {
         << obj_armor_count << " ;" << obj_armor_size << " ;"
         << obj_multi_count << " ;" << obj_multi_size << " ;"
         << configcount << " ;" << configsize << " ;"
-        << itemdesccount << " ;" << itemdescsize;
+        << itemdesccount << " ;" << itemdescsize << " ;"
+        << dynprop_obj_count << " ;" << dynprop_count << " ;" << dynprop_size;
 
 #ifdef DEBUG_FLYWEIGHT
       for ( const auto& ptr : boost_utils::debug_flyweight_queries )
@@ -1922,6 +1943,8 @@ namespace Pol {
 
 	  if ( stricmp( corevar, "bytes_sent" ) == 0 ) return new Double( static_cast<double>( networkManager.polstats.bytes_sent ) );
 	  if ( stricmp( corevar, "bytes_received" ) == 0 ) return new Double( static_cast<double>( networkManager.polstats.bytes_received ) );
+	  if ( stricmp( corevar, "packets_sent" ) == 0 ) return new Double( static_cast<double>( networkManager.polstats.packets_sent ) );
+	  if ( stricmp( corevar, "send_calls" ) == 0 ) return new Double( static_cast<double>( networkManager.polstats.send_calls ) );
 
 	  LONG_COREVAR( uptime, polclock() / POLCLOCKS_PER_SEC );
 	  LONG_COREVAR( sysload, stateManager.profilevars.last_sysload );
@@ -1941,6 +1964,7 @@ namespace Pol {
 
 	  LONG_COREVAR( scripts_late_per_min, GET_PROFILEVAR_PER_MIN( scripts_late ) );
 	  LONG_COREVAR( scripts_ontime_per_min, GET_PROFILEVAR_PER_MIN( scripts_ontime ) );
+	  LONG_COREVAR( script_passes_timelimit_per_min, GET_PROFILEVAR_PER_MIN( script_passes_timelimit ) );
 
 	  LONG_COREVAR( instr_per_min, stateManager.profilevars.last_sipm );
 	  LONG_COREVAR( priority_divide, scriptEngineInternalManager.priority_divide );
@@ -4,6 +4,7 @@ History
 2009/07/23 MuadDib:   updates for new Enum::Packet Out ID
 2009/09/03 MuadDib:   Relocation of multi related cpp/h
 2010/01/22 Turley:    Speedhack Prevention System
+2026/10/17 agent:     mobiles are created by the known objects of the client instead of lastx/lasty
 
 Notes
 =======
@@ -16,6 +17,7 @@ Notes
 #include "multi/house.h"
 #include "multi/multi.h"
 
+#include "network/cgdata.h"
 #include "network/client.h"
 #include "network/msghandl.h"
 #include "network/packets.h"
@@ -39,8 +41,9 @@ namespace Pol {
 
 	void send_char_if_newly_inrange( Mobile::Character *chr, Network::Client *client )
 	{
-	  if ( inrange( chr, client->chr ) && !inrange( chr->x, chr->y, client->chr->lastx, client->chr->lasty ) &&
-		   client->chr->is_visible_to_me( chr ) && client->chr != chr )
+	  if ( inrange( chr, client->chr ) && client->chr != chr &&
+		   client->gd->known_objects.find( chr->serial_ext ) == NULL &&
+		   client->chr->is_visible_to_me( chr ) )
 	  {
 		send_owncreate( client, chr );
 	  }
@@ -68,6 +71,7 @@ namespace Pol {
     void send_objects_newly_inrange( Network::Client* client )
 	{
       Mobile::Character* chr = client->chr;
+      client->gd->known_objects.forget_outside( chr->x, chr->y, RANGE_VISUAL );
 
       WorldIterator<MobileFilter>::InVisualRange( chr, [&]( Mobile::Character* zonechr )
       {
@@ -86,6 +90,7 @@ namespace Pol {
 	void send_objects_newly_inrange_on_boat( Network::Client* client, u32 serial )
 	{
 		Mobile::Character* chr = client->chr;
+		client->gd->known_objects.forget_outside( chr->x, chr->y, RANGE_VISUAL );
 
 		if ( client->ClientType & Network::CLIENTTYPE_7090 )
 		{
@@ -5,6 +5,7 @@ History
 2005/09/26 Shinigami: wrong styled break condition in ::Compress
 2009/09/03 MuadDib:   Relocation of multi related cpp/h
 2009/12/02 Turley:    added config.max_tile_id - Tomi
+2026/10/17 agent:     Compress writes straight into the packet, stored 0xD8 packets follow the revision
 
 
 Notes
@@ -293,17 +294,14 @@ namespace Pol {
 	  }
 	}
 
-	//caller must delete, assume type 0
-	unsigned char* CustomHouseDesign::Compress( int floor, u32* uncompr_length, u32* compr_length )
+	// assume type 0, compresses into dest which has room for *compr_length bytes,
+	// uncompressed is only scratch space so that it can be reused for all floors
+	bool CustomHouseDesign::Compress( int floor, std::vector<u8>& uncompressed, unsigned char* dest, u32* uncompr_length, u32* compr_length )
 	{
 	  int numtiles = floor_sizes[floor];
 	  int nextindex = 0;
 	  unsigned int ubuflen = numtiles*BYTES_PER_TILE;
-	  unsigned long cbuflen = ( ( (unsigned long)( ( (float)( ubuflen ) )*1.001f ) ) + 12 );//as per zlib spec
-	  unsigned char* uncompressed = new unsigned char[ubuflen];
-	  memset( uncompressed, 0, ubuflen );
-	  unsigned char* compressed = new unsigned char[cbuflen];
-	  memset( compressed, 0, cbuflen );
+	  uncompressed.assign( ubuflen, 0 );
 
 	  int i = 0;
 	  for ( HouseFloor::const_iterator xitr = Elements[floor].data.begin(),
@@ -336,24 +334,27 @@ namespace Pol {
 	  }
 	  *uncompr_length = nextindex;
 
-	  int ret = compress2( compressed, &cbuflen, uncompressed, nextindex, Z_DEFAULT_COMPRESSION );
+	  uLongf cbuflen = *compr_length;
+	  int ret = compress2( dest, &cbuflen, uncompressed.empty() ? NULL : &uncompressed[0], nextindex, Z_DEFAULT_COMPRESSION );
 	  if ( ret == Z_OK )
 	  {
-		delete[] uncompressed;
-		*compr_length = cbuflen;
-		return compressed;
+		*compr_length = static_cast<u32>( cbuflen );
+		return true;
 	  }
 	  else
 	  {
 		*uncompr_length = 0;
 		*compr_length = 0;
-		delete[] compressed;
-		if ( ubuflen > 0 )
-		  delete[] uncompressed;
-		return NULL;
+		return false;
 	  }
 	}
 
+	// room Compress() needs for floor
+	u32 CustomHouseDesign::CompressBound( int floor ) const
+	{
+	  return static_cast<u32>( compressBound( floor_sizes[floor] * BYTES_PER_TILE ) );
+	}
+
 	bool CustomHouseDesign::IsEmpty() const
 	{
 	  int total = 0;
@@ -919,62 +920,59 @@ namespace Pol {
 	  house->revision++;
 	}
 
+	// The stored packet is dropped whenever its design changes. If only the revision moved on
+	// (editing the other design) the stored packet is restamped instead of compressed again.
 	void CustomHousesSendFull( UHouse* house, Network::Client* client, int design )
 	{
-	  u32 clen;
-	  u32 ulen;
-	  unsigned char* data;
-	  //unsigned char** stored_packet;
-      std::vector<u8>* stored_packet;
-
-	  u32 planeheader = 0;
-	  u32 buffer_len = 0;
+	  std::vector<u8>* stored_packet;
 	  CustomHouseDesign* pdesign;
-	  const unsigned int data_offset = 17;
-	  const u32 mode = 0; //we only know how to do mode 0 at this point.
 
 	  //choose between sending working or current designs
 	  switch ( design )
 	  {
 		case HOUSE_DESIGN_CURRENT:
-		  if ( house->CurrentCompressed.empty() ) //no design stored, create below
-		  {
-			pdesign = &house->CurrentDesign;
-			stored_packet = &house->CurrentCompressed;
-		  }
-		  else //send stored packet
-		  {
-			Core::networkManager.clientTransmit->AddToQueue( client, &house->CurrentCompressed[0], ctBEu16( *( reinterpret_cast<u16*>( &house->CurrentCompressed[1] ) ) ) );
-			return;
-		  }
+		  pdesign = &house->CurrentDesign;
+		  stored_packet = &house->CurrentCompressed;
 		  break;
 		case HOUSE_DESIGN_WORKING:
-		  if ( house->WorkingCompressed.empty() ) //no design stored, create below
-		  {
-			pdesign = &house->WorkingDesign;
-			stored_packet = &house->WorkingCompressed;
-		  }
-		  else //send stored packet
-		  {
-			Core::networkManager.clientTransmit->AddToQueue( client, &house->WorkingCompressed[0], ctBEu16( *( reinterpret_cast<u16*>( &house->WorkingCompressed[1] ) ) ) );
-			return;
-		  }
+		  pdesign = &house->WorkingDesign;
+		  stored_packet = &house->WorkingCompressed;
 		  break;
 		default: return;
 	  }
 
-	  //create compressed house message
+	  if ( stored_packet->empty() ) //no design stored, create it
+	  {
+		if ( !CustomHousesBuildFull( house, pdesign, stored_packet ) )
+		  return;
+	  }
+	  else
+	  {
+		Core::PKTOUT_D8* msg = reinterpret_cast<Core::PKTOUT_D8*>( &( *stored_packet )[0] );
+		msg->revision = ctBEu32( house->revision );
+	  }
+	  Core::networkManager.clientTransmit->AddToQueue( client, &( *stored_packet )[0], static_cast<int>( stored_packet->size() ) );
+	}
 
-	  unsigned char planes = pdesign->NumUsedPlanes();
-	  unsigned long sbuflen = ( (unsigned long)( ( (float)( pdesign->TotalSize()*BYTES_PER_TILE ) )*1.001f ) + 12 );
-	  sbuflen += planes*BYTES_PER_TILE; //for plane header dword
-	  sbuflen += 17; //for packet header
+	// builds the compressed house message for pdesign into packet
+	bool CustomHousesBuildFull( UHouse* house, CustomHouseDesign* pdesign, std::vector<u8>* packet )
+	{
+	  u32 clen;
+	  u32 ulen;
+	  u32 planeheader = 0;
+	  u32 buffer_len = 0;
+	  const unsigned int data_offset = 17;
+	  const u32 mode = 0; //we only know how to do mode 0 at this point.
 
-      std::vector<u8> packet(sbuflen);
+	  unsigned char planes = pdesign->NumUsedPlanes();
+	  unsigned long sbuflen = data_offset + 1; //packet header and plane count
+	  for ( int i = 0; i < planes; i++ )
+		sbuflen += 4 + pdesign->CompressBound( i ); //plane header dword and data
 
+	  packet->assign( sbuflen, 0 );
 
-      Core::PKTOUT_D8* msg = reinterpret_cast<Core::PKTOUT_D8*>( &packet[0] );
-      msg->msgtype = Core::PKTOUT_D8_ID;
+	  Core::PKTOUT_D8* msg = reinterpret_cast<Core::PKTOUT_D8*>( &( *packet )[0] );
+	  msg->msgtype = Core::PKTOUT_D8_ID;
 	  msg->compressiontype = 0x3;
 	  msg->unk = 0;
 	  msg->serial = house->serial_ext;
@@ -983,13 +981,15 @@ namespace Pol {
 
 	  msg->buffer->planecount = planes;
 	  buffer_len = 1;
+	  std::vector<u8> uncompressed;
 	  for ( int i = 0; i < planes; i++ )
 	  {
 		planeheader = 0;
-		data = pdesign->Compress( i, &ulen, &clen );
-		if ( data == NULL ) //compression error
+		clen = static_cast<u32>( sbuflen - ( buffer_len + data_offset + 4 ) );
+		if ( !pdesign->Compress( i, uncompressed, &( ( *packet )[buffer_len + data_offset + 4] ), &ulen, &clen ) ) //compression error
 		{
-		  return;
+		  packet->clear();
+		  return false;
 		}
 		if ( ulen == 0 )
 		  clen = 0;
@@ -998,18 +998,15 @@ namespace Pol {
 		planeheader |= ( ( ulen & 0xFF ) << 16 );
 		planeheader |= ( ( clen & 0xFF ) << 8 );
 		planeheader |= ( ( ( ulen >> 4 ) & 0xF0 ) | ( ( clen >> 8 ) & 0xF ) );
-		u32* p_planeheader = reinterpret_cast<u32*>( &( packet[buffer_len + data_offset] ) );
+		u32* p_planeheader = reinterpret_cast<u32*>( &( ( *packet )[buffer_len + data_offset] ) );
 		*p_planeheader = ctBEu32( planeheader );
 		buffer_len += 4;
-		memcpy( &( packet[buffer_len + data_offset] ), data, clen );
 		buffer_len += clen;
-		delete[] data;
 	  }
-	  msg->msglen = ctBEu16( static_cast<u16>(buffer_len)+data_offset );
+	  msg->msglen = ctBEu16( static_cast<u16>( buffer_len ) + data_offset );
 	  msg->planebuffer_len = ctBEu16( static_cast<u16>( buffer_len ) );
-
-	  Core::networkManager.clientTransmit->AddToQueue( client, &packet[0], cfBEu16( msg->msglen ) );
-	  stored_packet->swap( packet );
+	  packet->resize( buffer_len + data_offset );
+	  return true;
 	}
 
 	void CustomHousesSendFullToInRange( UHouse* house, int design, int range )
@@ -2,6 +2,7 @@
 History
 =======
 2009/09/03 MuadDib:   Relocation of multi related cpp/h
+2026/10/17 agent:     Compress() into a given buffer, added CustomHousesBuildFull()
 
 
 Notes
@@ -114,7 +115,8 @@ namespace Pol {
 	  void Clear();
 	  bool IsEmpty() const;
 
-	  unsigned char* Compress( int floor, u32* uncompr_length, u32* compr_length );
+	  bool Compress( int floor, std::vector<u8>& uncompressed, unsigned char* dest, u32* uncompr_length, u32* compr_length );
+	  u32 CompressBound( int floor ) const;
 
 	  unsigned int TotalSize() const;
 	  unsigned char NumUsedPlanes() const;
@@ -167,6 +169,7 @@ namespace Pol {
 	void CustomHousesRoofSelect( Core::PKTBI_D7* msg );
 	void CustomHousesRoofRemove( Core::PKTBI_D7* msg );
 	void CustomHousesSendFull( UHouse* house, Network::Client* client, int design = HOUSE_DESIGN_CURRENT );
+	bool CustomHousesBuildFull( UHouse* house, CustomHouseDesign* pdesign, std::vector<u8>* packet );
 	void CustomHousesSendFullToInRange( UHouse* house, int design, int range );
 	void CustomHousesSendShort( UHouse* house, Network::Client* client );
 	void CustomHouseStopEditing( Mobile::Character* chr, UHouse* house );
@@ -8,6 +8,7 @@ History
 2009/09/15 MuadDib:   Better cleanup handling on house destroy. Alos clears registered_house off character.
                       Houses now only allow mobiles to be registered. May add items later for other storage.
 2012/02/02 Tomi:      Added boat member MBR_MULTIID
+2026/10/17 agent:     EraseHousePart raises the design revision like AddHousePart
 
 Notes
 =======
@@ -349,6 +350,7 @@ namespace Pol {
 			  WorkingCompressed.swap( newvec );
               std::vector<u8> newvec2;
 			  CurrentCompressed.swap( newvec2 );
+			  revision++;
 			  CustomHousesSendFullToInRange( this, HOUSE_DESIGN_CURRENT, RANGE_VISUAL_LARGE_BUILDINGS );
 			}
 			return new BLong( ret ? 1 : 0 );
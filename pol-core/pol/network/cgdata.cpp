@@ -23,6 +23,7 @@ Notes
 #include "../module/unimod.h"
 #include "../module/uomod.h"
 #include "../uoexec.h"
+#include "../uobject.h"
 
 #include <vector>
 
@@ -44,7 +45,8 @@ namespace Pol {
 	  // light_region(NULL),
 	  music_region( NULL ),
 	  weather_region( NULL ),
-	  custom_house_serial( 0 )
+	  custom_house_serial( 0 ),
+	  known_objects()
 	{}
 
 	ClientGameData::~ClientGameData()
@@ -132,6 +134,7 @@ namespace Pol {
 		custom_house_serial = 0;
 	  }
 
+	  known_objects.clear();
 	}
 
 	void ClientGameData::add_gumpmod( Module::UOExecutorModule* uoemod )
@@ -159,7 +162,50 @@ namespace Pol {
     {
       size_t size = sizeof( ClientGameData );
       size += 3 * sizeof(void*)+gumpmods.size( ) * ( sizeof( Module::UOExecutorModule* ) + 3 * sizeof( void* ) );
+      size += known_objects.estimatedSize();
       return size;
     }
+
+	const KnownObjects::Entry* KnownObjects::find( u32 serial_ext ) const
+	{
+	  auto itr = _objects.find( serial_ext );
+	  if ( itr == _objects.end() )
+		return NULL;
+	  return &itr->second;
+	}
+
+	void KnownObjects::sent( const Core::UObject* obj )
+	{
+	  Entry& entry = _objects[obj->serial_ext];
+	  entry.x = obj->x;
+	  entry.y = obj->y;
+	  entry.rev = obj->rev();
+	}
+
+	void KnownObjects::forget( u32 serial_ext )
+	{
+	  _objects.erase( serial_ext );
+	}
+
+	void KnownObjects::forget_outside( u16 x, u16 y, int range )
+	{
+	  for ( auto itr = _objects.begin(); itr != _objects.end(); )
+	  {
+		if ( abs( itr->second.x - x ) > range || abs( itr->second.y - y ) > range )
+		  itr = _objects.erase( itr );
+		else
+		  ++itr;
+	  }
+	}
+
+	void KnownObjects::clear()
+	{
+	  _objects.clear();
+	}
+
+	size_t KnownObjects::estimatedSize() const
+	{
+	  return _objects.size() * ( sizeof( std::pair<u32, Entry> ) + 2 * sizeof( void* ) );
+	}
   }
 }
\ No newline at end of file
@@ -17,6 +17,7 @@ Notes
 
 #include <cstddef>
 #include <set>
+#include <unordered_map>
 
 namespace Pol {
   namespace Module {
@@ -29,9 +30,35 @@ namespace Pol {
 	class MusicRegion;
 	class WeatherRegion;
     class UContainer;
+	class UObject;
   }
   namespace Network {
 
+	// The mobiles a client was sent with a create (0x78) and not told to remove since,
+	// by serial_ext, with their position and revision at the last create or move.
+	// The client drops objects which get out of its range by itself, the owner calls
+	// forget_outside whenever the client moved.
+	class KnownObjects
+	{
+	public:
+	  struct Entry
+	  {
+		u16 x;
+		u16 y;
+		u32 rev;
+	  };
+
+	  const Entry* find( u32 serial_ext ) const;
+	  void sent( const Core::UObject* obj );
+	  void forget( u32 serial_ext );
+	  void forget_outside( u16 x, u16 y, int range );
+	  void clear();
+	  size_t estimatedSize() const;
+
+	private:
+	  std::unordered_map<u32, Entry> _objects;
+	};
+
 	class ClientGameData
 	{
 	public:
@@ -75,6 +102,8 @@ namespace Pol {
 	  Core::MusicRegion* music_region;
 	  Core::WeatherRegion* weather_region;
 	  u32 custom_house_serial;
+
+	  KnownObjects known_objects;
 	};
   }
 }
@@ -68,6 +68,11 @@ namespace Pol {
   namespace Network {
 	unsigned int Client::instance_counter_;
 	std::mutex Client::_SocketMutex;
+	bool Client::coalescing_ = false;
+	std::vector<Client*> Client::coalesce_clients_;
+
+	// packets of a transmit batch are collected up to this size before they are sent
+	const size_t COALESCE_BUFFER_SIZE = 16384;
 
 	Client::Client( ClientInterface& aInterface, Crypt::TCryptInfo& encryption ) :
 	  preDisconnect( 0 ),
@@ -94,6 +99,9 @@ namespace Pol {
 	  last_xmit_buffer( NULL ),
 	  n_queued( 0 ),
 	  queued_bytes_counter( 0 ),
+	  coalesce_buffer_(),
+	  coalesce_encrypt_( false ),
+	  coalesce_pending_( false ),
 	  gd( new ClientGameData ),
 	  instance_( ++instance_counter_ ),
 	  checkpoint( -1 ), //CNXBUG
@@ -124,6 +132,11 @@ namespace Pol {
 	void Client::Delete( Client* client )
 	{
 	  std::lock_guard<std::mutex> lock( _SocketMutex );
+	  if ( client->coalesce_pending_ )
+	  {
+		coalesce_clients_.erase( std::find( coalesce_clients_.begin(), coalesce_clients_.end(), client ) );
+		client->coalesce_pending_ = false;
+	  }
 	  client->PreDelete();
 	  delete client->cryptengine;
 	  client->cryptengine = NULL;
@@ -217,6 +230,16 @@ namespace Pol {
 	}
 
 	// ClientInfo - delivers a lot of usefull infomation about client PC
+	Bscript::BStruct* Client::gettransmitstats() const
+	{
+	  using namespace Bscript;
+	  std::unique_ptr<BStruct> ret( new BStruct );
+	  ret->addMember( "bytes_sent", new BLong( counters.bytes_transmitted ) );
+	  ret->addMember( "packets_sent", new BLong( counters.packets_transmitted ) );
+	  ret->addMember( "send_calls", new BLong( counters.send_calls ) );
+	  return ret.release();
+	}
+
 	Bscript::BStruct* Client::getclientinfo() const
 	{
       using namespace Bscript;
@@ -458,12 +481,44 @@ namespace Pol {
 	{
 	  if ( csocket == INVALID_SOCKET )
 		return;
+	  ++counters.packets_transmitted;
+	  ++Core::networkManager.polstats.packets_sent;
+	  if ( coalescing_ && !last_xmit_buffer && datalen <= COALESCE_BUFFER_SIZE )
+	  {
+		if ( coalesce_buffer_.size() + datalen > COALESCE_BUFFER_SIZE ||
+			 ( !coalesce_buffer_.empty() && coalesce_encrypt_ != encrypt_server_stream ) )
+		  flush_coalesced();
+		if ( !last_xmit_buffer )
+		{
+		  if ( coalesce_buffer_.empty() )
+		  {
+			coalesce_buffer_.reserve( COALESCE_BUFFER_SIZE );
+			coalesce_encrypt_ = encrypt_server_stream;
+		  }
+		  const unsigned char *cdata = (const unsigned char *)data;
+		  coalesce_buffer_.insert( coalesce_buffer_.end(), cdata, cdata + datalen );
+		  if ( !coalesce_pending_ )
+		  {
+			coalesce_pending_ = true;
+			coalesce_clients_.push_back( this );
+		  }
+		  return;
+		}
+	  }
+	  // keep the order of the stream
+	  flush_coalesced();
 	  if ( encrypt_server_stream )
 	  {
 		if ( cryptengine == NULL )
 		  return;
 		this->cryptengine->Encrypt( (void *)data, (void *)data, datalen );
 	  }
+	  xmit_raw( data, datalen );
+	}
+
+	// sends already encrypted data, or queues it if the socket would block
+	void Client::xmit_raw( const void *data, unsigned short datalen )
+	{
 	  THREAD_CHECKPOINT( active_client, 200 );
 	  if ( last_xmit_buffer ) // this client already backlogged, schedule for later
 	  {
@@ -478,6 +533,8 @@ namespace Pol {
 	  const unsigned char *cdata = (const unsigned char *)data;
 	  int nsent;
 
+	  ++counters.send_calls;
+	  ++Core::networkManager.polstats.send_calls;
 	  if ( -1 == ( nsent = send( csocket, (const char *)cdata, datalen, 0 ) ) )
 	  {
 		THREAD_CHECKPOINT( active_client, 204 );
@@ -529,6 +586,8 @@ namespace Pol {
 	  while ( NULL != ( xbuffer = first_xmit_buffer ) )
 	  {
 		int nsent;
+		++counters.send_calls;
+		++Core::networkManager.polstats.send_calls;
 		nsent = send( csocket,
 					  (char *)&xbuffer->data[xbuffer->nsent],
 					  xbuffer->lenleft,
@@ -575,6 +634,40 @@ namespace Pol {
 	  }
 	}
 
+	// sends the packets collected during coalescing as one block, needs _SocketMutex
+	void Client::flush_coalesced()
+	{
+	  if ( coalesce_buffer_.empty() )
+		return;
+	  if ( csocket != INVALID_SOCKET && ( !coalesce_encrypt_ || cryptengine != NULL ) )
+	  {
+		unsigned char* data = &coalesce_buffer_[0];
+		unsigned short datalen = static_cast<unsigned short>( coalesce_buffer_.size() );
+		if ( coalesce_encrypt_ )
+		  cryptengine->Encrypt( data, data, datalen );
+		xmit_raw( data, datalen );
+	  }
+	  coalesce_buffer_.clear();
+	}
+
+	void Client::begin_coalescing()
+	{
+	  std::lock_guard<std::mutex> lock( _SocketMutex );
+	  coalescing_ = true;
+	}
+
+	void Client::end_coalescing()
+	{
+	  std::lock_guard<std::mutex> lock( _SocketMutex );
+	  coalescing_ = false;
+	  for ( Client* client : coalesce_clients_ )
+	  {
+		client->coalesce_pending_ = false;
+		client->flush_coalesced();
+	  }
+	  coalesce_clients_.clear();
+	}
+
 	// 33 01 "encrypted": 4F FA
 	static const unsigned char pause_pre_encrypted[2] = { 0x4F, 0xFA };
 	// 33 00 "encrypted": 4C D0
@@ -680,7 +773,7 @@ namespace Pol {
     size_t Client::estimatedSize() const
     {
       size_t size = sizeof(Client)
-        +fpLog.capacity() + version_.capacity();
+        +fpLog.capacity() + version_.capacity() + coalesce_buffer_.capacity();
       Core::XmitBuffer* buffer_size = first_xmit_buffer;
       while ( buffer_size != nullptr )
       {
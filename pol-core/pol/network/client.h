@@ -38,6 +38,7 @@ Notes
 #include <cstring>
 #include <mutex>
 #include <queue>
+#include <vector>
 
 namespace Pol {
   namespace Bscript {
@@ -162,6 +163,7 @@ namespace Pol {
 
 	  void setclientinfo( const Core::PKTIN_D9 *msg ) { memcpy( &clientinfo_, msg, sizeof( clientinfo_ ) ); }
 	  Bscript::BStruct* getclientinfo() const;
+	  Bscript::BStruct* gettransmitstats() const;
 
 	  Accounts::Account* acct;
 	  Mobile::Character* chr;
@@ -174,6 +176,11 @@ namespace Pol {
 	  bool have_queued_data() const;
 	  void send_queued_data();
 
+	  // While coalescing (see ClientTransmitThread) outgoing packets are collected per client
+	  // and sent with a single send() by end_coalescing().
+	  static void begin_coalescing();
+	  static void end_coalescing();
+
 	  SOCKET csocket;		// socket to client ACK  - requires header inclusion.
 	  static std::mutex _SocketMutex;
 	  unsigned short listen_port;
@@ -231,6 +238,14 @@ namespace Pol {
 	  void queue_data( const void *data, unsigned short datalen );
 	  void transmit_encrypted( const void *data, int len );
 	  void xmit( const void *data, unsigned short datalen );
+	  void xmit_raw( const void *data, unsigned short datalen );
+	  void flush_coalesced();
+
+	  std::vector<unsigned char> coalesce_buffer_;
+	  bool coalesce_encrypt_; // encrypt_server_stream at the time the buffer was filled
+	  bool coalesce_pending_; // listed in coalesce_clients_
+	  static bool coalescing_;
+	  static std::vector<Client*> coalesce_clients_;
 
 	public:
 	  ClientGameData* gd;
@@ -251,6 +266,8 @@ namespace Pol {
 	  {
 		unsigned int bytes_transmitted;
 		unsigned int bytes_received;
+		unsigned int packets_transmitted;
+		unsigned int send_calls;
 	  } counters;
 	  std::string version_;
 	  Core::PKTIN_D9 clientinfo_;
@@ -28,9 +28,20 @@
 #include "../../clib/fdump.h"
 #include "../../clib/logfacility.h"
 #include "../../clib/stlutil.h"
+#include "../../clib/strutil.h"
+
+#include "../../clib/threadhelp.h"
 
 #include "../../plib/systemstate.h"
 
+#ifdef __linux__
+#include <atomic>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#endif
+
 #define CLIENT_CHECKPOINT(x) client->checkpoint = x
 
 #ifdef _MSC_VER
@@ -157,36 +168,7 @@ namespace Pol
                     if (!client->movementqueue.empty()) // not empty then process the first packet
                     {
                         PolLock lck; //multithread
-                        Network::PacketThrottler pkt = client->movementqueue.front();
-                        if (client->SpeedHackPrevention(false))
-                        {
-                            if (client->isReallyConnected())
-                            {
-                                unsigned char msgtype = pkt.pktbuffer[0];
-                                Network::MSG_HANDLER packetHandler = Network::PacketRegistry::find_handler(msgtype, client);
-                                try
-                                {
-                                    INFO_PRINT_TRACE(10) << "Client#" << client->instance_ << ": message 0x" << fmt::hexu(msgtype) << "\n";
-                                    CLIENT_CHECKPOINT(26);
-                                    packetHandler.func(client, pkt.pktbuffer);
-                                    CLIENT_CHECKPOINT(27);
-                                    restart_all_clients();
-                                }
-                                catch (std::exception& ex)
-                                {
-                                    POLLOG_ERROR.Format("Client#{}: Exception in message handler 0x{:X}: {}\n")
-                                        << client->instance_
-                                        << (int)msgtype
-                                        << ex.what();
-                                    fmt::Writer tmp;
-                                    Clib::fdump(tmp, pkt.pktbuffer, 7);
-                                    POLLOG << tmp.c_str() << "\n";
-                                    restart_all_clients();
-                                    throw;
-                                }
-                            }
-                            client->movementqueue.pop();
-                        }
+                        process_movementqueue(client);
                     }
                     //endregion Speedhack
 
@@ -256,103 +238,36 @@ namespace Pol
 
             if (login && client->isConnected())
                 return true;
-            POLLOG.Format("Client#{} ({}): disconnected (account {})\n")
-                << client->instance_
-                << Network::AddressToString(&client->ipaddr)
-                << ((client->acct != NULL) ? client->acct->name() : "unknown");
-
-
-            try
+            polclock_t when_logoff = client_disconnected(client, last_activity);
+            CLIENT_CHECKPOINT(13);
+            while (!Clib::exit_signalled)
             {
-                //		if (1)
+                CLIENT_CHECKPOINT(14);
                 {
-                    CLIENT_CHECKPOINT(9);
                     PolLock lck;
-                    networkManager.clients.erase(std::find(networkManager.clients.begin(), networkManager.clients.end(), client));
-                    std::lock_guard<std::mutex> lock(client->_SocketMutex);
-                    client->closeConnection();
-                    INFO_PRINT << "Client disconnected from " << Network::AddressToString(&client->ipaddr)
-                        << " (" << networkManager.clients.size() << " connections)\n";
-
-                    CoreSetSysTrayToolTip(Clib::tostring(networkManager.clients.size()) + " clients connected", ToolTipPrioritySystem);
-                }
-
-                checkpoint = 8;
-                CLIENT_CHECKPOINT(10);
-                if (client->chr)
-                {
-                    //			if (1)
-                    int seconds_wait = 0;
-                    {
-                        CLIENT_CHECKPOINT(11);
-                        PolLock lck;
-
-                        client->chr->disconnect_cleanup();
-                        client->gd->clear();
-                        client->chr->connected = false;
-                        ScriptDef sd;
-                        sd.quickconfig("scripts/misc/logofftest.ecl");
-                        if (sd.exists())
-                        {
-                            CLIENT_CHECKPOINT(12);
-                            Bscript::BObject bobj(run_script_to_completion(sd, new Module::ECharacterRefObjImp(client->chr)));
-                            if (bobj.isa(Bscript::BObjectImp::OTLong))
-                            {
-                                const Bscript::BLong* blong = static_cast<const Bscript::BLong*>(bobj.impptr());
-                                seconds_wait = blong->value();
-                            }
-                        }
-                    }
-
-                    polclock_t when_logoff = last_activity + seconds_wait * POLCLOCKS_PER_SEC;
-
-                    checkpoint = 9;
-                    CLIENT_CHECKPOINT(13);
-                    while (!Clib::exit_signalled)
-                    {
-                        CLIENT_CHECKPOINT(14);
-                        {
-                            PolLock lck;
-                            if (polclock() >= when_logoff)
-                                break;
-                        }
-                        pol_sleep_ms(2000);
-                    }
-
-                    checkpoint = 10;
-                    CLIENT_CHECKPOINT(15);
-                    //			if (1)
-                    {
-                        PolLock lck;
-                        if (client->chr)
-                        {
-                            Mobile::Character* chr = client->chr;
-                            CLIENT_CHECKPOINT(16);
-                            call_chr_scripts(chr, "scripts/misc/logoff.ecl", "logoff.ecl");
-                            WorldIterator<NPCFilter>::InRange(chr->x, chr->y, chr->realm, 32, [&](Mobile::Character* zonechr) { Mobile::NpcPropagateLeftArea(zonechr, chr); });
-                        }
-                    }
+                    if (polclock() >= when_logoff)
+                        break;
                 }
+                pol_sleep_ms(2000);
             }
-            catch (std::exception& ex)
-            {
-                POLLOG.Format("Client#{}: Exception in i/o thread: {}! (checkpoint={}, what={})\n")
-                    << client->instance_ << checkpoint << ex.what();
-            }
-
-            //if (1)
-              {
-                  PolLock lck;
-                  CLIENT_CHECKPOINT(17);
-                  Network::Client::Delete(client);
-                  client = NULL;
-              }
-              return false;
+            client_logoff(client);
+            return false;
         }
 
-
         // bool - return true when a message was processed.
         bool process_data(Network::Client *client)
+        {
+            if (!receive_data(client))
+                return false;
+            PolLock lck; //multithread
+            dispatch_message(client);
+            return true;
+        }
+
+        // bool - return true when a complete message is in client->buffer.
+        // client->recv_state is already reset for the next message, the message has to be
+        // dispatched (or copied) before receive_data() is called again.
+        bool receive_data(Network::Client *client)
         {
             // NOTE: This is coded such that for normal messages, which are completely available,
             // this function will get the type, then the length, then the data, without having
@@ -447,61 +362,7 @@ namespace Pol
                     if (Plib::systemstate.config.verbose)
                         INFO_PRINT.Format("Message Received: Type 0x{:X}, Length {} bytes\n") << (int)msgtype << client->message_length;
 
-                    PolLock lck; //multithread
-                    // it can happen that a client gets disconnected while waiting for the lock.
-                    if (client->isConnected())
-                    {
-                        if (client->msgtype_filter->msgtype_allowed[msgtype])
-                        {
-                            //region Speedhack
-                            if ((settingsManager.ssopt.speedhack_prevention) && (msgtype == PKTIN_02_ID))
-                            {
-                                if (!client->SpeedHackPrevention())
-                                {
-                                    // client->SpeedHackPrevention() added packet to queue
-                                    client->recv_state = Network::Client::RECV_STATE_MSGTYPE_WAIT;
-                                    CLIENT_CHECKPOINT(28);
-                                    return true;
-                                }
-                            }
-                            //endregion Speedhack
-
-
-                            Network::MSG_HANDLER packetHandler = Network::PacketRegistry::find_handler(msgtype, client);
-                            passert(packetHandler.msglen != 0);
-
-                            try
-                            {
-                                INFO_PRINT_TRACE(10) << "Client#" << client->instance_ << ": message 0x" << fmt::hexu(msgtype) << "\n";
-                                CLIENT_CHECKPOINT(26);
-                                packetHandler.func(client, client->buffer);
-                                CLIENT_CHECKPOINT(27);
-                                restart_all_clients();
-                            }
-                            catch (std::exception& ex)
-                            {
-                                POLLOG_ERROR.Format("Client#{}: Exception in message handler 0x{:X}: {}\n")
-                                    << client->instance_
-                                    << (int)msgtype
-                                    << ex.what();
-                                fmt::Writer tmp;
-                                Clib::fdump(tmp, client->buffer, client->bytes_received);
-                                POLLOG << tmp.c_str() << "\n";
-                                restart_all_clients();
-                                throw;
-                            }
-                        }
-                        else
-                        {
-                            POLLOG_ERROR.Format("Client#{} ({}, Acct {}) sent non-allowed message type 0x{:X}.\n")
-                                << client->instance_
-                                << Network::AddressToString(&client->ipaddr)
-                                << (client->acct ? client->acct->name() : "unknown")
-                                << (int)msgtype;
-                        }
-                    }
                     client->recv_state = Network::Client::RECV_STATE_MSGTYPE_WAIT;
-                    CLIENT_CHECKPOINT(28);
                     return true;
                 }
                 // else keep waiting 
@@ -589,6 +450,544 @@ namespace Pol
             return false;
         }
 
+        // dispatches the message in client->buffer, needs the world lock.
+        void dispatch_message(Network::Client *client)
+        {
+            unsigned char msgtype = client->buffer[0];
+            // it can happen that a client gets disconnected while waiting for the lock.
+            if (client->isConnected())
+            {
+                if (client->msgtype_filter->msgtype_allowed[msgtype])
+                {
+                    //region Speedhack
+                    if ((settingsManager.ssopt.speedhack_prevention) && (msgtype == PKTIN_02_ID))
+                    {
+                        if (!client->SpeedHackPrevention())
+                        {
+                            // client->SpeedHackPrevention() added packet to queue
+                            CLIENT_CHECKPOINT(28);
+                            return;
+                        }
+                    }
+                    //endregion Speedhack
+
+
+                    Network::MSG_HANDLER packetHandler = Network::PacketRegistry::find_handler(msgtype, client);
+                    passert(packetHandler.msglen != 0);
+
+                    try
+                    {
+                        INFO_PRINT_TRACE(10) << "Client#" << client->instance_ << ": message 0x" << fmt::hexu(msgtype) << "\n";
+                        CLIENT_CHECKPOINT(26);
+                        packetHandler.func(client, client->buffer);
+                        CLIENT_CHECKPOINT(27);
+                        restart_all_clients();
+                    }
+                    catch (std::exception& ex)
+                    {
+                        POLLOG_ERROR.Format("Client#{}: Exception in message handler 0x{:X}: {}\n")
+                            << client->instance_
+                            << (int)msgtype
+                            << ex.what();
+                        fmt::Writer tmp;
+                        Clib::fdump(tmp, client->buffer, client->bytes_received);
+                        POLLOG << tmp.c_str() << "\n";
+                        restart_all_clients();
+                        throw;
+                    }
+                }
+                else
+                {
+                    POLLOG_ERROR.Format("Client#{} ({}, Acct {}) sent non-allowed message type 0x{:X}.\n")
+                        << client->instance_
+                        << Network::AddressToString(&client->ipaddr)
+                        << (client->acct ? client->acct->name() : "unknown")
+                        << (int)msgtype;
+                }
+            }
+            CLIENT_CHECKPOINT(28);
+        }
+
+        // processes the first queued movement packet, needs the world lock.
+        void process_movementqueue(Network::Client* client)
+        {
+            Network::PacketThrottler pkt = client->movementqueue.front();
+            if (client->SpeedHackPrevention(false))
+            {
+                if (client->isReallyConnected())
+                {
+                    unsigned char msgtype = pkt.pktbuffer[0];
+                    Network::MSG_HANDLER packetHandler = Network::PacketRegistry::find_handler(msgtype, client);
+                    try
+                    {
+                        INFO_PRINT_TRACE(10) << "Client#" << client->instance_ << ": message 0x" << fmt::hexu(msgtype) << "\n";
+                        CLIENT_CHECKPOINT(26);
+                        packetHandler.func(client, pkt.pktbuffer);
+                        CLIENT_CHECKPOINT(27);
+                        restart_all_clients();
+                    }
+                    catch (std::exception& ex)
+                    {
+                        POLLOG_ERROR.Format("Client#{}: Exception in message handler 0x{:X}: {}\n")
+                            << client->instance_
+                            << (int)msgtype
+                            << ex.what();
+                        fmt::Writer tmp;
+                        Clib::fdump(tmp, pkt.pktbuffer, 7);
+                        POLLOG << tmp.c_str() << "\n";
+                        restart_all_clients();
+                        throw;
+                    }
+                }
+                client->movementqueue.pop();
+            }
+        }
+
+        // first half of the disconnect handling: removes the client from the client list and
+        // runs logofftest.ecl. Returns the polclock at which client_logoff() should be called.
+        polclock_t client_disconnected(Network::Client* client, polclock_t last_activity)
+        {
+            POLLOG.Format("Client#{} ({}): disconnected (account {})\n")
+                << client->instance_
+                << Network::AddressToString(&client->ipaddr)
+                << ((client->acct != NULL) ? client->acct->name() : "unknown");
+
+            int seconds_wait = 0;
+            try
+            {
+                {
+                    CLIENT_CHECKPOINT(9);
+                    PolLock lck;
+                    networkManager.clients.erase(std::find(networkManager.clients.begin(), networkManager.clients.end(), client));
+                    std::lock_guard<std::mutex> lock(client->_SocketMutex);
+                    client->closeConnection();
+                    INFO_PRINT << "Client disconnected from " << Network::AddressToString(&client->ipaddr)
+                        << " (" << networkManager.clients.size() << " connections)\n";
+
+                    CoreSetSysTrayToolTip(Clib::tostring(networkManager.clients.size()) + " clients connected", ToolTipPrioritySystem);
+                }
+
+                CLIENT_CHECKPOINT(10);
+                if (client->chr)
+                {
+                    CLIENT_CHECKPOINT(11);
+                    PolLock lck;
+
+                    client->chr->disconnect_cleanup();
+                    client->gd->clear();
+                    client->chr->connected = false;
+                    ScriptDef sd;
+                    sd.quickconfig("scripts/misc/logofftest.ecl");
+                    if (sd.exists())
+                    {
+                        CLIENT_CHECKPOINT(12);
+                        Bscript::BObject bobj(run_script_to_completion(sd, new Module::ECharacterRefObjImp(client->chr)));
+                        if (bobj.isa(Bscript::BObjectImp::OTLong))
+                        {
+                            const Bscript::BLong* blong = static_cast<const Bscript::BLong*>(bobj.impptr());
+                            seconds_wait = blong->value();
+                        }
+                    }
+                }
+            }
+            catch (std::exception& ex)
+            {
+                POLLOG.Format("Client#{}: Exception in i/o thread: {}! (checkpoint={})\n")
+                    << client->instance_ << ex.what() << client->checkpoint;
+            }
+            return last_activity + seconds_wait * POLCLOCKS_PER_SEC;
+        }
+
+        // second half of the disconnect handling: runs logoff.ecl and deletes the client.
+        void client_logoff(Network::Client* client)
+        {
+            try
+            {
+                CLIENT_CHECKPOINT(15);
+                PolLock lck;
+                if (client->chr)
+                {
+                    Mobile::Character* chr = client->chr;
+                    CLIENT_CHECKPOINT(16);
+                    call_chr_scripts(chr, "scripts/misc/logoff.ecl", "logoff.ecl");
+                    WorldIterator<NPCFilter>::InRange(chr->x, chr->y, chr->realm, 32, [&](Mobile::Character* zonechr) { Mobile::NpcPropagateLeftArea(zonechr, chr); });
+                }
+            }
+            catch (std::exception& ex)
+            {
+                POLLOG.Format("Client#{}: Exception in i/o thread: {}! (checkpoint={})\n")
+                    << client->instance_ << ex.what() << client->checkpoint;
+            }
+
+            PolLock lck;
+            CLIENT_CHECKPOINT(17);
+            Network::Client::Delete(client);
+        }
+
+#ifdef __linux__
+        namespace
+        {
+            // per-client state the reactor keeps instead of the locals of client_io_thread
+            struct ReactorClient
+            {
+                Network::Client* client;
+                polclock_t last_activity;
+                polclock_t last_packet_at;
+                bool idle_warned;
+                bool want_write;
+            };
+
+            // a complete message read outside of the world lock, dispatched in the next pass
+            struct ReactorMessage
+            {
+                ReactorClient* rc;
+                std::vector<unsigned char> data;
+            };
+
+            struct ReactorLogoff
+            {
+                Network::Client* client;
+                polclock_t when_logoff;
+            };
+
+            // maximum number of messages read from one client per wakeup, so that a flooding
+            // client cannot starve the others served by the same reactor
+            const int REACTOR_MAX_MESSAGES = 16;
+            const int REACTOR_MAX_EVENTS = 256;
+
+            // Handlers of these messages change how the following bytes are decrypted or framed
+            // (crypt engine, ClientType which selects the packet lengths), so nothing behind them
+            // may be read before they are dispatched.
+            bool ends_read_ahead(unsigned char msgtype)
+            {
+                switch (msgtype)
+                {
+                case PKTIN_00_ID:
+                case PKTIN_5D_ID:
+                case PKTIN_80_ID:
+                case PKTIN_8D_ID:
+                case PKTIN_91_ID:
+                case PKTIN_A0_ID:
+                case PKTBI_BD_ID:
+                case PKTIN_E1_ID:
+                case PKTIN_EF_ID:
+                case PKTIN_F8_ID:
+                    return true;
+                default:
+                    return false;
+                }
+            }
+            const int REACTOR_TIMEOUT_MS = 100;
+
+            class ClientReactor
+            {
+            public:
+                ClientReactor() : _epfd(-1) {}
+                void start(unsigned index);
+                void add(Network::Client* client);
+                void run();
+
+            private:
+                void adopt_pending();
+                void read_client(ReactorClient* rc, std::vector<ReactorMessage>& batch);
+                void dispatch(std::vector<ReactorMessage>& batch);
+                void service_clients(std::vector<ReactorClient*>& disconnected);
+                void update_interest(ReactorClient* rc);
+
+                int _epfd;
+                std::mutex _pending_mutex;
+                std::vector<Network::Client*> _pending;
+                std::vector<ReactorClient*> _clients;
+                std::vector<ReactorLogoff> _logoffs;
+            };
+
+            std::vector<std::unique_ptr<ClientReactor>> reactors;
+            std::atomic<unsigned> next_reactor(0);
+
+            void client_reactor_thread(void* arg)
+            {
+                static_cast<ClientReactor*>(arg)->run();
+            }
+
+            void ClientReactor::start(unsigned index)
+            {
+                _epfd = epoll_create1(EPOLL_CLOEXEC);
+                if (_epfd < 0)
+                    throw std::runtime_error("Unable to create epoll instance, errno=" + Clib::decint(errno));
+                std::string threadname = "Network I/O " + Clib::tostring(index);
+                threadhelp::start_thread(client_reactor_thread, threadname.c_str(), this);
+            }
+
+            void ClientReactor::add(Network::Client* client)
+            {
+                std::lock_guard<std::mutex> lock(_pending_mutex);
+                _pending.push_back(client);
+            }
+
+            void ClientReactor::adopt_pending()
+            {
+                std::vector<Network::Client*> pending;
+                {
+                    std::lock_guard<std::mutex> lock(_pending_mutex);
+                    pending.swap(_pending);
+                }
+                for (Network::Client* client : pending)
+                {
+                    client->thread_pid = threadhelp::thread_pid();
+                    int flags = fcntl(client->csocket, F_GETFL, 0);
+                    fcntl(client->csocket, F_SETFL, flags | O_NONBLOCK);
+
+                    ReactorClient* rc = new ReactorClient;
+                    rc->client = client;
+                    rc->last_activity = rc->last_packet_at = polclock();
+                    rc->idle_warned = false;
+                    rc->want_write = false;
+
+                    struct epoll_event ev;
+                    ev.events = EPOLLIN;
+                    ev.data.ptr = rc;
+                    if (epoll_ctl(_epfd, EPOLL_CTL_ADD, client->csocket, &ev) < 0)
+                    {
+                        POLLOG_ERROR.Format("Client#{}: epoll_ctl failed, errno={}\n") << client->instance_ << errno;
+                        client->forceDisconnect();
+                    }
+                    _clients.push_back(rc);
+                }
+            }
+
+            void ClientReactor::read_client(ReactorClient* rc, std::vector<ReactorMessage>& batch)
+            {
+                Network::Client* client = rc->client;
+                for (int i = 0; i < REACTOR_MAX_MESSAGES && client->isReallyConnected(); ++i)
+                {
+                    // receive_data() treats an empty read of a new message as a disconnect,
+                    // only the first read is covered by the readiness of the socket
+                    if (i > 0)
+                    {
+                        int avail = 0;
+                        if (ioctl(client->csocket, FIONREAD, &avail) < 0 || avail <= 0)
+                            break;
+                    }
+                    if (!receive_data(client))
+                        break;
+                    ReactorMessage msg;
+                    msg.rc = rc;
+                    msg.data.assign(client->buffer, client->buffer + client->message_length);
+                    batch.push_back(std::move(msg));
+                    // the rest stays in the socket until the next wakeup after the dispatch
+                    if (ends_read_ahead(client->buffer[0]))
+                        break;
+                }
+            }
+
+            // needs the world lock
+            void ClientReactor::dispatch(std::vector<ReactorMessage>& batch)
+            {
+                std::vector<unsigned char> partial;
+                for (ReactorMessage& msg : batch)
+                {
+                    Network::Client* client = msg.rc->client;
+                    if (!client->isConnected())
+                        continue;
+                    // a following message might already be partially received into the buffer
+                    unsigned int bytes_received = client->bytes_received;
+                    unsigned int message_length = client->message_length;
+                    partial.assign(client->buffer, client->buffer + bytes_received);
+
+                    memcpy(client->buffer, &msg.data[0], msg.data.size());
+                    client->bytes_received = client->message_length = static_cast<unsigned int>(msg.data.size());
+                    try
+                    {
+                        dispatch_message(client);
+                        msg.rc->last_packet_at = polclock();
+                        if (!check_inactivity(client))
+                        {
+                            msg.rc->idle_warned = false;
+                            msg.rc->last_activity = polclock();
+                        }
+                    }
+                    catch (std::exception& ex)
+                    {
+                        POLLOG_ERROR.Format("Client#{}: Exception in i/o thread: {}! (checkpoint={})\n")
+                            << client->instance_ << ex.what() << client->checkpoint;
+                        client->forceDisconnect();
+                    }
+
+                    if (!partial.empty())
+                        memcpy(client->buffer, &partial[0], partial.size());
+                    client->bytes_received = bytes_received;
+                    client->message_length = message_length;
+                }
+                if (!batch.empty())
+                {
+                    send_pulse();
+                    if (TaskScheduler::is_dirty())
+                        wake_tasks_thread();
+                }
+            }
+
+            // needs the world lock
+            void ClientReactor::service_clients(std::vector<ReactorClient*>& disconnected)
+            {
+                polclock_t now = polclock();
+                auto itr = _clients.begin();
+                while (itr != _clients.end())
+                {
+                    ReactorClient* rc = *itr;
+                    Network::Client* client = rc->client;
+                    try
+                    {
+                        //region Speedhack
+                        if (client->isReallyConnected() && !client->movementqueue.empty())
+                            process_movementqueue(client);
+                        //endregion Speedhack
+
+                        if ((!client->chr || client->chr->cmdlevel() < Plib::systemstate.config.min_cmdlvl_ignore_inactivity) &&
+                            Plib::systemstate.config.inactivity_warning_timeout && Plib::systemstate.config.inactivity_disconnect_timeout)
+                        {
+                            polclock_t idle = now - rc->last_activity;
+                            if (idle >= Plib::systemstate.config.inactivity_disconnect_timeout * 60 * POLCLOCKS_PER_SEC)
+                            {
+                                client->forceDisconnect();
+                            }
+                            else if (!rc->idle_warned &&
+                                idle >= Plib::systemstate.config.inactivity_warning_timeout * 60 * POLCLOCKS_PER_SEC)
+                            {
+                                rc->idle_warned = true;
+                                Network::PktHelper::PacketOut<Network::PktOut_53> msg;
+                                msg->Write<u8>(PKTOUT_53_WARN_CHARACTER_IDLE);
+                                msg.Send(client);
+                                if (client->pause_count)
+                                    client->restart();
+                            }
+                        }
+                        if ((now - rc->last_packet_at) >= 120000) //2 mins
+                            client->forceDisconnect();
+
+                        if (client->isReallyConnected() && client->have_queued_data())
+                        {
+                            CLIENT_CHECKPOINT(8);
+                            client->send_queued_data();
+                        }
+                    }
+                    catch (std::exception& ex)
+                    {
+                        POLLOG_ERROR.Format("Client#{}: Exception in i/o thread: {}! (checkpoint={})\n")
+                            << client->instance_ << ex.what() << client->checkpoint;
+                        client->forceDisconnect();
+                    }
+
+                    if (!client->isReallyConnected() || Clib::exit_signalled)
+                    {
+                        epoll_ctl(_epfd, EPOLL_CTL_DEL, client->csocket, nullptr);
+                        disconnected.push_back(rc);
+                        itr = _clients.erase(itr);
+                        continue;
+                    }
+                    update_interest(rc);
+                    ++itr;
+                }
+            }
+
+            void ClientReactor::update_interest(ReactorClient* rc)
+            {
+                bool want_write = rc->client->have_queued_data();
+                if (want_write == rc->want_write)
+                    return;
+                struct epoll_event ev;
+                ev.events = want_write ? (EPOLLIN | EPOLLOUT) : EPOLLIN;
+                ev.data.ptr = rc;
+                epoll_ctl(_epfd, EPOLL_CTL_MOD, rc->client->csocket, &ev);
+                rc->want_write = want_write;
+            }
+
+            void ClientReactor::run()
+            {
+                struct epoll_event events[REACTOR_MAX_EVENTS];
+                std::vector<ReactorMessage> batch;
+                std::vector<ReactorClient*> disconnected;
+                while (!Clib::exit_signalled || !_clients.empty() || !_logoffs.empty())
+                {
+                    adopt_pending();
+                    int nevents = 0;
+                    if (!Clib::exit_signalled)
+                    {
+                        nevents = epoll_wait(_epfd, events, REACTOR_MAX_EVENTS, REACTOR_TIMEOUT_MS);
+                        if (nevents < 0)
+                        {
+                            if (errno != EINTR)
+                                POLLOG_ERROR.Format("Network I/O: epoll_wait failed, errno={}\n") << errno;
+                            nevents = 0;
+                        }
+                    }
+
+                    // read everything that is available without holding the world lock
+                    batch.clear();
+                    for (int i = 0; i < nevents; ++i)
+                    {
+                        ReactorClient* rc = static_cast<ReactorClient*>(events[i].data.ptr);
+                        if (events[i].events & EPOLLERR)
+                        {
+                            rc->client->forceDisconnect();
+                            continue;
+                        }
+                        if (events[i].events & (EPOLLIN | EPOLLHUP))
+                            read_client(rc, batch);
+                    }
+
+                    // a single lock for the messages of all clients of this pass
+                    disconnected.clear();
+                    {
+                        PolLock lck;
+                        dispatch(batch);
+                        service_clients(disconnected);
+                    }
+
+                    for (ReactorClient* rc : disconnected)
+                    {
+                        ReactorLogoff logoff;
+                        logoff.client = rc->client;
+                        logoff.when_logoff = client_disconnected(rc->client, rc->last_activity);
+                        _logoffs.push_back(logoff);
+                        delete rc;
+                    }
+
+                    if (!_logoffs.empty())
+                    {
+                        polclock_t now = polclock();
+                        auto itr = _logoffs.begin();
+                        while (itr != _logoffs.end())
+                        {
+                            if (Clib::exit_signalled || now >= itr->when_logoff)
+                            {
+                                client_logoff(itr->client);
+                                itr = _logoffs.erase(itr);
+                            }
+                            else
+                                ++itr;
+                        }
+                    }
+                }
+                close(_epfd);
+            }
+        }
+
+        void start_client_reactors()
+        {
+            for (unsigned i = 0; i < Plib::systemstate.config.network_io_threads; ++i)
+            {
+                reactors.push_back(std::unique_ptr<ClientReactor>(new ClientReactor));
+                reactors.back()->start(i);
+            }
+        }
+
+        void add_client_to_reactor(Network::Client* client)
+        {
+            passert_always(!reactors.empty());
+            reactors[next_reactor++ % reactors.size()]->add(client);
+        }
+#endif
+
         bool check_inactivity(Network::Client* client)
         {
             switch (client->buffer[0])
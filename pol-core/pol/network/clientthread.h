@@ -1,6 +1,8 @@
 #ifndef CLIENTTHREAD_H
 #define CLIENTTHREAD_H
 
+#include "../polclock.h"
+
 namespace Pol {
     namespace Network {
         class Client;
@@ -8,10 +10,21 @@ namespace Pol {
     namespace Core {
         bool client_io_thread(Network::Client* client, bool login);
         bool process_data(Network::Client *client);
+        bool receive_data(Network::Client *client);
+        void dispatch_message(Network::Client *client);
+        void process_movementqueue(Network::Client* client);
+        polclock_t client_disconnected(Network::Client* client, polclock_t last_activity);
+        void client_logoff(Network::Client* client);
         bool check_inactivity(Network::Client* client); 
         
         void handle_unknown_packet(Network::Client* client);
         void handle_undefined_packet(Network::Client *client);
+
+#ifdef __linux__
+        // epoll based client i/o, used instead of client_io_thread when NetworkIoThreads > 0
+        void start_client_reactors();
+        void add_client_to_reactor(Network::Client* client);
+#endif
     }
 }
 
@@ -5,7 +5,11 @@
 
 namespace Pol {
   namespace Network {
-	ClientTransmit::ClientTransmit() : _transmitqueue() {}
+	// upper limits for keeping sent entries for reuse
+	const size_t TRANSMIT_FREELIST_SIZE = 4096;
+	const size_t TRANSMIT_KEEP_CAPACITY = 4096;
+
+	ClientTransmit::ClientTransmit() : _transmitqueue(), _freelist(), _freelist_mutex() {}
 
 	ClientTransmit::~ClientTransmit() {}
 
@@ -13,10 +17,41 @@ namespace Pol {
 	{
 	  _transmitqueue.cancel();
 	}
+	TransmitDataSPtr ClientTransmit::NewEntry()
+	{
+	  {
+		std::lock_guard<std::mutex> lock( _freelist_mutex );
+		if ( !_freelist.empty() )
+		{
+		  TransmitDataSPtr transmitdata = std::move( _freelist.back() );
+		  _freelist.pop_back();
+		  return transmitdata;
+		}
+	  }
+	  return TransmitDataSPtr( new TransmitData );
+	}
+
+	void ClientTransmit::Recycle( std::list<TransmitDataSPtr>* entries )
+	{
+	  std::lock_guard<std::mutex> lock( _freelist_mutex );
+	  for ( auto& transmitdata : *entries )
+	  {
+		if ( _freelist.size() >= TRANSMIT_FREELIST_SIZE )
+		  break;
+		if ( transmitdata->data.capacity() > TRANSMIT_KEEP_CAPACITY )
+		  continue;
+		transmitdata->client = nullptr;
+		transmitdata->clients.clear();
+		transmitdata->disconnects = false;
+		_freelist.push_back( std::move( transmitdata ) );
+	  }
+	  entries->clear();
+	}
+
 	void ClientTransmit::AddToQueue( Client* client, const void* data, int len )
 	{
 	  const u8* message = static_cast<const u8*>( data );
-	  auto transmitdata = TransmitDataSPtr( new TransmitData );
+	  auto transmitdata = NewEntry();
 	  transmitdata->client = client;
 	  transmitdata->len = len;
 	  transmitdata->data.assign( message, message + len );
@@ -24,37 +59,77 @@ namespace Pol {
 	  _transmitqueue.push_move( std::move( transmitdata ) );
 	}
 
+	void ClientTransmit::AddToQueue( const std::vector<Client*>& clients, const void* data, int len )
+	{
+	  if ( clients.empty() )
+		return;
+	  if ( clients.size() == 1 )
+	  {
+		AddToQueue( clients.front(), data, len );
+		return;
+	  }
+	  const u8* message = static_cast<const u8*>( data );
+	  auto transmitdata = NewEntry();
+	  transmitdata->client = nullptr;
+	  transmitdata->clients = clients;
+	  transmitdata->len = len;
+	  transmitdata->data.assign( message, message + len );
+	  transmitdata->disconnects = false;
+	  _transmitqueue.push_move( std::move( transmitdata ) );
+	}
+
 	void ClientTransmit::QueueDisconnection( Client* client )
 	{
-	  auto transmitdata = TransmitDataSPtr( new TransmitData );
+	  auto transmitdata = NewEntry();
 	  transmitdata->disconnects = true;
 	  transmitdata->client = client;
 	  _transmitqueue.push_move( std::move( transmitdata ) );
 	}
 
-	TransmitDataSPtr ClientTransmit::NextQueueEntry()
+	void ClientTransmit::NextQueueEntries( std::list<TransmitDataSPtr>* entries )
 	{
-	  auto transmitdata = TransmitDataSPtr();
-	  _transmitqueue.pop_wait( &transmitdata );
-	  return transmitdata;
+	  _transmitqueue.pop_wait( entries );
 	}
 
+	// Takes everything queued so far as one batch. The packets of a batch are collected
+	// per client and each client gets a single send() at the end of the batch.
+	// Broadcast entries are encrypted and collected for each of their clients in turn.
 	void ClientTransmitThread()
 	{
 	  ClientTransmit* transmit_instance = Core::networkManager.clientTransmit.get();
+	  std::list<TransmitDataSPtr> entries;
 	  while ( !Clib::exit_signalled )
 	  {
 		try
 		{
-		  auto data = transmit_instance->NextQueueEntry();
-		  if ( data->client != nullptr )
+		  transmit_instance->NextQueueEntries( &entries );
+		  Client::begin_coalescing();
+		  for ( auto& data : entries )
 		  {
-			if ( data->disconnects )
-			  data->client->forceDisconnect();
-			else if ( data->client->isReallyConnected() )
-			  data->client->transmit(
-			  static_cast<void*>( &data->data[0] ), data->len, true );
+			if ( data->client != nullptr )
+			{
+			  if ( data->disconnects )
+			  {
+				// send what is collected so far before the client gets disconnected
+				Client::end_coalescing();
+				data->client->forceDisconnect();
+				Client::begin_coalescing();
+			  }
+			  else if ( data->client->isReallyConnected() )
+				data->client->transmit(
+				static_cast<void*>( &data->data[0] ), data->len, true );
+			}
+			else
+			{
+			  for ( Client* client : data->clients )
+			  {
+				if ( client->isReallyConnected() )
+				  client->transmit( static_cast<void*>( &data->data[0] ), data->len, true );
+			  }
+			}
 		  }
+		  Client::end_coalescing();
+		  transmit_instance->Recycle( &entries );
 		}
 		catch ( ClientTransmitQueue::Canceled& )
 		{
@@ -6,6 +6,7 @@
 
 #include <boost/noncopyable.hpp>
 
+#include <list>
 #include <memory>
 #include <mutex>
 #include <vector>
@@ -17,6 +18,8 @@ namespace Pol {
 	struct TransmitData
 	{
 	  Client* client;
+	  // recipients of a broadcast, client is nullptr then
+	  std::vector<Client*> clients;
 	  int len;
 	  std::vector<u8> data;
 	  bool disconnects;
@@ -34,13 +37,21 @@ namespace Pol {
       ~ClientTransmit();
 
       void AddToQueue(Client* client, const void* data, int len);
+      // queues one copy of the packet for all given clients
+      void AddToQueue(const std::vector<Client*>& clients, const void* data, int len);
       void QueueDisconnection(Client* client);
       void Cancel();
 
-      TransmitDataSPtr NextQueueEntry();
+      void NextQueueEntries( std::list<TransmitDataSPtr>* entries );
+      void Recycle( std::list<TransmitDataSPtr>* entries );
 
      private:
+      TransmitDataSPtr NewEntry();
+
       ClientTransmitQueue _transmitqueue;
+      // sent entries are reused so that their buffers keep their capacity
+      std::vector<TransmitDataSPtr> _freelist;
+      std::mutex _freelist_mutex;
     };
 
     void ClientTransmitThread();
@@ -2,6 +2,8 @@
 #include "../../clib/logfacility.h"
 
 #include "packetdefs.h"
+#include "cgdata.h"
+#include "client.h"
 
 namespace Pol {
   namespace Network {
@@ -377,6 +379,8 @@ namespace Pol {
 	  if ( _p->offset == 1 )
         build();
       _p.Send( client, _p->SIZE );
+	  if ( client->gd != NULL )
+		client->gd->known_objects.forget( _serial );
 	}
 
 	void RemoveObjectPkt::build()
@@ -4,6 +4,8 @@
 #include "packets.h"
 #include "../globals/network.h"
 
+#include <vector>
+
 namespace Pol {
   namespace Network {
 	namespace PktHelper {
@@ -33,6 +35,8 @@ namespace Pol {
 		 ~PacketOut();
 		 void Release();
 		 void Send( Client* client, int len = -1 ) const;
+		 // queues the packet once for all clients
+		 void Send( const std::vector<Client*>& clients, int len = -1 ) const;
          // be really really careful with this function
          // needs PolLock
 		 void SendDirect( Client* client, int len = -1 ) const;
@@ -70,6 +74,16 @@ namespace Pol {
         Core::networkManager.clientTransmit->AddToQueue(client, &pkt->buffer, len);
       }
 
+	  template <class T>
+      void PacketOut<T>::Send(const std::vector<Client*>& clients, int len) const
+      {
+        if (pkt == 0)
+          return;
+        if (len == -1)
+          len = pkt->offset;
+        Core::networkManager.clientTransmit->AddToQueue(clients, &pkt->buffer, len);
+      }
+
 	  template <class T>
       void PacketOut<T>::SendDirect(Client* client, int len) const
       {
@@ -32,7 +32,7 @@ namespace Pol {
   namespace Core {
 	ObjectHash::ObjectHash() :
 	  hash(),
-	  reap_iterator( hash.end() )
+	  reap_serial( 0 )
 	{};
 
 	ObjectHash::~ObjectHash()
@@ -40,14 +40,12 @@ namespace Pol {
 
 	bool ObjectHash::Insert( UObject* obj )
 	{
-	  OH_iterator itr = hash.find( obj->serial );
-	  if ( itr != hash.end() )
+	  if ( !hash.insert( obj->serial, UObjectRef( obj ) ) )
 	  {
         if (Plib::systemstate.config.loglevel >= 5 )
           POLLOG.Format( "ObjectHash insert failed for object serial 0x{:X}. (duplicate serial?)\n" ) << obj->serial;
 		return false;
 	  }
-	  hash.insert( hash.end(), std::make_pair( obj->serial, UObjectRef( obj ) ) );
 	  return true;
 	}
 
@@ -61,9 +59,9 @@ namespace Pol {
 
 	UObject* ObjectHash::Find( u32 serial )
 	{
-	  OH_iterator itr = hash.find( serial );
-	  if ( itr != hash.end() )
-		return ( itr->second ).get();
+	  UObjectRef* ref = hash.find( serial );
+	  if ( ref != NULL )
+		return ref->get();
 	  else
 		return NULL;
 	}
@@ -79,7 +77,7 @@ namespace Pol {
 		if ( tempserial > ITEMSERIAL_END )
 		  tempserial = ITEMSERIAL_START;
 
-		if ( hash.find( tempserial ) != hash.end() )
+		if ( hash.find( tempserial ) != NULL )
 		{
 		  tempserial++;
 		  continue;
@@ -113,7 +111,7 @@ namespace Pol {
 		if ( tempserial > CHARACTERSERIAL_END )
 		  tempserial = CHARACTERSERIAL_START;
 
-		if ( hash.find( tempserial ) != hash.end() )
+		if ( hash.find( tempserial ) != NULL )
 		{
 		  tempserial++;
 		  continue;
@@ -142,7 +140,7 @@ namespace Pol {
 	  sw() << "Object Count: " << hash.size() << "\n";
 	  for ( itr = hash.begin(), itrend = hash.end(); itr != itrend; ++itr )
 	  {
-        sw() << "type: " << itr->second->classname() << " serial: 0x" << fmt::hexu( itr->second->serial ) << " name: " << itr->second->name() << "\n";
+        sw() << "type: " << ( *itr )->classname() << " serial: 0x" << fmt::hexu( ( *itr )->serial ) << " name: " << ( *itr )->name() << "\n";
 		//itr->second->printOn( sw ); // its no more safe to try to print the complete object
 	  }
 
@@ -156,36 +154,37 @@ namespace Pol {
 	  // 30 minutes = 1800 seconds = 900 reap calls per sweep
 
 	  // first, figure out how many objects to check:
-	  hs::size_type count = hash.size();
+	  size_t count = hash.size();
 	  if ( count == 0 )
 		return;
-	  hs::size_type count_this = count / 60;
+	  size_t count_this = count / 60;
 	  if ( count_this < 1 )
 		count_this = 1;
-	  if ( reap_iterator == hash.end() )
-		reap_iterator = hash.begin();
 
+	  // the position is remembered as serial, so objects created or reaped
+	  // in the meantime don't invalidate it
+	  hs::const_iterator itr = hash.lower_bound( reap_serial );
 	  while ( count_this-- )
 	  {
-		UObject* obj = ( *reap_iterator ).second.get();
+		if ( itr == hash.end() )
+		{
+		  itr = hash.begin();
+		  if ( itr == hash.end() )
+			break;
+		}
+		UObject* obj = itr->get();
+		u32 serial = itr.serial();
+		++itr;
 
 		// We want the objecthash to be the holder of the last reference to an
 		// object when it is deleted - hence the ref_counted_count() check.
 		if ( obj->orphan() && obj->ref_counted_count() == 1 )
 		{
 		  dirty_deleted.insert( cfBEu32( obj->serial_ext ) );
-		  hash.erase( reap_iterator++ );
-		}
-		else
-		  ++reap_iterator;
-
-		if ( reap_iterator == hash.end() )
-		{
-		  reap_iterator = hash.begin();
-		  if ( reap_iterator == hash.end() )
-			break;
+		  hash.erase( serial );
 		}
 	  }
+	  reap_serial = ( itr == hash.end() ) ? 0 : itr.serial();
 	}
 
 	void ObjectHash::Clear()
@@ -195,19 +194,20 @@ namespace Pol {
 	  {
 		any = false;
 		unsigned skipped = 0;
-		for ( OH_iterator itr = hash.begin(), itrend = hash.end(); itr != itrend; )
+		for ( OH_const_iterator itr = hash.begin(), itrend = hash.end(); itr != itrend; )
 		{
-		  UObject* obj = ( *itr ).second.get();
+		  UObject* obj = itr->get();
+		  u32 serial = itr.serial();
+		  ++itr;
 
 		  if ( obj->orphan() && obj->ref_counted_count() == 1 )
 		  {
-			hash.erase( itr++ );
+			hash.erase( serial );
 			any = true;
 		  }
 		  else
 		  {
 			++skipped;
-			++itr;
 		  }
 		}
 	  } while ( any );
@@ -217,9 +217,9 @@ namespace Pol {
 
 		// the hash will be cleared after main() exits, with other statics.
 		// this usually causes assertion failures and crashes.
-		// creating a copy of the internal hash will ensure no refcounts reach zero.
-        INFO_PRINT << "Leaking a copy of the objecthash in order to avoid a crash.\n";
-		new hs( hash );
+		// forgetting the remaining references will ensure no refcounts reach zero.
+        INFO_PRINT << "Leaking the objecthash in order to avoid a crash.\n";
+		hash.leak();
 	  }
 	  //    hash.clear();
 	}
@@ -229,7 +229,7 @@ namespace Pol {
 	{
 	  for ( OH_const_iterator itr = hash.begin(), itrend = hash.end(); itr != itrend; ++itr )
 	  {
-		UObject* obj = ( *itr ).second.get();
+		UObject* obj = itr->get();
 		if ( !obj->orphan() && obj->ismobile() )
 		{
 		  Mobile::Character* chr = static_cast<Mobile::Character*>( obj );
@@ -254,6 +254,16 @@ namespace Pol {
 	  return hash.end();
 	}
 
+	size_t ObjectHash::size() const
+	{
+	  return hash.size();
+	}
+
+	size_t ObjectHash::sizeEstimate() const
+	{
+	  return hash.sizeEstimate();
+	}
+
 	ObjectHash::ds::const_iterator ObjectHash::dirty_deleted_begin() const
 	{
 	  return dirty_deleted.begin();
@@ -270,6 +280,18 @@ namespace Pol {
 	  clean_deleted.clear();
 	}
 
+	void ObjectHash::TakeDeleted( ds& deleted )
+	{
+	  deleted.clear();
+	  deleted.swap( dirty_deleted );
+	  clean_deleted.clear();
+	}
+
+	void ObjectHash::RestoreDeleted( const ds& deleted )
+	{
+	  dirty_deleted.insert( deleted.begin(), deleted.end() );
+	}
+
 	void ObjectHash::CleanDeleted()
 	{
 	  clean_deleted.insert( dirty_deleted.begin(), dirty_deleted.end() );
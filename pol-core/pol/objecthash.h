@@ -14,7 +14,8 @@ Notes
 #include "reftypes.h"
 #include "../clib/rawtypes.h"
 
-#include <map>
+#include <cstddef>
+#include <iterator>
 #include <unordered_set>
 
 namespace Pol {
@@ -24,18 +25,223 @@ namespace Pol {
 
   namespace Core {
 	/*
-	template <class _Key> struct myhash { };
-	_STLP_TEMPLATE_NULL struct myhash<UObject*> {
-	size_t operator()(UObject* obj) const { return obj->serial; }
-	};
+	Paged direct index of serials: the serial itself is split into
+	[ directory 11 bits | page 11 bits | slot 10 bits ].
+	Serials are handed out sequentially, so the pages are densely filled and a lookup
+	is three array accesses instead of a tree walk. Pages and directories are allocated
+	on first use and freed when they get empty.
+	Iteration is in ascending serial order and only remembers the current serial,
+	so elements may be erased (or inserted) while iterating.
+	An empty T (!value) marks an unused slot.
 	*/
+	template <class T>
+	class SerialTable
+	{
+	  enum
+	  {
+		SLOT_BITS = 10,
+		PAGE_BITS = 11,
+		DIR_BITS = 32 - SLOT_BITS - PAGE_BITS,
+		SLOTS = 1 << SLOT_BITS,
+		PAGES = 1 << PAGE_BITS,
+		DIRS = 1 << DIR_BITS
+	  };
+	  struct Page
+	  {
+		Page() : slots(), count( 0 ) {}
+		T slots[SLOTS];
+		unsigned count;
+	  };
+	  struct Dir
+	  {
+		Dir() : pages(), count( 0 ) {}
+		Page* pages[PAGES];
+		unsigned count;
+	  };
+
+	public:
+	  class const_iterator : public std::iterator<std::forward_iterator_tag, const T>
+	  {
+	  public:
+		const_iterator() : _table( nullptr ), _slot( nullptr ), _serial( 0 ) {}
+		const T& operator*() const { return *_slot; }
+		const T* operator->() const { return _slot; }
+		u32 serial() const { return _serial; }
+		const_iterator& operator++()
+		{
+		  if ( _serial == 0xFFFFFFFFLu )
+			_slot = nullptr;
+		  else
+			_slot = _table->next_used( _serial + 1, _serial );
+		  return *this;
+		}
+		const_iterator operator++( int )
+		{
+		  const_iterator tmp( *this );
+		  ++*this;
+		  return tmp;
+		}
+		bool operator==( const const_iterator& other ) const { return _slot == other._slot; }
+		bool operator!=( const const_iterator& other ) const { return _slot != other._slot; }
+	  private:
+		friend class SerialTable;
+		const SerialTable* _table;
+		T* _slot;
+		u32 _serial;
+	  };
+
+	  SerialTable() : _dirs(), _size( 0 ) {}
+	  ~SerialTable() { clear(); }
+
+	  T* find( u32 serial ) const
+	  {
+		const Dir* dir = _dirs[serial >> ( SLOT_BITS + PAGE_BITS )];
+		if ( dir == nullptr )
+		  return nullptr;
+		Page* page = dir->pages[( serial >> SLOT_BITS ) & ( PAGES - 1 )];
+		if ( page == nullptr )
+		  return nullptr;
+		T* slot = &page->slots[serial & ( SLOTS - 1 )];
+		return !*slot ? nullptr : slot;
+	  }
+
+	  // returns false if the serial is already in use
+	  bool insert( u32 serial, const T& value )
+	  {
+		Dir*& dir = _dirs[serial >> ( SLOT_BITS + PAGE_BITS )];
+		if ( dir == nullptr )
+		  dir = new Dir;
+		Page*& page = dir->pages[( serial >> SLOT_BITS ) & ( PAGES - 1 )];
+		if ( page == nullptr )
+		{
+		  page = new Page;
+		  ++dir->count;
+		}
+		T& slot = page->slots[serial & ( SLOTS - 1 )];
+		if ( !!slot )
+		  return false;
+		slot = value;
+		++page->count;
+		++_size;
+		return true;
+	  }
+
+	  bool erase( u32 serial )
+	  {
+		Dir*& dir = _dirs[serial >> ( SLOT_BITS + PAGE_BITS )];
+		if ( dir == nullptr )
+		  return false;
+		Page*& page = dir->pages[( serial >> SLOT_BITS ) & ( PAGES - 1 )];
+		if ( page == nullptr )
+		  return false;
+		T& slot = page->slots[serial & ( SLOTS - 1 )];
+		if ( !slot )
+		  return false;
+		--_size;
+		if ( --page->count == 0 )
+		{
+		  // the slot is the last reference into the page, so free it in one go
+		  delete page;
+		  page = nullptr;
+		  if ( --dir->count == 0 )
+		  {
+			delete dir;
+			dir = nullptr;
+		  }
+		}
+		else
+		  slot = T();
+		return true;
+	  }
+
+	  void clear()
+	  {
+		for ( unsigned d = 0; d < DIRS; ++d )
+		{
+		  Dir* dir = _dirs[d];
+		  if ( dir == nullptr )
+			continue;
+		  for ( unsigned p = 0; p < PAGES; ++p )
+			delete dir->pages[p];
+		  delete dir;
+		  _dirs[d] = nullptr;
+		}
+		_size = 0;
+	  }
+
+	  // forgets all elements without destroying them
+	  void leak()
+	  {
+		for ( unsigned d = 0; d < DIRS; ++d )
+		  _dirs[d] = nullptr;
+		_size = 0;
+	  }
+
+	  size_t size() const { return _size; }
+	  bool empty() const { return _size == 0; }
+
+	  const_iterator begin() const { return lower_bound( 0 ); }
+	  const_iterator end() const { return const_iterator(); }
+	  // first element with serial >= given serial
+	  const_iterator lower_bound( u32 serial ) const
+	  {
+		const_iterator itr;
+		itr._table = this;
+		itr._slot = next_used( serial, itr._serial );
+		return itr;
+	  }
+
+	  size_t sizeEstimate() const
+	  {
+		size_t size = sizeof( *this );
+		for ( unsigned d = 0; d < DIRS; ++d )
+		{
+		  if ( _dirs[d] != nullptr )
+			size += sizeof( Dir ) + _dirs[d]->count * sizeof( Page );
+		}
+		return size;
+	  }
+
+	private:
+	  T* next_used( u32 serial, u32& found ) const
+	  {
+		// only the first dir and page start at the offset of serial, every following one
+		// at its beginning, also if the previous page or dir is missing
+		for ( unsigned d = serial >> ( SLOT_BITS + PAGE_BITS ); d < DIRS; ++d, serial = 0 )
+		{
+		  const Dir* dir = _dirs[d];
+		  if ( dir == nullptr )
+			continue;
+		  for ( unsigned p = ( serial >> SLOT_BITS ) & ( PAGES - 1 ); p < PAGES; ++p, serial = 0 )
+		  {
+			Page* page = dir->pages[p];
+			if ( page == nullptr )
+			  continue;
+			for ( unsigned s = serial & ( SLOTS - 1 ); s < SLOTS; ++s )
+			{
+			  if ( !!page->slots[s] )
+			  {
+				found = ( d << ( SLOT_BITS + PAGE_BITS ) ) | ( p << SLOT_BITS ) | s;
+				return &page->slots[s];
+			  }
+			}
+		  }
+		}
+		return nullptr;
+	  }
+
+	  SerialTable( const SerialTable& );
+	  SerialTable& operator=( const SerialTable& );
+
+	  Dir* _dirs[DIRS];
+	  size_t _size;
+	};
+
 	class ObjectHash
 	{
 	public:
 	  typedef std::unordered_set<u32> ds;
-	  typedef std::pair<u32, UObjectRef> hashpair;
-      typedef std::map<u32, UObjectRef> hs;
-	  typedef hs::iterator OH_iterator;
+	  typedef SerialTable<UObjectRef> hs;
 	  typedef hs::const_iterator OH_const_iterator;
 
 	  ObjectHash();
@@ -53,6 +259,8 @@ namespace Pol {
 
 	  hs::const_iterator begin() const;
 	  hs::const_iterator end() const;
+	  size_t size() const;
+	  size_t sizeEstimate() const;
 	  void ClearCharacterAccountReferences();
 
 	  ds::const_iterator dirty_deleted_begin() const;
@@ -60,12 +268,15 @@ namespace Pol {
 
 	  void CleanDeleted();
 	  void ClearDeleted();
+	  // a snapshot save takes the deleted serials it saved, and gives them back if it failed
+	  void TakeDeleted( ds& deleted );
+	  void RestoreDeleted( const ds& deleted );
 
 	  void RegisterCleanDeletedSerial( u32 serial );
 
 	private:
 	  hs hash;
-	  OH_iterator reap_iterator;
+	  u32 reap_serial;
 
 	  ds dirty_deleted;
 	  ds clean_deleted;
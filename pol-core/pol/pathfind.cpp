@@ -0,0 +1,442 @@
+/*
+History
+=======
+
+Notes
+=======
+
+*/
+
+#include "pathfind.h"
+
+#include "clidata.h"
+#include "tiles.h"
+#include "uconst.h"
+#include "uworld.h"
+#include "item/item.h"
+#include "item/itemdesc.h"
+#include "multi/house.h"
+#include "multi/multi.h"
+#include "multi/multidef.h"
+
+#include "../clib/logfacility.h"
+#include "../clib/threadhelp.h"
+#include "../plib/mapcell.h"
+#include "../plib/realm.h"
+#include "../plib/systemstate.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+
+namespace Pol {
+  namespace Core {
+    namespace
+    {
+      // walkheight result for a tile which can't be entered
+      const short NOT_WALKABLE = SHRT_MIN;
+
+      const float DIAGONAL_COST = 1.414f;
+    }
+
+    PathRequest::PathRequest() :
+      realm( nullptr ),
+      x1( 0 ), y1( 0 ), z1( 0 ),
+      x2( 0 ), y2( 0 ), z2( 0 ),
+      xL( 0 ), xH( 0 ), yL( 0 ), yH( 0 ),
+      doors_block( true ),
+      blockers(),
+      use_snapshot( false ),
+      dynamics()
+    {}
+
+    void snapshot_dynamics( PathRequest& req )
+    {
+      req.use_snapshot = true;
+      req.dynamics.clear();
+
+      // same shapes as Realm::readdynamics
+      WorldIterator<ItemFilter>::InBox( req.xL, req.yL, req.xH, req.yH, req.realm, [&]( Items::Item* item )
+      {
+        if ( !( tile_flags( item->graphic ) & Plib::FLAG::WALKBLOCK ) )
+          return;
+        if ( !req.doors_block && item->itemdesc().type == Items::ItemDesc::DOORDESC )
+          return;
+        Plib::MapShape shape;
+        shape.z = item->z;
+        shape.height = item->height;
+        shape.flags = Plib::systemstate.tile[item->graphic].flags;
+        req.dynamics[PathFinder::tile_key( item->x, item->y )].push_back( shape );
+      } );
+
+      // and Realm::readmultis, which looks at the multis up to 64 tiles away
+      int mxL = std::max( req.xL - 64, 0 );
+      int myL = std::max( req.yL - 64, 0 );
+      int mxH = std::min( req.xH + 64, req.realm->width() - 1 );
+      int myH = std::min( req.yH + 64, req.realm->height() - 1 );
+      Plib::MapShapeList shapes;
+      WorldIterator<MultiFilter>::InBox( static_cast<u16>( mxL ), static_cast<u16>( myL ), static_cast<u16>( mxH ), static_cast<u16>( myH ), req.realm, [&]( Multi::UMulti* multi )
+      {
+        const Multi::MultiDef& def = multi->multidef();
+        Multi::UHouse* house = multi->as_house();
+        bool custom = house != nullptr && house->IsCustom();
+        int xL = std::max<int>( req.xL, multi->x + def.minrx );
+        int yL = std::max<int>( req.yL, multi->y + def.minry );
+        int xH = std::min<int>( req.xH, multi->x + def.maxrx );
+        int yH = std::min<int>( req.yH, multi->y + def.maxry );
+        for ( int x = xL; x <= xH; ++x )
+        {
+          for ( int y = yL; y <= yH; ++y )
+          {
+            shapes.clear();
+            s16 rx = static_cast<s16>( x - multi->x );
+            s16 ry = static_cast<s16>( y - multi->y );
+            if ( custom )
+              multi->readshapes( shapes, rx, ry, multi->z );
+            else
+              def.readshapes( shapes, rx, ry, multi->z, Plib::FLAG::MOVE_FLAGS );
+            if ( !shapes.empty() )
+            {
+              Plib::MapShapeList& tile = req.dynamics[PathFinder::tile_key( x, y )];
+              tile.insert( tile.end(), shapes.begin(), shapes.end() );
+            }
+          }
+        }
+      } );
+    }
+
+    PathFinder::PathFinder( unsigned int max_nodes ) :
+      _max_nodes( max_nodes ),
+      _req( nullptr ),
+      _nodes(),
+      _heap(),
+      _index(),
+      _walkcache(),
+      _blockers(),
+      _shapes(),
+      _possible_shapes(),
+      _expanded( 0 ),
+      _out_of_nodes( false )
+    {
+      _nodes.reserve( max_nodes );
+      _heap.reserve( max_nodes );
+    }
+
+    u64 PathFinder::state_key( int x, int y, int z )
+    {
+      return ( static_cast<u64>( static_cast<u16>( x ) ) << 32 ) |
+        ( static_cast<u64>( static_cast<u16>( y ) ) << 16 ) |
+        static_cast<u16>( z );
+    }
+
+    u32 PathFinder::tile_key( int x, int y )
+    {
+      return ( static_cast<u32>( static_cast<u16>( x ) ) << 16 ) | static_cast<u16>( y );
+    }
+
+    void PathFinder::reset( const PathRequest& req )
+    {
+      // clear() keeps the allocated memory for the next search
+      _req = &req;
+      _nodes.clear();
+      _heap.clear();
+      _index.clear();
+      _walkcache.clear();
+      _blockers.clear();
+      _expanded = 0;
+      _out_of_nodes = false;
+
+      for ( const auto& blocker : req.blockers )
+        _blockers.insert( std::make_pair( tile_key( blocker.x, blocker.y ), blocker.z ) );
+    }
+
+    int PathFinder::add_node( short x, short y, short z )
+    {
+      if ( _nodes.size() >= _max_nodes )
+      {
+        _out_of_nodes = true;
+        return -1;
+      }
+      Node node;
+      node.x = x;
+      node.y = y;
+      node.z = z;
+      node.closed = false;
+      node.parent = -1;
+      node.heap_index = -1;
+      node.g = 0;
+      node.f = 0;
+      int index = static_cast<int>( _nodes.size() );
+      _nodes.push_back( node );
+      _index[state_key( x, y, z )] = index;
+      return index;
+    }
+
+    // walkheight of the realm, remembered for the rest of the search
+    bool PathFinder::walkheight( short x, short y, short oldz, short* newz )
+    {
+      auto res = _walkcache.insert( std::make_pair( state_key( x, y, oldz ), NOT_WALKABLE ) );
+      if ( res.second )
+      {
+        short z;
+        bool walkable;
+        if ( _req->use_snapshot )
+        {
+          _shapes.clear();
+          auto tile = _req->dynamics.find( tile_key( x, y ) );
+          if ( tile != _req->dynamics.end() )
+            _shapes.assign( tile->second.begin(), tile->second.end() );
+          walkable = _req->realm->walkheight( _shapes, _possible_shapes, x, y, oldz, &z );
+        }
+        else
+        {
+          Multi::UMulti* supporting_multi = nullptr;
+          Items::Item* walkon_item = nullptr;
+          walkable = _req->realm->walkheight( x, y, oldz, &z, &supporting_multi, &walkon_item, _req->doors_block, MOVEMODE_LAND );
+        }
+        if ( walkable )
+          res.first->second = z;
+      }
+      if ( res.first->second == NOT_WALKABLE )
+        return false;
+      *newz = res.first->second;
+      return true;
+    }
+
+    bool PathFinder::is_blocking( short x, short y, short z ) const
+    {
+      auto range = _blockers.equal_range( tile_key( x, y ) );
+      for ( auto itr = range.first; itr != range.second; ++itr )
+      {
+        if ( std::abs( itr->second - z ) < PLAYER_CHARACTER_HEIGHT )
+          return true;
+      }
+      return false;
+    }
+
+    float PathFinder::estimate( const Node& node ) const
+    {
+      return static_cast<float>( std::abs( node.x - _req->x2 ) + std::abs( node.y - _req->y2 ) + std::abs( node.z - _req->z2 ) );
+    }
+
+    bool PathFinder::is_goal( const Node& node ) const
+    {
+      return node.x == _req->x2 && node.y == _req->y2 && std::abs( node.z - _req->z2 ) <= PLAYER_CHARACTER_HEIGHT;
+    }
+
+    void PathFinder::expand( int index )
+    {
+      const short x = _nodes[index].x;
+      const short y = _nodes[index].y;
+      const short z = _nodes[index].z;
+
+      for ( short i = -1; i <= 1; ++i )
+      {
+        for ( short j = -1; j <= 1; ++j )
+        {
+          if ( i == 0 && j == 0 )
+            continue;
+
+          short newx = x + i;
+          short newy = y + j;
+          if ( newx < 0 || newx < _req->xL || newx > _req->xH )
+            continue;
+          if ( newy < 0 || newy < _req->yL || newy > _req->yH )
+            continue;
+
+          short newz;
+          if ( !walkheight( newx, newy, z, &newz ) )
+            continue;
+
+          // a diagonal move between two blocked tiles is not allowed
+          if ( i != 0 && j != 0 )
+          {
+            short sidez;
+            if ( !walkheight( x + i, y, z, &sidez ) && !walkheight( x, y + j, z, &sidez ) )
+              continue;
+          }
+
+          bool is_start = newx == _req->x1 && newy == _req->y1 && newz == _req->z1;
+          bool is_end = newx == _req->x2 && newy == _req->y2 && newz == _req->z2;
+          if ( !is_start && !is_end && is_blocking( newx, newy, newz ) )
+            continue;
+
+          float newg = _nodes[index].g + ( ( i != 0 && j != 0 ) ? DIAGONAL_COST : 1.0f );
+
+          int succ;
+          auto itr = _index.find( state_key( newx, newy, newz ) );
+          if ( itr != _index.end() )
+          {
+            succ = itr->second;
+            // the known way there is at least as cheap
+            if ( _nodes[succ].g <= newg )
+              continue;
+          }
+          else
+          {
+            succ = add_node( newx, newy, newz );
+            if ( succ < 0 )
+              return;
+          }
+
+          Node& node = _nodes[succ];
+          node.parent = index;
+          node.g = newg;
+          node.f = newg + estimate( node );
+          node.closed = false;
+          if ( node.heap_index >= 0 )
+            heap_up( node.heap_index );
+          else
+            heap_push( succ );
+        }
+      }
+    }
+
+    PathFinder::Result PathFinder::find( const PathRequest& req, std::vector<PathStep>& path )
+    {
+      path.clear();
+      reset( req );
+
+      int start = add_node( req.x1, req.y1, req.z1 );
+      _nodes[start].f = estimate( _nodes[start] );
+      heap_push( start );
+
+      while ( !_heap.empty() )
+      {
+        int index = heap_pop();
+        if ( is_goal( _nodes[index] ) )
+        {
+          // the steps to the node before the goal, followed by the requested goal itself
+          if ( index != start )
+          {
+            for ( int step = _nodes[index].parent; step != start; step = _nodes[step].parent )
+            {
+              PathStep ps = { _nodes[step].x, _nodes[step].y, _nodes[step].z };
+              path.push_back( ps );
+            }
+            std::reverse( path.begin(), path.end() );
+            PathStep goal = { static_cast<short>( req.x2 ), static_cast<short>( req.y2 ), req.z2 };
+            path.push_back( goal );
+          }
+          _req = nullptr;
+          return PATH_FOUND;
+        }
+
+        _nodes[index].closed = true;
+        ++_expanded;
+        expand( index );
+        if ( _out_of_nodes )
+        {
+          _req = nullptr;
+          return PATH_OUT_OF_NODES;
+        }
+      }
+      _req = nullptr;
+      return PATH_NOT_FOUND;
+    }
+
+    void PathFinder::heap_push( int index )
+    {
+      _heap.push_back( index );
+      _nodes[index].heap_index = static_cast<int>( _heap.size() - 1 );
+      heap_up( _nodes[index].heap_index );
+    }
+
+    int PathFinder::heap_pop()
+    {
+      int top = _heap.front();
+      _nodes[top].heap_index = -1;
+      int last = _heap.back();
+      _heap.pop_back();
+      if ( !_heap.empty() )
+      {
+        _heap[0] = last;
+        _nodes[last].heap_index = 0;
+        heap_down( 0 );
+      }
+      return top;
+    }
+
+    void PathFinder::heap_up( int pos )
+    {
+      int index = _heap[pos];
+      float f = _nodes[index].f;
+      while ( pos > 0 )
+      {
+        int parent = ( pos - 1 ) / 2;
+        if ( _nodes[_heap[parent]].f <= f )
+          break;
+        _heap[pos] = _heap[parent];
+        _nodes[_heap[pos]].heap_index = pos;
+        pos = parent;
+      }
+      _heap[pos] = index;
+      _nodes[index].heap_index = pos;
+    }
+
+    void PathFinder::heap_down( int pos )
+    {
+      int size = static_cast<int>( _heap.size() );
+      int index = _heap[pos];
+      float f = _nodes[index].f;
+      for ( ;; )
+      {
+        int child = pos * 2 + 1;
+        if ( child >= size )
+          break;
+        if ( child + 1 < size && _nodes[_heap[child + 1]].f < _nodes[_heap[child]].f )
+          ++child;
+        if ( f <= _nodes[_heap[child]].f )
+          break;
+        _heap[pos] = _heap[child];
+        _nodes[_heap[pos]].heap_index = pos;
+        pos = child;
+      }
+      _heap[pos] = index;
+      _nodes[index].heap_index = pos;
+    }
+
+    PathfindService::PathfindService( unsigned int threads ) :
+      _tasks(),
+      _threads()
+    {
+      for ( unsigned int i = 0; i < threads; ++i )
+        _threads.emplace_back( [this]() { run(); } );
+    }
+
+    PathfindService::~PathfindService()
+    {
+      _tasks.cancel();
+      for ( auto& thread : _threads )
+        thread.join();
+    }
+
+    void PathfindService::push( Task&& task )
+    {
+      _tasks.push_move( std::move( task ) );
+    }
+
+    void PathfindService::run() // executed inside an extra thread
+    {
+      threadhelp::ThreadRegister register_thread( "Pathfind" );
+      PathFinder finder;
+      for ( ;; )
+      {
+        try
+        {
+          Task task;
+          _tasks.pop_wait( &task );
+          task( finder );
+        }
+        catch ( Clib::message_queue<Task>::Canceled& )
+        {
+          break;
+        }
+        catch ( std::exception& ex )
+        {
+          ERROR_PRINT << "Pathfind thread exception: " << ex.what() << "\n";
+        }
+      }
+    }
+  }
+}
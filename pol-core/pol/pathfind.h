@@ -0,0 +1,161 @@
+/*
+History
+=======
+
+Notes
+=======
+A* search over the walkable tiles of a realm, used by FindPath.
+
+Nodes are stored in an arena owned by the PathFinder and looked up by their
+coordinates through a hash, the open list is a binary heap which knows the
+position of each node so a cheaper path updates a node in place.
+A PathFinder keeps its memory between searches; use one per thread.
+
+With a snapshot of the dynamic objects (snapshot_dynamics) a search only reads
+the map and statics of the realm besides the request itself, so it can run on
+one of the PathfindService threads while the world goes on.
+*/
+
+#ifndef POL_PATHFIND_H
+#define POL_PATHFIND_H
+
+#include "../clib/rawtypes.h"
+#include "../clib/message_queue.h"
+
+#include <boost/noncopyable.hpp>
+
+#include <functional>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "../plib/mapshape.h"
+
+namespace Pol {
+  namespace Plib {
+    class Realm;
+  }
+  namespace Core {
+    struct PathStep
+    {
+      short x;
+      short y;
+      short z;
+    };
+
+    // everything a search needs, filled by the caller
+    struct PathRequest
+    {
+      PathRequest();
+
+      Plib::Realm* realm;
+      unsigned short x1, y1;
+      short z1;
+      unsigned short x2, y2;
+      short z2;
+      // the search stays inside this box
+      short xL, xH, yL, yH;
+      bool doors_block;
+      // positions of mobiles which block the path
+      std::vector<PathStep> blockers;
+      // search the shapes of dynamics instead of the items and multis of the world
+      bool use_snapshot;
+      std::unordered_map<u32, Plib::MapShapeList> dynamics;
+    };
+
+    // copies the walk relevant shapes of the items and multis inside the box
+    // of the request, needs the world lock
+    void snapshot_dynamics( PathRequest& req );
+
+    class PathFinder : boost::noncopyable
+    {
+    public:
+      enum Result
+      {
+        PATH_FOUND,
+        PATH_NOT_FOUND,
+        PATH_OUT_OF_NODES
+      };
+
+      explicit PathFinder( unsigned int max_nodes = 1000 );
+
+      // fills path with the steps after the start position, the last step is the goal
+      Result find( const PathRequest& req, std::vector<PathStep>& path );
+
+      // statistics of the last search
+      unsigned int expanded_nodes() const;
+      unsigned int visited_nodes() const;
+
+      // key of PathRequest::dynamics
+      static u32 tile_key( int x, int y );
+
+    private:
+      struct Node
+      {
+        short x;
+        short y;
+        short z;
+        bool closed;
+        int parent;
+        int heap_index; // position in _heap, -1 if not in the open list
+        float g;
+        float f;
+      };
+
+      static u64 state_key( int x, int y, int z );
+
+      void reset( const PathRequest& req );
+      int add_node( short x, short y, short z );
+      bool walkheight( short x, short y, short oldz, short* newz );
+      bool is_blocking( short x, short y, short z ) const;
+      float estimate( const Node& node ) const;
+      bool is_goal( const Node& node ) const;
+      void expand( int index );
+
+      void heap_push( int index );
+      int heap_pop();
+      void heap_up( int pos );
+      void heap_down( int pos );
+
+      unsigned int _max_nodes;
+      const PathRequest* _req;
+      std::vector<Node> _nodes;
+      std::vector<int> _heap;
+      std::unordered_map<u64, int> _index;
+      std::unordered_map<u64, short> _walkcache;
+      std::unordered_multimap<u32, short> _blockers;
+      Plib::MapShapeList _shapes;
+      std::vector<const Plib::MapShape*> _possible_shapes;
+      unsigned int _expanded;
+      bool _out_of_nodes;
+    };
+
+    // threads running searches in the background, each with its own PathFinder.
+    // A task may only touch the world under the PolLock.
+    class PathfindService : boost::noncopyable
+    {
+    public:
+      typedef std::function<void( PathFinder& )> Task;
+
+      explicit PathfindService( unsigned int threads );
+      ~PathfindService(); // remaining tasks are dropped
+
+      void push( Task&& task );
+    private:
+      void run();
+
+      Clib::message_queue<Task> _tasks;
+      std::vector<std::thread> _threads;
+    };
+
+    inline unsigned int PathFinder::expanded_nodes() const
+    {
+      return _expanded;
+    }
+    inline unsigned int PathFinder::visited_nodes() const
+    {
+      return static_cast<unsigned int>( _nodes.size() );
+    }
+  }
+}
+#endif
@@ -666,9 +666,6 @@ namespace Pol {
       }
     }
 
-    void decay_thread( void* );
-    void decay_thread_shadow( void* );
-	void decay_single_thread( void*);
 
     template<class T>
     inline void Delete( T* p )
@@ -834,20 +831,7 @@ namespace Pol {
       if ( settingsManager.ssopt.decay_items )
       {
         checkpoint( "start decay thread" );
-#ifdef PERGON
-		threadhelp::start_thread( decay_single_thread, "Decay", nullptr );
-#else
-        std::vector<Plib::Realm*>::iterator itr;
-        for ( itr = gamestate.Realms.begin(); itr != gamestate.Realms.end(); ++itr )
-        {
-          std::ostringstream thname;
-          thname << "Decay_" << ( *itr )->name();
-          if ( ( *itr )->is_shadowrealm )
-            threadhelp::start_thread( decay_thread_shadow, thname.str().c_str(), (void*)( *itr ) );
-          else
-            threadhelp::start_thread( decay_thread, thname.str().c_str(), (void*)( *itr ) );
-        }
-#endif
+        threadhelp::start_thread( decay_thread, "Decay", nullptr );
       }
       else
       {
@@ -1008,7 +992,7 @@ namespace Pol {
       if ( Bscript::executor_count )
         tmp << "Remaining Executors: " << Bscript::executor_count << "\n";
       if ( Bscript::eobject_imp_count )
-        tmp << "Remaining script objectimps: " << Bscript::eobject_imp_count << "\n";
+        tmp << "Remaining script objectimps: " << static_cast<int>( Bscript::eobject_imp_count ) << "\n";
       INFO_PRINT << tmp.c_str();
     }
 
@@ -1411,8 +1395,7 @@ namespace Pol {
       else
         savetype = Plib::systemstate.config.shutdown_save_type;
 
-      // TODO: full save if incremental_saves_disabled ?
-      // otherwise could have really, really bad timewarps
+      // save_incremental() does a full save if incremental saves are disabled
       Tools::Timer<> timer;
       if ( savetype == Core::SAVE_FULL )
         Core::write_data( dirty, clean, elapsed_ms );
@@ -72,6 +72,23 @@ namespace Pol {
 		Plib::systemstate.config.check_integrity = true; // elem.remove_bool( "CheckIntegrity", true );
 		Plib::systemstate.config.count_resource_tiles = elem.remove_bool( "CountResourceTiles", false );
 		Plib::systemstate.config.multithread = elem.remove_ushort( "Multithread", 0 );
+		Plib::systemstate.config.script_worker_threads = elem.remove_ushort( "ScriptWorkerThreads", 0 );
+#ifndef PARALLEL_SCRIPTS
+		if ( Plib::systemstate.config.script_worker_threads )
+		{
+		  POLLOG_ERROR << "ScriptWorkerThreads needs a core compiled with PARALLEL_SCRIPTS, ignored.\n";
+		  Plib::systemstate.config.script_worker_threads = 0;
+		}
+#endif
+		Plib::systemstate.config.pathfinding_threads = elem.remove_ushort( "PathfindingThreads", 0 );
+		Plib::systemstate.config.network_io_threads = elem.remove_ushort( "NetworkIoThreads", 0 );
+#ifndef __linux__
+		if ( Plib::systemstate.config.network_io_threads )
+		{
+		  POLLOG_ERROR << "NetworkIoThreads is only supported on Linux, ignored.\n";
+		  Plib::systemstate.config.network_io_threads = 0;
+		}
+#endif
 		Plib::systemstate.config.web_server = elem.remove_bool( "WebServer", false );
 		Plib::systemstate.config.web_server_port = elem.remove_ushort( "WebServerPort", 8080 );
 
@@ -108,6 +125,15 @@ namespace Pol {
 	  Plib::systemstate.config.watch_sysload = elem.remove_bool( "WatchSysLoad", false );
 	  Plib::systemstate.config.log_sysload = elem.remove_bool( "LogSysLoad", false );
 	  Plib::systemstate.config.inhibit_saves = elem.remove_bool( "InhibitSaves", false );
+	  Plib::systemstate.config.snapshot_save = elem.remove_bool( "SnapshotSave", false );
+#ifndef __linux__
+	  if ( Plib::systemstate.config.snapshot_save )
+	  {
+		POLLOG_ERROR << "SnapshotSave is only supported on Linux, ignored.\n";
+		Plib::systemstate.config.snapshot_save = false;
+	  }
+#endif
+	  Plib::systemstate.config.binary_saves = elem.remove_bool( "BinarySaves", false );
 	  Plib::systemstate.config.log_script_cycles = elem.remove_bool( "LogScriptCycles", false );
 	  Plib::systemstate.config.web_server_local_only = elem.remove_bool( "WebServerLocalOnly", true );
 	  Plib::systemstate.config.web_server_debug = elem.remove_ushort( "WebServerDebug", 0 );
@@ -119,6 +145,7 @@ namespace Pol {
 
 	  Plib::systemstate.config.enable_secure_trading = elem.remove_bool( "EnableSecureTrading", false );
 	  Plib::systemstate.config.runaway_script_threshold = elem.remove_ulong( "RunawayScriptThreshold", 5000 );
+	  Plib::systemstate.config.script_pass_time_limit = elem.remove_ulong( "ScriptPassTimeLimit", 20000 );
 
 	  Plib::systemstate.config.min_cmdlvl_ignore_inactivity = elem.remove_ushort( "MinCmdLvlToIgnoreInactivity", 1 );
 	  Plib::systemstate.config.inactivity_warning_timeout = elem.remove_ushort( "InactivityWarningTimeout", 4 );
@@ -39,10 +39,15 @@ namespace Pol {
 	  bool watch_mapcache;
 	  bool check_integrity;
 	  bool inhibit_saves;
+	  bool snapshot_save;
+	  bool binary_saves;
 	  bool log_script_cycles;
 	  bool count_resource_tiles;
 	  Crypt::TCryptInfo client_encryption_version;
 	  unsigned short multithread;
+	  unsigned short script_worker_threads;
+	  unsigned short pathfinding_threads;
+	  unsigned short network_io_threads;
 	  bool web_server;
 	  unsigned short web_server_port;
 	  bool web_server_local_only;
@@ -53,6 +58,7 @@ namespace Pol {
 	  bool require_spellbooks;
 	  bool enable_secure_trading;
 	  unsigned int runaway_script_threshold;
+	  unsigned int script_pass_time_limit; // microseconds, 0 = run every script each pass
 	  bool ignore_load_errors;
 	  unsigned short min_cmdlvl_ignore_inactivity;
 	  unsigned short inactivity_warning_timeout;
@@ -18,7 +18,7 @@ Notes
 
 namespace Pol {
   namespace Core {
-    int write_pol_static_files( const std::string& realm );
+    int write_pol_static_files( const std::string& realm, unsigned threads = 1, bool incremental = false );
     void load_pol_static_files();
     void readstatics2( StaticList& vec, unsigned short x, unsigned short y );
   }
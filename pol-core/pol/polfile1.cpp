@@ -4,6 +4,8 @@ History
 2005/03/01 Shinigami: extended error message for passert(pstat[i].graphic < 0x4000)
 2005/07/16 Shinigami: added uoconvert.cfg flag ShowIllegalGraphicWarning
 2009/12/02 Turley:    added config.max_tile_id - Tomi
+2026/10/17 agent:     write_pol_static_files: stripes are calculated on worker threads,
+                      incremental mode copies the unchanged blocks of the last conversion
 
 
 Notes
@@ -13,6 +15,7 @@ Notes
 
 #include "polfile.h"
 
+#include "blockchecksums.h"
 #include "polcfg.h"
 #include "uofilei.h"
 #include "uofile.h"
@@ -31,6 +34,7 @@ Notes
 #include "../clib/random.h"
 #include "../clib/stlutil.h"
 #include "../clib/strutil.h"
+#include "../clib/threadhelp.h"
 #include "../clib/wallclock.h"
 #include "../clib/logfacility.h"
 
@@ -39,6 +43,9 @@ Notes
 #endif
 
 #include <cstdio>
+#include <deque>
+#include <future>
+#include <memory>
 
 #ifdef _MSC_VER
 #pragma warning(disable:4996) // disable deprecation warning fopen
@@ -72,7 +79,74 @@ namespace Pol {
       return false;
     }
 
-    int write_pol_static_files( const std::string& realm )
+    // statics of one stripe (row of static blocks)
+    struct StaticStripe
+    {
+      std::vector<std::vector<Plib::STATIC_ENTRY>> blocks;
+      unsigned int statics;
+      unsigned int duplicates;
+      unsigned int illegales;
+      StaticStripe() : blocks(), statics( 0 ), duplicates( 0 ), illegales( 0 ) {}
+    };
+
+    void read_static_block( u16 x, u16 y, std::vector<Plib::STATIC_ENTRY>& vec, StaticStripe& stripe )
+    {
+      std::vector<USTRUCT_STATIC> pstat;
+      int num;
+      readstaticblock( &pstat, &num, x, y );
+      for ( int i = 0; i < num; ++i )
+      {
+        if ( pstat[i].graphic <= Plib::systemstate.config.max_tile_id )
+        {
+          if ( !newstat_dont_add( vec, &pstat[i] ) )
+          {
+            Plib::STATIC_ENTRY nrec;
+
+            nrec.objtype = pstat[i].graphic; // TODO map these?
+            nrec.xy = ( pstat[i].x_offset << 4 ) | pstat[i].y_offset;
+            nrec.z = pstat[i].z;
+            nrec.hue = pstat[i].hue;
+            vec.push_back( nrec );
+            ++stripe.statics;
+          }
+          else
+          {
+            ++stripe.duplicates;
+          }
+        }
+        else
+        {
+          ++stripe.illegales;
+
+          if ( cfg_show_illegal_graphic_warning )
+            INFO_PRINT << " Warning: Item with illegal Graphic 0x" << fmt::hexu(pstat[i].graphic)
+            << " in Area " << x << " " << y << " " << ( x + Plib::STATICBLOCK_CHUNK - 1 )
+            << " " << ( y + Plib::STATICBLOCK_CHUNK - 1 ) << "\n";
+        }
+      }
+    }
+
+    // statidx/statics of the last conversion, to copy the unchanged blocks
+    bool read_old_static_files( const std::string& statidx_dat, const std::string& statics_dat,
+                                std::vector<Plib::STATIC_INDEX>& index, std::vector<Plib::STATIC_ENTRY>& entries )
+    {
+      if ( !Clib::FileExists( statidx_dat ) || !Clib::FileExists( statics_dat ) )
+        return false;
+      index.resize( Clib::filesize( statidx_dat.c_str() ) / sizeof( Plib::STATIC_INDEX ) );
+      entries.resize( Clib::filesize( statics_dat.c_str() ) / sizeof( Plib::STATIC_ENTRY ) );
+      bool ok = !index.empty();
+      FILE* fp = fopen( statidx_dat.c_str(), "rb" );
+      ok = ok && fp != NULL && fread( &index[0], sizeof( Plib::STATIC_INDEX ) * index.size(), 1, fp ) == 1;
+      if ( fp != NULL )
+        fclose( fp );
+      fp = fopen( statics_dat.c_str(), "rb" );
+      ok = ok && fp != NULL && ( entries.empty() || fread( &entries[0], sizeof( Plib::STATIC_ENTRY ) * entries.size(), 1, fp ) == 1 );
+      if ( fp != NULL )
+        fclose( fp );
+      return ok && index.back().index == entries.size();
+    }
+
+    int write_pol_static_files( const std::string& realm, unsigned threads, bool incremental )
     {
       unsigned int duplicates = 0;
       unsigned int illegales = 0;
@@ -87,6 +161,24 @@ namespace Pol {
       std::string statics_dat = directory + "statics.dat";
       std::string statidx_tmp = directory + "statidx.tmp";
       std::string statics_tmp = directory + "statics.tmp";
+      std::string checksum_file = directory + "staticscrc.dat";
+
+      Plib::RealmDescriptor descriptor = Plib::RealmDescriptor::Load( realm );
+      unsigned x_blocks = descriptor.width / Plib::STATICBLOCK_CHUNK;
+      unsigned y_blocks = descriptor.height / Plib::STATICBLOCK_CHUNK;
+
+      // the statics only depend on the uo statics, tiledata and max_tile_id
+      // (calculating the checksums also loads the statics before the workers need them)
+      BlockChecksums checksums, old_checksums;
+      u32 settings = BlockChecksums::settings_checksum( std::vector<u32>() );
+      checksums.calculate( static_cast<unsigned short>( descriptor.width ), static_cast<unsigned short>( descriptor.height ), false, true, settings );
+      std::vector<Plib::STATIC_INDEX> old_index;
+      std::vector<Plib::STATIC_ENTRY> old_entries;
+      bool update = incremental &&
+        old_checksums.load( checksum_file, static_cast<unsigned short>( descriptor.width ), static_cast<unsigned short>( descriptor.height ), settings ) &&
+        read_old_static_files( statidx_dat, statics_dat, old_index, old_entries ) &&
+        old_index.size() == x_blocks * y_blocks + 1;
+
       Clib::RemoveFile( statidx_dat );
       Clib::RemoveFile( statics_dat );
       Clib::RemoveFile( statidx_tmp );
@@ -95,69 +187,89 @@ namespace Pol {
       FILE* fidx = fopen( statidx_tmp.c_str(), "wb" );
       FILE* fdat = fopen( statics_tmp.c_str(), "wb" );
 
-      Plib::RealmDescriptor descriptor = Plib::RealmDescriptor::Load( realm );
+      unsigned int changed_blocks = 0;
+      if ( update )
+      {
+        for ( unsigned x_block = 0; x_block < x_blocks; ++x_block )
+        {
+          for ( unsigned y_block = 0; y_block < y_blocks; ++y_block )
+          {
+            if ( checksums.changed( old_checksums, x_block, y_block ) )
+              ++changed_blocks;
+          }
+        }
+        INFO_PRINT << "Source data changed in " << changed_blocks << " of " << x_blocks * y_blocks << " blocks.\n";
+      }
 
-      int lastprogress = -1;
-      unsigned int index = 0;
-      for ( u16 y = 0; y < descriptor.height; y += Plib::STATICBLOCK_CHUNK )
+      // every stripe is calculated by a worker thread, the main thread writes them in order
+      auto calc_stripe = [&]( unsigned y_block, StaticStripe& stripe )
       {
-        int progress = y * 100L / descriptor.height;
-        if ( progress != lastprogress )
+        stripe.blocks.resize( x_blocks );
+        for ( unsigned x_block = 0; x_block < x_blocks; ++x_block )
         {
-          INFO_PRINT << "\rCreating POL statics files: " << progress << "%";
-          lastprogress = progress;
+          std::vector<Plib::STATIC_ENTRY>& vec = stripe.blocks[x_block];
+          if ( update && !checksums.changed( old_checksums, x_block, y_block ) )
+          {
+            unsigned old_block = y_block * x_blocks + x_block;
+            vec.assign( old_entries.begin() + old_index[old_block].index, old_entries.begin() + old_index[old_block + 1].index );
+            stripe.statics += static_cast<unsigned int>( vec.size() );
+          }
+          else
+          {
+            read_static_block( static_cast<u16>( x_block * Plib::STATICBLOCK_CHUNK ), static_cast<u16>( y_block * Plib::STATICBLOCK_CHUNK ), vec, stripe );
+          }
         }
-        for ( u16 x = 0; x < descriptor.width; x += Plib::STATICBLOCK_CHUNK )
+      };
+
+      int lastprogress = -1;
+      unsigned int index = 0;
+      std::deque<std::pair<std::shared_ptr<StaticStripe>, std::future<bool>>> pending;
+      {
+        threadhelp::TaskThreadPool pool( threads, "statics" );
+        unsigned next_stripe = 0;
+        for ( unsigned y_block = 0; y_block < y_blocks; ++y_block )
         {
-          Plib::STATIC_INDEX idx;
-          idx.index = index;
-          fwrite( &idx, sizeof idx, 1, fidx );
-
-          std::vector<USTRUCT_STATIC> pstat;
-          int num;
-          std::vector<Plib::STATIC_ENTRY> vec;
-          readstaticblock( &pstat, &num, x, y );
-          for ( int i = 0; i < num; ++i )
+          while ( next_stripe < y_blocks && pending.size() < threads * 2 )
           {
-            if ( pstat[i].graphic <= Plib::systemstate.config.max_tile_id )
-            {
-              if ( !newstat_dont_add( vec, &pstat[i] ) )
-              {
-                Plib::STATIC_ENTRY nrec;
-
-                nrec.objtype = pstat[i].graphic; // TODO map these?
-                nrec.xy = ( pstat[i].x_offset << 4 ) | pstat[i].y_offset;
-                nrec.z = pstat[i].z;
-                nrec.hue = pstat[i].hue;
-                vec.push_back( nrec );
-                ++statics;
-              }
-              else
-              {
-                ++duplicates;
-              }
-            }
-            else
+            std::shared_ptr<StaticStripe> stripe( new StaticStripe );
+            unsigned stripe_y = next_stripe;
+            auto future = pool.checked_push( [&calc_stripe, stripe, stripe_y]()
             {
-              ++illegales;
+              calc_stripe( stripe_y, *stripe );
+            } );
+            pending.push_back( std::make_pair( stripe, std::move( future ) ) );
+            ++next_stripe;
+          }
 
-              if ( cfg_show_illegal_graphic_warning )
-                INFO_PRINT << " Warning: Item with illegal Graphic 0x" << fmt::hexu(pstat[i].graphic)
-                << " in Area " << x << " " << y << " " << ( x + Plib::STATICBLOCK_CHUNK - 1 )
-                << " " << ( y + Plib::STATICBLOCK_CHUNK - 1 ) << "\n";
-            }
+          int progress = y_block * 100L / y_blocks;
+          if ( progress != lastprogress )
+          {
+            INFO_PRINT << "\rCreating POL statics files: " << progress << "%";
+            lastprogress = progress;
           }
-          for ( unsigned i = 0; i < vec.size(); ++i )
+
+          pending.front().second.get(); // rethrows exceptions of the worker
+          const StaticStripe& stripe = *pending.front().first;
+          statics += stripe.statics;
+          duplicates += stripe.duplicates;
+          illegales += stripe.illegales;
+          for ( const auto& vec : stripe.blocks )
           {
-            fwrite( &vec[i], sizeof( Plib::STATIC_ENTRY ), 1, fdat );
-            ++index;
+            Plib::STATIC_INDEX idx;
+            idx.index = index;
+            fwrite( &idx, sizeof idx, 1, fidx );
+
+            if ( !vec.empty() )
+              fwrite( &vec[0], sizeof( Plib::STATIC_ENTRY ), vec.size(), fdat );
+            index += static_cast<unsigned int>( vec.size() );
+            if ( vec.empty() )
+              ++empties;
+            else
+              ++nonempties;
+            if ( vec.size() > maxcount )
+              maxcount = static_cast<unsigned int>( vec.size() );
           }
-          if ( vec.empty() )
-            ++empties;
-          else
-            ++nonempties;
-          if ( vec.size() > maxcount )
-            maxcount = static_cast<unsigned int>( vec.size() );
+          pending.pop_front();
         }
       }
       Plib::STATIC_INDEX idx;
@@ -172,10 +284,13 @@ namespace Pol {
         INFO_PRINT << "\rCreating POL statics files: Complete\n";
         rename( statidx_tmp.c_str(), statidx_dat.c_str() );
         rename( statics_tmp.c_str(), statics_dat.c_str() );
+        if ( !checksums.save( checksum_file ) )
+          ERROR_PRINT << "Unable to write " << checksum_file << "\n";
       }
       else
       {
         INFO_PRINT << "\rCreating POL statics files: Error\n";
+        Clib::RemoveFile( checksum_file );
       }
 
 
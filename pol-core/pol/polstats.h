@@ -19,6 +19,8 @@ namespace Pol {
 	public:
 	  u64 bytes_received;
 	  u64 bytes_sent;
+	  u64 packets_sent;
+	  u64 send_calls; // packets_sent - send_calls: packets saved by coalescing
 	};
 	//extern PolStats auxstats; (Not yet... -- Nando)
 	//extern PolStats webstats;
@@ -43,6 +43,7 @@ namespace Pol {
 	  DEF_PROFILEVAR( scripts_ontime );
 	  DEF_PROFILEVAR( scripts_late );
 	  DEF_PROFILEVAR( scripts_late_ticks );
+	  DEF_PROFILEVAR( script_passes_timelimit );
 	  DEF_PROFILEVAR( scheduler_passes );
 	  DEF_PROFILEVAR( noactivity_scheduler_passes );
 	  DEF_PROFILEVAR( npc_searches );
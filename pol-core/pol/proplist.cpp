@@ -2,6 +2,8 @@
 History
 =======
 2005/05/25 Shinigami: added PropertyList::printProperties( ConfigElem& elem )
+2026/10/17 agent:     values are kept parsed (CPropValue), packing only for save and txt output
+                      added PropertyList::getpropimp/setpropimp
 
 Notes
 =======
@@ -17,6 +19,8 @@ Notes
 #include "../clib/streamsaver.h"
 
 #include "../bscript/berror.h"
+#include "../bscript/bstruct.h"
+#include "../bscript/dict.h"
 #include "../bscript/execmodl.h"
 #include "../bscript/executor.h"
 #include "../bscript/impstr.h"
@@ -28,6 +32,110 @@ Notes
 namespace Pol {
   namespace Core {
 
+	CPropValue::CPropValue( const std::string& packed ) :
+	  _packed( packed ),
+	  _imp()
+	{}
+
+	CPropValue::CPropValue( Bscript::BObjectImp* imp ) :
+	  _packed(),
+	  _imp( imp )
+	{}
+
+	CPropValue::CPropValue( const CPropValue& other ) :
+	  _packed( other._packed ),
+	  _imp( other._imp )
+	{}
+
+	CPropValue& CPropValue::operator=( const CPropValue& other )
+	{
+	  _packed = other._packed;
+	  _imp = other._imp;
+	  return *this;
+	}
+
+	CPropValue::~CPropValue()
+	{}
+
+	std::string CPropValue::packed() const
+	{
+	  if ( _imp.get() == NULL || !_packed.get().empty() )
+		return _packed;
+	  return _imp->pack();
+	}
+
+	Bscript::BObjectImp* CPropValue::copy() const
+	{
+	  if ( _imp.get() == NULL )
+	  {
+		_imp.set( Bscript::BObjectImp::unpack( _packed.get().c_str() ) );
+		// only drop the packed form if packing the parsed value gives it back
+		if ( storesParsed( _imp.get() ) )
+		  _packed = boost_utils::cprop_value_flystring();
+	  }
+	  return _imp->copy();
+	}
+
+	bool CPropValue::operator==( const CPropValue& other ) const
+	{
+	  if ( _imp.get() != NULL && _imp == other._imp )
+		return true;
+	  return packed() == other.packed();
+	}
+
+	size_t CPropValue::estimatedSize() const
+	{
+	  size_t size = sizeof( CPropValue );
+	  if ( _imp.get() != NULL )
+		size += _imp->sizeEstimate();
+	  return size;
+	}
+
+	// true for values which BObjectImp::unpack( pack() ) gives back unchanged,
+	// everything else (reals, object references, errors) is stored packed
+	bool CPropValue::storesParsed( const Bscript::BObjectImp* imp )
+	{
+	  using namespace Bscript;
+	  switch ( imp->type() )
+	  {
+		case BObjectImp::OTLong:
+		case BObjectImp::OTString:
+		  return true;
+		case BObjectImp::OTArray:
+		{
+		  const ObjArray* arr = static_cast<const ObjArray*>( imp );
+		  if ( !arr->name_arr.empty() )
+			return false;
+		  for ( const auto& elem : arr->ref_arr )
+		  {
+			if ( elem.get() == NULL || !storesParsed( elem->impptr() ) )
+			  return false;
+		  }
+		  return true;
+		}
+		case BObjectImp::OTStruct:
+		{
+		  for ( const auto& content : static_cast<const BStruct*>( imp )->contents() )
+		  {
+			if ( !storesParsed( content.second->impptr() ) )
+			  return false;
+		  }
+		  return true;
+		}
+		case BObjectImp::OTDictionary:
+		{
+		  for ( const auto& content : static_cast<const BDictionary*>( imp )->contents() )
+		  {
+			if ( !storesParsed( content.first.impptr() ) || !storesParsed( content.second->impptr() ) )
+			  return false;
+		  }
+		  return true;
+		}
+		default:
+		  return false;
+	  }
+	}
+
 	PropertyList::PropertyList()
 	{}
 
@@ -39,7 +147,9 @@ namespace Pol {
     size_t PropertyList::estimatedSize() const
     {
       size_t size = sizeof( PropertyList );
-      size += properties.size( ) * ( sizeof( boost_utils::cprop_name_flystring ) + sizeof( boost_utils::cprop_value_flystring ) + ( sizeof(void*)* 3 + 1 ) / 2 );
+      size += properties.size( ) * ( sizeof( boost_utils::cprop_name_flystring ) + ( sizeof(void*)* 3 + 1 ) / 2 );
+      for ( const auto& prop : properties )
+        size += prop.second.estimatedSize();
       return size;
     }
 
@@ -52,13 +162,39 @@ namespace Pol {
 	  }
 	  else
 	  {
-		propval = ( *itr ).second;
+		propval = ( *itr ).second.packed();
 		return true;
 	  }
 	}
 	void PropertyList::setprop( const std::string& propname, const std::string& propvalue )
 	{
-      properties[boost_utils::cprop_name_flystring( propname )] = propvalue;
+      setvalue( boost_utils::cprop_name_flystring( propname ), CPropValue( propvalue ) );
+	}
+
+	// returns a new copy of the value, or NULL if the property does not exist
+	Bscript::BObjectImp* PropertyList::getpropimp( const std::string& propname ) const
+	{
+      Properties::const_iterator itr = properties.find( boost_utils::cprop_name_flystring( propname ) );
+	  if ( itr == properties.end() )
+		return NULL;
+	  return itr->second.copy();
+	}
+
+	void PropertyList::setpropimp( const std::string& propname, const Bscript::BObjectImp& propvalue )
+	{
+	  if ( CPropValue::storesParsed( &propvalue ) )
+		setvalue( boost_utils::cprop_name_flystring( propname ), CPropValue( propvalue.copy() ) );
+	  else
+		setvalue( boost_utils::cprop_name_flystring( propname ), CPropValue( propvalue.pack() ) );
+	}
+
+	void PropertyList::setvalue( const boost_utils::cprop_name_flystring& propname, const CPropValue& value )
+	{
+	  Properties::iterator itr = properties.lower_bound( propname );
+	  if ( itr != properties.end() && !( properties.key_comp()( propname, itr->first ) ) )
+		itr->second = value;
+	  else
+		properties.insert( itr, Properties::value_type( propname, value ) );
 	}
 
 	void PropertyList::eraseprop( const std::string& propname )
@@ -96,7 +232,7 @@ namespace Pol {
 		const std::string& first = prop.first;
 		if ( first[0] != '#' )
 		{
-		  sw() << "\tCProp\t" << first << " " << prop.second.get() << pf_endl;
+		  sw() << "\tCProp\t" << first << " " << prop.second.packed() << pf_endl;
 		}
 	  }
 	}
@@ -107,7 +243,7 @@ namespace Pol {
 		const std::string& first = prop.first;
 		if ( first[0] != '#' )
 		{
-		  elem.add_prop( "CProp", ( first + "\t" + prop.second.get() ).c_str() );
+		  elem.add_prop( "CProp", ( first + "\t" + prop.second.packed() ).c_str() );
 		}
 	  }
 	}
@@ -119,7 +255,7 @@ namespace Pol {
 		const std::string& first = prop.first;
 		if ( first[0] != '#' )
 		{
-		  sw() << "\t" << first << " " << prop.second.get() << pf_endl;
+		  sw() << "\t" << first << " " << prop.second.packed() << pf_endl;
 		}
 	  }
 	}
@@ -191,11 +327,11 @@ namespace Pol {
 		  const String* propname_str;
 		  if ( !ex.getStringParam( 0, propname_str ) )
 			return new BError( "Invalid parameter type" );
-		  std::string val;
-		  if ( !proplist.getprop( propname_str->value(), val ) )
+		  Bscript::BObjectImp* val = proplist.getpropimp( propname_str->value() );
+		  if ( val == NULL )
 			return new BError( "Property not found" );
 
-		  return Bscript::BObjectImp::unpack( val.c_str() );
+		  return val;
 		}
 
 		case MTH_SETPROP:
@@ -212,7 +348,7 @@ namespace Pol {
             POLLOG.Format( "wtf, setprop w/ an error '{}' PC:{}\n" ) << ex.scriptname().c_str() << ex.PC;
 		  }
           std::string propname = propname_str->value();
-		  proplist.setprop( propname, propval->pack() );
+		  proplist.setpropimp( propname, *propval );
 		  if ( propname[0] != '#' )
 			changed = true;
 		  return new BLong( 1 );
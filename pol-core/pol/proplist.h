@@ -2,6 +2,8 @@
 History
 =======
 2005/05/25 Shinigami: added PropertyList::printProperties( ConfigElem& elem )
+2026/10/17 agent:     values are kept parsed (CPropValue), packing only for save and txt output
+                      added PropertyList::getpropimp/setpropimp
 
 Notes
 =======
@@ -12,6 +14,7 @@ Notes
 #define PROPLIST_H
 
 #include "../clib/boostutils.h"
+#include "../clib/refptr.h"
 
 #include <boost/flyweight.hpp>
 
@@ -31,6 +34,29 @@ namespace Pol {
   }
   namespace Core {
 
+	// A single cprop value. Values read from the data files stay packed until a
+	// script asks for them, values set by scripts are stored parsed. A parsed value
+	// is never modified, copied lists share it and getpropimp() hands out copies.
+	class CPropValue
+	{
+	public:
+	  explicit CPropValue( const std::string& packed );
+	  explicit CPropValue( Bscript::BObjectImp* imp ); // takes ownership
+	  CPropValue( const CPropValue& );
+	  CPropValue& operator=( const CPropValue& );
+	  ~CPropValue();
+
+	  std::string packed() const;
+	  Bscript::BObjectImp* copy() const;
+	  bool operator==( const CPropValue& ) const;
+	  size_t estimatedSize() const;
+
+	  static bool storesParsed( const Bscript::BObjectImp* imp );
+	private:
+	  mutable boost_utils::cprop_value_flystring _packed;
+	  mutable ref_ptr<Bscript::BObjectImp> _imp;
+	};
+
 	class PropertyList
 	{
 	public:
@@ -38,6 +64,8 @@ namespace Pol {
 	  PropertyList( const PropertyList& );  //dave added 1/26/3
 	  bool getprop( const std::string& propname, std::string& propvalue ) const;
 	  void setprop( const std::string& propname, const std::string& propvalue );
+	  Bscript::BObjectImp* getpropimp( const std::string& propname ) const;
+	  void setpropimp( const std::string& propname, const Bscript::BObjectImp& propvalue );
 	  void eraseprop( const std::string& propname );
 	  void copyprops( const PropertyList& proplist );
 	  void getpropnames( std::vector< std::string >& propnames ) const;
@@ -55,13 +83,15 @@ namespace Pol {
 	  PropertyList& operator-( const std::set<std::string>& );  //dave added 1/26/3
 	  void operator-=( const std::set<std::string>& );  //dave added 1/26/3
 	protected:
-      typedef std::map<boost_utils::cprop_name_flystring, boost_utils::cprop_value_flystring> Properties;
+      typedef std::map<boost_utils::cprop_name_flystring, CPropValue> Properties;
 
 	  Properties properties;
 
 	private:
 	  friend class UObjectHelper;
 
+	  void setvalue( const boost_utils::cprop_name_flystring& propname, const CPropValue& value );
+
 	  // not implemented
 	  PropertyList& operator=( const PropertyList& );
 	};
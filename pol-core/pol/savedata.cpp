@@ -15,6 +15,7 @@ Notes
 #include "loaddata.h"
 #include "polcfg.h"
 #include "storage.h"
+#include "uimport.h"
 #include "globals/uvars.h"
 #include "globals/object_storage.h"
 
@@ -148,8 +149,7 @@ namespace Pol {
       ObjectHash::hs::const_iterator citr = objStorageManager.objecthash.begin(), end = objStorageManager.objecthash.end();
       for ( ; citr != end; ++citr )
       {
-        const UObjectRef& ref = ( *citr ).second;
-        const UObject* obj = ref.get();
+        const UObject* obj = citr->get();
 
         auto id = Items::find_itemdesc( obj->objtype_ );
         if ( !id.save_on_exit )
@@ -247,8 +247,14 @@ namespace Pol {
         return -1;
       }
 
+      // a running snapshot save owns the incremental files until it finished
+      finish_snapshot_save();
       if ( objStorageManager.incremental_saves_disabled )
-        throw std::runtime_error( "Incremental saves are disabled until the next full save, due to a previous incremental save failure (dirty flags are inconsistent)" );
+      {
+        // the dirty flags are inconsistent after a failed incremental or snapshot save
+        POLLOG_INFO << "Incremental saves are disabled until the next full save, saving everything.\n";
+        return write_data( dirty, clean, elapsed_ms );
+      }
 
       try
       {
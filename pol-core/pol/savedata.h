@@ -65,6 +65,7 @@ namespace Pol {
 
 	bool commit( const std::string& basename );
 	void commit_incremental_saves();
+	void finish_snapshot_save();
 	bool should_write_data();
   }
 }
@@ -10,6 +10,7 @@ History
 2009/09/03 MuadDib:   Relocation of boat related cpp/h
 2010/02/04 Turley:    "Event queue full" cerr only if loglevel>=11
                       polcfg.discard_old_events discards oldest event if queue is full
+2026/10/17 agent:     add_common_exmods() only registers factories, the modules are created when a script uses them
 
 Notes
 =======
@@ -63,12 +64,18 @@ Notes
 #include "../clib/passert.h"
 #include "../clib/stlutil.h"
 #include "../clib/strutil.h"
+#include "../clib/threadhelp.h"
 #include "../clib/unicode.h"
 
 #include "../plib/systemstate.h"
 
+#include <chrono>
 #include <ctime>
 #include <stdexcept>
+#ifdef PARALLEL_SCRIPTS
+#include <atomic>
+#include <future>
+#endif
 
 namespace Pol {
   namespace Core {
@@ -98,6 +105,13 @@ namespace Pol {
       }
       *count += scriptEngineInternalManager.runlist.size();
 
+      size += 3 * sizeof(UOExecutor**)+scriptEngineInternalManager.interactive_runlist.size() * sizeof( UOExecutor* );
+      for ( const auto& exec : scriptEngineInternalManager.interactive_runlist )
+      {
+        size += exec->sizeEstimate();
+      }
+      *count += scriptEngineInternalManager.interactive_runlist.size();
+
       size += 3 * sizeof(UOExecutor**)+scriptEngineInternalManager.ranlist.size() * sizeof( UOExecutor* );
       for ( const auto& exec : scriptEngineInternalManager.ranlist )
       {
@@ -143,14 +157,116 @@ namespace Pol {
     }
 
 
+#if defined(PARALLEL_SCRIPTS) && !defined(ESCRIPT_PROFILE)
+	// executes the instructions of ex which do not touch the world, stops at the first
+	// instruction which needs the world lock or when the runaway check has to be done.
+	// called by the script worker threads, the remaining slice is run by run_ready()
+	void run_slice_unlocked( UOExecutor* ex )
+	{
+	  int insleft = ex->slice_left;
+	  while ( insleft > 0 && ex->runnable() && ex->next_instr_threadsafe() )
+	  {
+		if ( ex->instr_cycles + 1 == ex->warn_runaway_on_cycle )
+		  break;
+		++ex->instr_cycles;
+		ex->execInstrUnlocked();
+		--insleft;
+	  }
+	  ex->slice_left = insleft;
+	}
+
+	// parallel part of run_ready(): the scripts thread holds the world lock, so
+	// nothing else changes the world while the worker threads execute the pure
+	// instructions of the runlist. Everything else stays serial.
+	// Like the serial part no new slice is started once script_pass_time_limit is used up.
+	void run_ready_unlocked( std::chrono::steady_clock::time_point pass_start )
+	{
+	  const unsigned int workers = Plib::systemstate.config.script_worker_threads;
+	  ExecList& runlist = scriptEngineInternalManager.runlist;
+	  if ( !workers || runlist.size() <= workers )
+		return;
+
+	  std::vector<UOExecutor*> slices;
+	  slices.reserve( runlist.size() );
+	  for ( UOExecutor* ex : runlist )
+	  {
+		if ( ex->os_module->critical || ex->os_module->blocked() || !ex->runnable() )
+		  continue;
+		int insleft = ex->os_module->priority / scriptEngineInternalManager.priority_divide;
+		ex->slice_left = insleft ? insleft : 1;
+		slices.push_back( ex );
+	  }
+	  if ( slices.empty() )
+		return;
+
+	  if ( scriptEngineInternalManager.worker_pool == nullptr )
+		scriptEngineInternalManager.worker_pool.reset( new threadhelp::TaskThreadPool( workers, "ScriptWorker" ) );
+
+	  const unsigned int time_limit = Plib::systemstate.config.script_pass_time_limit;
+	  std::atomic<size_t> next( 0 );
+	  auto work = [&]()
+	  {
+		for ( size_t i = next++; i < slices.size(); i = next++ )
+		{
+		  if ( time_limit &&
+			   std::chrono::duration_cast<std::chrono::microseconds>( std::chrono::steady_clock::now() - pass_start ).count() >= time_limit )
+			break;
+		  run_slice_unlocked( slices[i] );
+		}
+	  };
+	  std::vector<std::future<bool>> results;
+	  for ( unsigned int i = 0; i < workers; ++i )
+		results.push_back( scriptEngineInternalManager.worker_pool->checked_push( work ) );
+	  work();
+	  for ( auto& result : results )
+	  {
+		try
+		{
+		  result.get();
+		}
+		catch ( std::exception& ex )
+		{
+		  POLLOG_ERROR << "Exception in script worker thread: " << ex.what() << "\n";
+		}
+	  }
+	  for ( UOExecutor* ex : slices )
+		ex->add_unlocked_cycles();
+	}
+#endif
+
 	void run_ready()
 	{
 	  THREAD_CHECKPOINT( scripts, 110 );
-	  while ( !scriptEngineInternalManager.runlist.empty() )
+	  const unsigned int time_limit = Plib::systemstate.config.script_pass_time_limit;
+	  const auto pass_start = std::chrono::steady_clock::now();
+#if defined(PARALLEL_SCRIPTS) && !defined(ESCRIPT_PROFILE)
+	  run_ready_unlocked( pass_start );
+#endif
+	  for ( ;; )
 	  {
-		ExecList::iterator itr = scriptEngineInternalManager.runlist.begin();
-		UOExecutor* ex = *itr;
-		scriptEngineInternalManager.runlist.pop_front(); // remove it directly, since itr can get invalid during execution
+		UOExecutor* ex;
+		// scripts of players always run first, they get one slice each pass
+		// and are moved to the normal ranlist if they are still runnable afterwards
+		if ( !scriptEngineInternalManager.interactive_runlist.empty() )
+		{
+		  ex = scriptEngineInternalManager.interactive_runlist.front();
+		  scriptEngineInternalManager.interactive_runlist.pop_front();
+		}
+		else
+		{
+		  if ( scriptEngineInternalManager.runlist.empty() )
+			break;
+		  // don't let a burst of background scripts keep the world locked,
+		  // the rest is run first during the next pass
+		  if ( time_limit &&
+			   std::chrono::duration_cast<std::chrono::microseconds>( std::chrono::steady_clock::now() - pass_start ).count() >= time_limit )
+		  {
+			INC_PROFILEVAR( script_passes_timelimit );
+			break;
+		  }
+		  ex = scriptEngineInternalManager.runlist.front();
+		  scriptEngineInternalManager.runlist.pop_front(); // remove it directly, since an iterator can get invalid during execution
+		}
         Module::OSExecutorModule* os_module = ex->os_module;
 		Clib::scripts_thread_script = ex->scriptname();
 		int inscount = 0;
@@ -158,15 +274,24 @@ namespace Pol {
 		int insleft = os_module->priority / scriptEngineInternalManager.priority_divide;
 		if ( insleft == 0 )
 		  insleft = 1;
+		if ( ex->slice_left >= 0 ) // already partly run by run_ready_unlocked()
+		{
+		  insleft = ex->slice_left;
+		  ex->slice_left = -1;
+		}
 
 		THREAD_CHECKPOINT( scripts, 111 );
 
-		while ( ex->runnable() )
+		while ( insleft > 0 && ex->runnable() )
 		{
-		  ++ex->instr_cycles;
+		  // run up to the next check below, execInstrs() returns early
+		  // after function calls which may have blocked the script
+		  unsigned batch = os_module->critical ? static_cast<unsigned>( 1001 - inscount ) : static_cast<unsigned>( insleft );
+		  if ( ex->warn_runaway_on_cycle > ex->instr_cycles && ex->warn_runaway_on_cycle - ex->instr_cycles < batch )
+			batch = static_cast<unsigned>( ex->warn_runaway_on_cycle - ex->instr_cycles );
 		  THREAD_CHECKPOINT( scripts, 112 );
-		  Clib::scripts_thread_scriptPC = ex->PC;
-		  ex->execInstr();
+		  unsigned executed = ex->execInstrs( batch );
+		  ex->instr_cycles += executed;
 
 		  THREAD_CHECKPOINT( scripts, 113 );
 
@@ -193,8 +318,8 @@ namespace Pol {
 
 		  if ( os_module->critical )
 		  {
-			++inscount;
-			++totcount;
+			inscount += executed;
+			totcount += executed;
 			if ( inscount > 1000 )
 			{
 			  inscount = 0;
@@ -209,10 +334,7 @@ namespace Pol {
 			continue;
 		  }
 
-		  if ( !--insleft )
-		  {
-			break;
-		  }
+		  insleft -= executed;
 		}
 
 		// hmm, this new terminology (runnable()) is confusing
@@ -282,6 +404,10 @@ namespace Pol {
 	  }
 	  THREAD_CHECKPOINT( scripts, 118 );
 
+	  // scripts skipped due to the time limit keep their place in front of the queue
+	  scriptEngineInternalManager.ranlist.insert( scriptEngineInternalManager.ranlist.begin(),
+												  scriptEngineInternalManager.runlist.begin(), scriptEngineInternalManager.runlist.end() );
+	  scriptEngineInternalManager.runlist.clear();
 	  scriptEngineInternalManager.runlist.swap( scriptEngineInternalManager.ranlist );
 	  THREAD_CHECKPOINT( scripts, 119 );
 	}
@@ -291,68 +417,47 @@ namespace Pol {
 	{
 	  polclock_t now_clock = polclock();
 	  stateManager.profilevars.sleep_cycles += scriptEngineInternalManager.holdlist.size() + scriptEngineInternalManager.notimeoutholdlist.size();
-	  polclock_t clocksleft = POLCLOCKS_PER_SEC * 60;
 	  for ( ;; )
 	  {
 		THREAD_CHECKPOINT( scripts, 131 );
 
-        HoldList::iterator itr = scriptEngineInternalManager.holdlist.begin( );
-		if ( itr == scriptEngineInternalManager.holdlist.end() )
+		UOExecutor* ex = scriptEngineInternalManager.holdlist.front_due( now_clock );
+		if ( ex == NULL )
 		  break;
-
-		UOExecutor* ex = ( *itr ).second;
 		// ++ex->sleep_cycles;
 
 		passert( ex->os_module->blocked_ );
 		passert( ex->os_module->sleep_until_clock_ != 0 );
-		clocksleft = ex->os_module->sleep_until_clock_ - now_clock;
-		if ( clocksleft <= 0 )
-		{
-		  if ( clocksleft == 0 )
-			INC_PROFILEVAR( scripts_ontime );
-		  else
-			INC_PROFILEVAR( scripts_late );
-		  // wakey-wakey
-		  // read comment above to understand what goes on here.
-		  // the return value is already on the stack.
-		  THREAD_CHECKPOINT( scripts, 132 );
-		  ex->os_module->revive();
-		}
+		if ( ex->os_module->sleep_until_clock_ == now_clock )
+		  INC_PROFILEVAR( scripts_ontime );
 		else
-		{
-		  break;
-		}
+		  INC_PROFILEVAR( scripts_late );
+		// wakey-wakey
+		// read comment above to understand what goes on here.
+		// the return value is already on the stack.
+		THREAD_CHECKPOINT( scripts, 132 );
+		ex->os_module->revive();
 	  }
-	  *pclocksleft = clocksleft;
+	  polclock_t clocksleft = scriptEngineInternalManager.holdlist.clocks_until_next( now_clock );
+	  *pclocksleft = ( clocksleft >= 0 ) ? clocksleft : POLCLOCKS_PER_SEC * 60;
 	}
 
 	polclock_t calc_script_clocksleft( polclock_t now )
 	{
-	  if ( !scriptEngineInternalManager.runlist.empty() )
+	  if ( scriptEngineInternalManager.has_runnable() )
 	  {
 		return 0; // we want to run immediately
 	  }
-	  else if ( !scriptEngineInternalManager.holdlist.empty() )
-	  {
-        HoldList::iterator itr = scriptEngineInternalManager.holdlist.begin( );
-		UOExecutor* ex = ( *itr ).second;
-		polclock_t clocksleft = ex->os_module->sleep_until_clock_ - now;
-		if ( clocksleft >= 0 )
-		  return clocksleft;
-		else
-		  return 0;
-
-	  }
 	  else
 	  {
-		return -1;
+		return scriptEngineInternalManager.holdlist.clocks_until_next( now ); // -1 if nothing sleeps
 	  }
 	}
 
 	void step_scripts( polclock_t* clocksleft, bool* pactivity )
 	{
 	  THREAD_CHECKPOINT( scripts, 102 );
-	  *pactivity = ( !scriptEngineInternalManager.runlist.empty() );
+	  *pactivity = scriptEngineInternalManager.has_runnable();
 	  THREAD_CHECKPOINT( scripts, 103 );
 
 	  run_ready();
@@ -361,7 +466,7 @@ namespace Pol {
 
 	  check_blocked( clocksleft );
 	  THREAD_CHECKPOINT( scripts, 105 );
-	  if ( !scriptEngineInternalManager.runlist.empty() )
+	  if ( scriptEngineInternalManager.has_runnable() )
 		*clocksleft = 0;
 	  THREAD_CHECKPOINT( scripts, 106 );
 	}
@@ -397,7 +502,7 @@ namespace Pol {
 	  ex->setDebugLevel( Bscript::Executor::NONE );
 
 
-	  scriptEngineInternalManager.runlist.push_back( ex );
+	  scriptEngineInternalManager.add_runnable( ex );
 	}
 	// EXACTLY the same as start_script, except uses find_script2
     Module::UOExecutorModule* start_script( const ScriptDef& script, Bscript::BObjectImp* param )
@@ -429,7 +534,7 @@ namespace Pol {
       ex->setDebugLevel( Bscript::Executor::NONE );
 
 
-	  scriptEngineInternalManager.runlist.push_back( ex.release() );
+	  scriptEngineInternalManager.add_runnable( ex.release() );
 
 	  return uoemod;
 	}
@@ -478,7 +583,7 @@ namespace Pol {
       ex->setDebugLevel( Bscript::Executor::NONE );
 
 
-	  scriptEngineInternalManager.runlist.push_back( ex.release() );
+	  scriptEngineInternalManager.add_runnable( ex.release() );
 
 	  return uoemod;
 	}
@@ -502,32 +607,44 @@ namespace Pol {
 
       ex->setDebugLevel( Bscript::Executor::NONE );
 
-	  scriptEngineInternalManager.runlist.push_back( ex );
+	  scriptEngineInternalManager.add_runnable( ex );
 
 	  return uoemod;
 	}
 
+    namespace {
+      template <class T>
+      Bscript::ExecutorModule* create_module( Bscript::Executor& ex )
+      {
+        return new T( ex );
+      }
+
+      using namespace Module;
+      const Bscript::ExecutorModuleFactories common_module_factories = {
+        { "Basic", &create_module<BasicExecutorModule> },
+        { "BasicIo", &create_module<BasicIoExecutorModule> },
+        { "cliloc", &create_module<ClilocExecutorModule> },
+        { "math", &create_module<MathExecutorModule> },
+        { "util", &create_module<UtilExecutorModule> },
+        { "cfgfile", &create_module<ConfigFileExecutorModule> },
+        { "boat", &create_module<UBoatExecutorModule> },
+        { "datafile", &create_module<DataFileExecutorModule> },
+        { "polsys", &create_module<PolSystemExecutorModule> },
+        { "attributes", &create_module<AttributeExecutorModule> },
+        { "vitals", &create_module<VitalExecutorModule> },
+        { "Storage", &create_module<StorageExecutorModule> },
+        { "Guilds", &create_module<GuildExecutorModule> },
+        { "unicode", &create_module<UnicodeExecutorModule> },
+        { "Party", &create_module<PartyExecutorModule> },
+        { "sql", &create_module<SQLExecutorModule> },
+        { "file", &CreateFileAccessExecutorModule }
+      };
+    }
+
+    // most scripts only use a few modules, so they are created by setProgram() on demand
     void add_common_exmods( Bscript::Executor& ex )
 	{
-      using namespace Module;
-	  ex.addModule( new BasicExecutorModule( ex ) );
-	  ex.addModule( new BasicIoExecutorModule( ex ) );
-	  ex.addModule( new ClilocExecutorModule( ex ) );
-	  ex.addModule( new MathExecutorModule( ex ) );
-	  ex.addModule( new UtilExecutorModule( ex ) );
-	  //ex.addModule( new FileExecutorModule( ex ) );	
-	  ex.addModule( new ConfigFileExecutorModule( ex ) );
-	  ex.addModule( new UBoatExecutorModule( ex ) );
-	  ex.addModule( new DataFileExecutorModule( ex ) );
-	  ex.addModule( new PolSystemExecutorModule( ex ) );
-	  ex.addModule( new AttributeExecutorModule( ex ) );
-	  ex.addModule( new VitalExecutorModule( ex ) );
-	  ex.addModule( new StorageExecutorModule( ex ) );
-	  ex.addModule( new GuildExecutorModule( ex ) );
-	  ex.addModule( new UnicodeExecutorModule( ex ) );
-	  ex.addModule( new PartyExecutorModule( ex ) );
-	  ex.addModule( new SQLExecutorModule( ex ) );
-	  ex.addModule( CreateFileAccessExecutorModule( ex ) );
+	  ex.setModuleFactories( &common_module_factories );
 	}
 
     bool run_script_to_completion_worker( UOExecutor& ex, Bscript::EScriptProgram* prog )
@@ -547,10 +664,9 @@ namespace Pol {
 	  while ( ex.runnable() )
 	  {
         INFO_PRINT << ".";
-		for ( int i = 0; ( i < 1000 ) && ex.runnable(); i++ )
+		for ( unsigned i = 0; ( i < 1000 ) && ex.runnable(); )
 		{
-		  Clib::scripts_thread_scriptPC = ex.PC;
-		  ex.execInstr();
+		  i += ex.execInstrs( 1000 - i );
 		}
 	  }
       INFO_PRINT << "\n";
@@ -609,13 +725,12 @@ namespace Pol {
 
 	  Clib::scripts_thread_script = ex.scriptname();
 
-	  int i = 0;
+	  unsigned i = 0;
 	  bool reported = false;
 	  while ( ex.runnable() )
 	  {
-		Clib::scripts_thread_scriptPC = ex.PC;
-		ex.execInstr();
-		if ( ++i == 1000 )
+		i += ex.execInstrs( 1000 - i );
+		if ( i == 1000 )
 		{
 		  if ( reported )
 		  {
@@ -916,7 +1031,7 @@ namespace Pol {
 
 	  if ( ex->runnable() )
 	  {
-		scriptEngineInternalManager.runlist.push_back( ex );
+		scriptEngineInternalManager.add_runnable( ex );
 	  }
 	  else
 	  {
@@ -930,6 +1045,14 @@ namespace Pol {
 
 	void deschedule_executor( UOExecutor* ex )
 	{
+	  for ( ExecList::iterator itr = scriptEngineInternalManager.interactive_runlist.begin(), itrend = scriptEngineInternalManager.interactive_runlist.end(); itr != itrend; ++itr )
+	  {
+		if ( *itr == ex )
+		{
+		  scriptEngineInternalManager.interactive_runlist.erase( itr );
+		  break;
+		}
+	  }
 	  for ( ExecList::iterator itr = scriptEngineInternalManager.runlist.begin(), itrend = scriptEngineInternalManager.runlist.end(); itr != itrend; ++itr )
 	  {
 		if ( *itr == ex )
@@ -994,6 +1117,7 @@ namespace Pol {
 
 	void list_scripts()
 	{
+	  list_scripts( "interactive", scriptEngineInternalManager.interactive_runlist );
 	  list_scripts( "running", scriptEngineInternalManager.runlist );
 	  // list_scripts( "holding", holdlist );
 	  list_scripts( "ran", scriptEngineInternalManager.ranlist );
@@ -1015,6 +1139,7 @@ namespace Pol {
 
 	void list_crit_scripts()
 	{
+	  list_crit_scripts( "interactive", scriptEngineInternalManager.interactive_runlist );
 	  list_crit_scripts( "running", scriptEngineInternalManager.runlist );
 	  //list_crit_scripts( "holding", holdlist );
 	  list_crit_scripts( "ran", scriptEngineInternalManager.ranlist );
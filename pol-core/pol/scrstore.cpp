@@ -175,23 +175,26 @@ namespace Pol {
 	  }
 
       fmt::Writer tmp;
-      tmp.Format( "{:<38} {:>12} {:>6} {:>12} {:>6}\n" ) << "Script" << "cycles" << "incov" << "cyc/invoc" << "%";
+      tmp.Format( "{:<38} {:>12} {:>6} {:>12} {:>6} {:>12}\n" ) << "Script" << "cycles" << "incov" << "cyc/invoc" << "%" << "startup ns";
       for ( const auto &scr : scriptEngineInternalManager.scrstore )
 	  {
         Bscript::EScriptProgram* eprog = scr.second.get();
         double cycle_percent = total_instr != 0 ?
 		  (static_cast<double>(eprog->instr_cycles) / total_instr * 100.0)
 		  : 0;
-        tmp.Format( "{:<38} {:>12} {:>6} {:>12} {:>6}\n" )
+        tmp.Format( "{:<38} {:>12} {:>6} {:>12} {:>6} {:>12}\n" )
           << eprog->name
           << eprog->instr_cycles
           << eprog->invocations
           << ( eprog->instr_cycles /
           ( eprog->invocations ? eprog->invocations : 1 ) )
-		  << cycle_percent;
+		  << cycle_percent
+          << ( eprog->startup_ns /
+          ( eprog->invocations ? eprog->invocations : 1 ) );
 		if ( clear_counters )
 		{
 		  eprog->instr_cycles = 0;
+		  eprog->startup_ns = 0;
 		  eprog->invocations = eprog->count() - 1; // 1 count is the scrstore's
 		}
 	  }
@@ -207,6 +210,7 @@ namespace Pol {
 	  {
         Bscript::EScriptProgram* eprog = scr.second.get();
 		eprog->instr_cycles = 0;
+		eprog->startup_ns = 0;
 		eprog->invocations = eprog->count() - 1; // 1 count is the scrstore's
 	  }
 
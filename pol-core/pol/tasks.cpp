@@ -189,6 +189,7 @@ namespace Pol {
 
 	  TICK_PROFILEVAR( scripts_ontime );
 	  TICK_PROFILEVAR( scripts_late );
+	  TICK_PROFILEVAR( script_passes_timelimit );
 
 	  TICK_PROFILEVAR( npc_searches );
 	  ROLL_PROFILECLOCK( npc_search );
@@ -274,15 +275,6 @@ namespace Pol {
 		stateManager.profilevars.last_rpm = stateManager.profilevars.rotations - stateManager.profilevars.last_rotations;
 		stateManager.profilevars.last_rotations = stateManager.profilevars.rotations;
 
-		//fixme realms
-		// fixme max realm size?
-		unsigned int grid_x = gamestate.main_realm->width() / WGRID_SIZE;
-		unsigned int grid_y = gamestate.main_realm->height() / WGRID_SIZE;
-		stateManager.cycles_per_decay_worldzone = stateManager.profilevars.last_rpm / ( grid_x * grid_y / 10 );
-		if ( stateManager.cycles_per_decay_worldzone < 1 )
-		  stateManager.cycles_per_decay_worldzone = 1;
-		stateManager.cycles_until_decay_worldzone = stateManager.cycles_per_decay_worldzone;
-
 		if ( Plib::systemstate.config.watch_rpm )
           INFO_PRINT << "RPM: " << stateManager.profilevars.last_rpm
 		  << "   SIPM: " << stateManager.profilevars.last_sipm
@@ -297,14 +289,14 @@ namespace Pol {
 	void update_sysload()
 	{
 	  THREAD_CHECKPOINT( tasks, 201 );
-	  if ( scriptEngineInternalManager.runlist.empty() )
+	  if ( !scriptEngineInternalManager.has_runnable() )
 	  {
 		++stateManager.profilevars.nonbusy_sysload_cycles;
 	  }
 	  else
 	  {
 		++stateManager.profilevars.busy_sysload_cycles;
-		stateManager.profilevars.sysload_nprocs += scriptEngineInternalManager.runlist.size();
+		stateManager.profilevars.sysload_nprocs += scriptEngineInternalManager.runlist.size() + scriptEngineInternalManager.interactive_runlist.size();
 	  }
 	  THREAD_CHECKPOINT( tasks, 299 );
 	}
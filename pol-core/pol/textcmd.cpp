@@ -452,7 +452,7 @@ namespace Pol {
 	{
 	  send_sysmessage( client, "Process Information:" );
 
-      send_sysmessage( client, "Running: " + Clib::decint( (unsigned int)( scriptEngineInternalManager.runlist.size( ) ) ) );
+      send_sysmessage( client, "Running: " + Clib::decint( (unsigned int)( scriptEngineInternalManager.runlist.size( ) + scriptEngineInternalManager.interactive_runlist.size( ) ) ) );
       send_sysmessage( client, "Blocked: " + Clib::decint( (unsigned int)( scriptEngineInternalManager.holdlist.size( ) ) ) );
 	}
 
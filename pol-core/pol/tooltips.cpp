@@ -7,6 +7,7 @@ History
 2009/01/27 MuadDib:   Rewrote Obj Cache Building/Sending.
 2009/07/26 MuadDib:   Packet struct refactoring.
 2009/09/06 Turley:    Changed Version checks to bitfield client->ClientType
+2026/10/17 agent:     SendAOSTooltip sends the packet from the TooltipCache
 
 Notes
 =======
@@ -25,6 +26,7 @@ Notes
 #include "pktboth.h"
 #include "pktin.h"
 #include "ufunc.h"
+#include "globals/network.h"
 #include "globals/uvars.h"
 #include "uworld.h"
 
@@ -127,54 +129,98 @@ namespace Pol {
 	}
 
 
-    void SendAOSTooltip( Network::Client* client, UObject* obj, bool vendor_content )
-	{
-	  std::string desc;
-	  if ( obj->isa( UObject::CLASS_CHARACTER ) )
+	namespace {
+	  void build_aos_tooltip( std::vector<u8>& packet, UObject* obj, bool vendor_content )
 	  {
-		Mobile::Character* chr = (Mobile::Character*)obj;
-		desc = ( chr->title_prefix.empty() ? " \t" : chr->title_prefix + " \t" ) + chr->name() +
-		  ( chr->title_suffix.empty() ? "\t " : "\t " + chr->title_suffix );
-		if ( !chr->title_race.empty() )
-		  desc += " (" + chr->title_race + ")";
-		if ( !chr->title_guild.empty() )
-		  desc += " [" + chr->title_guild + "]";
+		std::string desc;
+		if ( obj->isa( UObject::CLASS_CHARACTER ) )
+		{
+		  Mobile::Character* chr = (Mobile::Character*)obj;
+		  desc = ( chr->title_prefix.empty() ? " \t" : chr->title_prefix + " \t" ) + chr->name() +
+			( chr->title_suffix.empty() ? "\t " : "\t " + chr->title_suffix );
+		  if ( !chr->title_race.empty() )
+			desc += " (" + chr->title_race + ")";
+		  if ( !chr->title_guild.empty() )
+			desc += " [" + chr->title_guild + "]";
+		}
+		else
+		if ( vendor_content )
+		{
+		  Items::Item* item = (Items::Item*)obj;
+		  desc = item->merchant_description();
+		}
+		else
+		  desc = obj->description();
+
+		PacketOut<Network::PktOut_D6> msg;
+		msg->offset += 2;
+		msg->WriteFlipped<u16>( 1u ); //u16 unk1
+		msg->Write<u32>( obj->serial_ext );
+		msg->offset += 2; // u8 unk2,unk3
+		msg->WriteFlipped<u32>( obj->rev() );
+		if ( obj->isa( UObject::CLASS_CHARACTER ) )
+		  msg->WriteFlipped<u32>( 1050045u );   //1 text argument only
+		else
+		  msg->WriteFlipped<u32>( 1042971u );   //1 text argument only
+
+		u16 textlen = static_cast<u16>( desc.size() );
+		if ( ( textlen * 2 ) > ( 0xFFFF - 22 ) )
+		{
+		  textlen = 0xFFFF / 2 - 22;
+		}
+		msg->WriteFlipped<u16>( textlen * 2u );
+		const char* string = desc.c_str();
+
+		while ( *string && textlen-- ) //unicode
+		  msg->Write<u16>( static_cast<u16>(*string++) );
+		msg->offset += 4; // indicates end of property list
+		u16 len = msg->offset;
+		msg->offset = 1;
+		msg->WriteFlipped<u16>( len );
+		const u8* data = reinterpret_cast<const u8*>( &msg->buffer );
+		packet.assign( data, data + len );
 	  }
-	  else
-	  if ( vendor_content )
+	}
+
+	const std::vector<u8>& TooltipCache::get( UObject* obj, bool vendor_content )
+	{
+	  Entry& entry = _entries[obj->serial];
+	  Packet& packet = vendor_content ? entry.merchant_desc : entry.desc;
+	  if ( packet.data.empty() || packet.rev != obj->rev() )
 	  {
-		Items::Item* item = (Items::Item*)obj;
-		desc = item->merchant_description();
+		build_aos_tooltip( packet.data, obj, vendor_content );
+		packet.rev = obj->rev();
 	  }
-	  else
-		desc = obj->description();
-
-      PacketOut<Network::PktOut_D6> msg;
-	  msg->offset += 2;
-	  msg->WriteFlipped<u16>( 1u ); //u16 unk1
-	  msg->Write<u32>( obj->serial_ext );
-	  msg->offset += 2; // u8 unk2,unk3
-	  msg->WriteFlipped<u32>( obj->rev() );
-	  if ( obj->isa( UObject::CLASS_CHARACTER ) )
-		msg->WriteFlipped<u32>( 1050045u );   //1 text argument only
-	  else
-		msg->WriteFlipped<u32>( 1042971u );   //1 text argument only
-
-	  u16 textlen = static_cast<u16>( desc.size() );
-	  if ( ( textlen * 2 ) > ( 0xFFFF - 22 ) )
+	  return packet.data;
+	}
+
+	void TooltipCache::erase( u32 serial )
+	{
+	  _entries.erase( serial );
+	}
+
+	void TooltipCache::clear()
+	{
+	  _entries.clear();
+	}
+
+	size_t TooltipCache::estimateSize() const
+	{
+	  size_t size = sizeof( *this );
+	  for ( const auto& entry : _entries )
 	  {
-		textlen = 0xFFFF / 2 - 22;
+		size += sizeof( entry ) + 2 * sizeof( void* )
+		  + entry.second.desc.data.capacity() + entry.second.merchant_desc.data.capacity();
 	  }
-	  msg->WriteFlipped<u16>( textlen * 2u );
-	  const char* string = desc.c_str();
-
-	  while ( *string && textlen-- ) //unicode
-		msg->Write<u16>( static_cast<u16>(*string++) );
-	  msg->offset += 4; // indicates end of property list
-	  u16 len = msg->offset;
-	  msg->offset = 1;
-	  msg->WriteFlipped<u16>( len );
-	  msg.Send( client, len );
+	  return size;
+	}
+
+    void SendAOSTooltip( Network::Client* client, UObject* obj, bool vendor_content )
+	{
+	  if ( obj->orphan() ) // the cache is keyed by serial
+		return;
+	  const std::vector<u8>& packet = networkManager.tooltip_cache->get( obj, vendor_content );
+	  networkManager.clientTransmit->AddToQueue( client, &packet[0], static_cast<int>( packet.size() ) );
 	}
 
   }
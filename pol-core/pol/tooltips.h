@@ -3,6 +3,7 @@ History
 =======
 2007/04/07 MuadDib:   send_object_cache_to_inrange updated from just UObject* to
                       const UObject* for compatibility across more areas.
+2026/10/17 agent:     TooltipCache keeps the built 0xD6 packets by object revision
 
 Notes
 =======
@@ -12,6 +13,12 @@ Notes
 #ifndef __TOOLTIPS_H
 #define __TOOLTIPS_H
 
+#include "../clib/rawtypes.h"
+
+#include <boost/noncopyable.hpp>
+#include <unordered_map>
+#include <vector>
+
 namespace Pol {
   namespace Network {
     class Client;
@@ -21,6 +28,32 @@ namespace Pol {
 	void send_object_cache( Network::Client* client, const UObject* obj );
 	void send_object_cache_to_inrange( const UObject* obj );
     void SendAOSTooltip( Network::Client* client, UObject* item, bool vendor_content = false );
+
+	// The 0xD6 packets sent by SendAOSTooltip, by object serial. They are the same for every
+	// client and are rebuilt when the revision of the object changed.
+	// UObject::destroy removes the entry, so a reused serial doesn't see an old tooltip.
+	class TooltipCache : boost::noncopyable
+	{
+	public:
+	  const std::vector<u8>& get( UObject* obj, bool vendor_content );
+	  void erase( u32 serial );
+	  void clear();
+	  size_t estimateSize() const;
+
+	private:
+	  struct Packet
+	  {
+		Packet() : rev( 0 ), data() {}
+		u32 rev;
+		std::vector<u8> data; // empty until built
+	  };
+	  struct Entry
+	  {
+		Packet desc;
+		Packet merchant_desc;
+	  };
+	  std::unordered_map<u32, Entry> _entries;
+	};
   }
 }
 #endif
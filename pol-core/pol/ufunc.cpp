@@ -30,6 +30,7 @@ to build packet and handle iter internally. Packet built just once this way, and
 2009/12/02 Turley:    0xf3 packet support - Tomi
 face support
 2009/12/03 Turley:    added 0x17 packet everywhere only send if poisoned, fixed get_flag1 (problem with poisoned & flying)
+2026/10/17 agent:     send_move_mobile_to_nearby_cansee queues each distinct move packet once for all its clients
 
 Notes
 =======
@@ -240,6 +241,70 @@ namespace Pol {
             msg->WriteFlipped<u16>(chr->color);
         }
 
+	MoveBroadcast::MoveBroadcast( const Character* chr ) :
+	  _chr( chr ),
+	  _move( PktHelper::RequestPacket<PktOut_77>( PktOut_77::ID ) ),
+	  _variants(),
+	  _healthbar_clients()
+	{
+	  build_send_move( chr, _move );
+	}
+
+	MoveBroadcast::~MoveBroadcast()
+	{
+	  PktHelper::ReAddPacket( _move );
+	}
+
+	void MoveBroadcast::add( Client* client )
+	{
+	  u8 flag1 = _chr->get_flag1( client );
+	  u8 hilite = _chr->hilite_color_idx( client->chr );
+	  auto itr = _variants.begin();
+	  for ( ; itr != _variants.end(); ++itr )
+	  {
+		if ( itr->flag1 == flag1 && itr->hilite == hilite )
+		  break;
+	  }
+	  if ( itr == _variants.end() )
+	  {
+		Variant variant;
+		variant.flag1 = flag1;
+		variant.hilite = hilite;
+		_variants.push_back( variant );
+		itr = _variants.end() - 1;
+	  }
+	  itr->clients.push_back( client );
+	  if ( client->ClientType & CLIENTTYPE_UOKR )
+		_healthbar_clients.push_back( client );
+	}
+
+	void MoveBroadcast::send()
+	{
+	  for ( const auto& variant : _variants )
+	  {
+		_move->offset = 15;
+		_move->Write<u8>( variant.flag1 );
+		_move->Write<u8>( variant.hilite );
+		Core::networkManager.clientTransmit->AddToQueue( variant.clients, &_move->buffer, _move->offset );
+	  }
+	  _variants.clear();
+	  if ( _healthbar_clients.empty() )
+		return;
+	  if ( _chr->poisoned() ) //if poisoned send 0x17 for newer clients
+	  {
+		PktHelper::PacketOut<PktOut_17> msg;
+		build_poisonhealthbar( _chr, msg.Get() );
+		msg.Send( _healthbar_clients );
+	  }
+	  if ( _chr->invul() ) //if invul send 0x17 for newer clients
+	  {
+		PktHelper::PacketOut<PktOut_17> msg;
+		build_invulhealthbar( _chr, msg.Get() );
+		msg.Send( _healthbar_clients );
+	  }
+	  _healthbar_clients.clear();
+	}
+
         void send_poisonhealthbar(Client *client, const Character *chr)
         {
             PktHelper::PacketOut<PktOut_17> msg;
@@ -331,6 +396,7 @@ namespace Pol {
             owncreate->WriteFlipped<u16>(len);
 
             owncreate.Send(client, len);
+            client->gd->known_objects.sent(chr);
 
             if (client->UOExpansionFlag & AOS)
             {
@@ -408,6 +474,7 @@ namespace Pol {
             owncreate->WriteFlipped<u16>(len);
 
             Core::networkManager.clientTransmit->AddToQueue(client, &owncreate->buffer, len);
+            client->gd->known_objects.sent(chr);
 
             if (client->UOExpansionFlag & AOS)
             {
@@ -2181,13 +2248,15 @@ namespace Pol {
 
 	void send_move_mobile_to_nearby_cansee( const Character* chr )
 	{
+      MoveBroadcast moves( chr );
       WorldIterator<OnlinePlayerFilter>::InVisualRange( chr, [&]( Character *zonechr )
       {
         if ( zonechr == chr )
           return;
         if ( zonechr->is_visible_to_me( chr ) )
-          send_move( zonechr->client, chr );
+          moves.add( zonechr->client );
       } );
+      moves.send();
 	}
 
 	Character* UpdateCharacterWeight( Item* item )
@@ -2305,6 +2374,7 @@ namespace Pol {
 	  msg->offset += 2; //sub
 	  msg->Write<u8>( realm->getUOMapID() );
 	  msg.Send( client );
+	  client->gd->known_objects.clear(); // the client forgets all objects
 	}
 
 	void send_map_difs( Client* client )
@@ -2355,6 +2425,7 @@ namespace Pol {
 	  msg->WriteFlipped<u16>( client->chr->realm->width() );
 	  msg->WriteFlipped<u16>( client->chr->realm->height() );
 	  msg.Send( client );
+	  client->gd->known_objects.clear(); // the client forgets all objects
 	}
 
 	void send_fight_occuring( Client* client, Character* opponent )
@@ -7,6 +7,7 @@ History
 2009/08/01 MuadDib:   Removed send_tech_stuff(), unused and obsolete.
 2009/08/09 MuadDib:   Refactor of Packet 0x25 for naming convention
 2009/09/22 Turley:    Added DamagePacket support
+2026/10/17 agent:     Added MoveBroadcast
 
 Notes
 =======
@@ -17,6 +18,7 @@ Notes
 #define __UFUNC_H
 
 #include <stddef.h>
+#include <vector>
 
 #include "../clib/rawtypes.h"
 
@@ -96,6 +98,33 @@ namespace Pol {
 	void send_move( Network::Client *client, const Mobile::Character *chr );
 	void send_move( Network::Client *client, const Mobile::Character *chr, Network::PktOut_77* movebuffer, Network::PktOut_17* poisonbuffer, Network::PktOut_17* invulbuffer );
 	void build_send_move( const Mobile::Character *chr, Network::PktOut_77* msg );
+
+	// Collects the clients which get the move of a mobile. The 0x77 packet only differs
+	// in the flag and notoriety bytes, so each distinct pair is queued once with all its
+	// clients instead of once per client.
+	class MoveBroadcast
+	{
+	public:
+	  explicit MoveBroadcast( const Mobile::Character* chr );
+	  ~MoveBroadcast();
+	  void add( Network::Client* client );
+	  // queues the collected packets, needs to be called before destruction
+	  void send();
+	private:
+	  MoveBroadcast( const MoveBroadcast& );
+	  MoveBroadcast& operator=( const MoveBroadcast& );
+
+	  struct Variant
+	  {
+		u8 flag1;
+		u8 hilite;
+		std::vector<Network::Client*> clients;
+	  };
+	  const Mobile::Character* _chr;
+	  Network::PktOut_77* _move;
+	  std::vector<Variant> _variants;
+	  std::vector<Network::Client*> _healthbar_clients; // newer clients get 0x17 too
+	};
 	void send_objdesc( Network::Client *client, Items::Item *item );
 
 	void send_poisonhealthbar( Network::Client *client, const Mobile::Character *chr );
@@ -46,6 +46,7 @@ Notes
 #include "../plib/realm.h"
 #include "../plib/systemstate.h"
 
+#include "../clib/binarycfg.h"
 #include "../clib/cfgelem.h"
 #include "../clib/cfgfile.h"
 #include "../clib/endian.h"
@@ -66,10 +67,18 @@ Notes
 #include <cstring>
 #include <cerrno>
 
+#ifdef __linux__
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
 #include <future>
 #include <fstream>
+#include <map>
+#include <memory>
 #include <string>
 #include <stdexcept>
+#include <vector>
 
 #ifdef _MSC_VER
 #pragma warning(disable:4996) // disable warning deprecation of stricmp
@@ -80,6 +89,8 @@ namespace Pol {
     void commit_datastore();
     void read_datastore_dat();
     void write_datastore( Clib::StreamWriter& sw );
+    void snapshot_datastore();
+    void finish_datastore_snapshot( bool success );
   }
   namespace Core {
     void read_party_dat();
@@ -353,64 +364,131 @@ namespace Pol {
       return Clib::decint( ms ) + " ms";
     }
 
-    void slurp( const char* filename, const char* tags, int sysfind_flags )
+    // the object files which are also written in binary form when BinarySaves is set,
+    // with the element types their read_*_dat() accepts
+    struct BinaryDataFile
     {
-      static int num_until_dot = 1000;
+      const char* basename;
+      const char* tags;
+    };
+    const BinaryDataFile binary_datafiles[] = {
+      { "pcs", "CHARACTER ITEM" },
+      { "pcequip", "ITEM" },
+      { "npcs", "NPC ITEM" },
+      { "npcequip", "ITEM" },
+      { "items", "ITEM" },
+      { "multis", "MULTI" }
+    };
+
+    // binary data files opened before loading starts, their elements decode in parallel
+    // while the files before them are read; taken over by slurp()
+    std::map<std::string, std::unique_ptr<Clib::BinaryConfigFile>> prefetched_datafiles;
+
+    std::string binary_datafile_name( const char* filename )
+    {
+      std::string binfile = filename;
+      std::string::size_type dot = binfile.rfind( ".txt" );
+      if ( dot == std::string::npos )
+        return std::string();
+      return binfile.replace( dot, std::string::npos, ".bin" );
+    }
 
-      if ( Clib::FileExists( filename ) )
+    void prefetch_binary_datafiles()
+    {
+      for ( const auto& datafile : binary_datafiles )
       {
-        INFO_PRINT << "  " << filename << ":";
-        Clib::ConfigFile cf( filename, tags );
-        Clib::ConfigElem elem;
+        std::string binfile = Plib::systemstate.config.world_data_path + datafile.basename + ".bin";
+        if ( !Clib::FileExists( binfile ) )
+          continue;
+        std::unique_ptr<Clib::BinaryConfigFile> bf( new Clib::BinaryConfigFile( binfile, datafile.tags ) );
+        bf->start_prefetch();
+        prefetched_datafiles[binfile] = std::move( bf );
+      }
+    }
 
-        Tools::Timer<> timer;
+    template <class Source>
+    void slurp_elems( Source& cf, const char* filename, int sysfind_flags )
+    {
+      static int num_until_dot = 1000;
 
-        unsigned int nobjects = 0;
-        while ( cf.read( elem ) )
-        {
-          if ( --num_until_dot == 0 )
-          {
-            INFO_PRINT << ".";
-            num_until_dot = 1000;
-          }
-          try
-          {
-            if ( stricmp( elem.type(), "CHARACTER" ) == 0 )
-              read_character( elem );
-            else if ( stricmp( elem.type(), "NPC" ) == 0 )
-              read_npc( elem );
-            else if ( stricmp( elem.type(), "ITEM" ) == 0 )
-              read_global_item( elem, sysfind_flags );
-            else if ( stricmp( elem.type(), "GLOBALPROPERTIES" ) == 0 )
-              gamestate.global_properties->readProperties( elem );
-            else if ( elem.type_is( "SYSTEM" ) )
-              read_system_vars( elem );
-            else if ( elem.type_is( "MULTI" ) )
-              read_multi( elem );
-            else if ( elem.type_is( "STORAGEAREA" ) )
-            {
-              StorageArea* storage_area = gamestate.storage.create_area( elem );
-              // this will be followed by an item
-              if (!cf.read(elem))
-                  throw std::runtime_error("Expected an item to exist after the storagearea.");
+      INFO_PRINT << "  " << filename << ":";
+      Clib::ConfigElem elem;
 
-              storage_area->load_item( elem );
-            }
-            else if ( elem.type_is( "REALM" ) )
-              read_shadow_realms( elem );
+      Tools::Timer<> timer;
 
-          }
-          catch ( std::exception& )
+      unsigned int nobjects = 0;
+      while ( cf.read( elem ) )
+      {
+        if ( --num_until_dot == 0 )
+        {
+          INFO_PRINT << ".";
+          num_until_dot = 1000;
+        }
+        try
+        {
+          if ( stricmp( elem.type(), "CHARACTER" ) == 0 )
+            read_character( elem );
+          else if ( stricmp( elem.type(), "NPC" ) == 0 )
+            read_npc( elem );
+          else if ( stricmp( elem.type(), "ITEM" ) == 0 )
+            read_global_item( elem, sysfind_flags );
+          else if ( stricmp( elem.type(), "GLOBALPROPERTIES" ) == 0 )
+            gamestate.global_properties->readProperties( elem );
+          else if ( elem.type_is( "SYSTEM" ) )
+            read_system_vars( elem );
+          else if ( elem.type_is( "MULTI" ) )
+            read_multi( elem );
+          else if ( elem.type_is( "STORAGEAREA" ) )
           {
-            if ( !Plib::systemstate.config.ignore_load_errors )
-              throw;
+            StorageArea* storage_area = gamestate.storage.create_area( elem );
+            // this will be followed by an item
+            if (!cf.read(elem))
+                throw std::runtime_error("Expected an item to exist after the storagearea.");
+
+            storage_area->load_item( elem );
           }
-          ++nobjects;
+          else if ( elem.type_is( "REALM" ) )
+            read_shadow_realms( elem );
+
         }
+        catch ( std::exception& )
+        {
+          if ( !Plib::systemstate.config.ignore_load_errors )
+            throw;
+        }
+        ++nobjects;
+      }
 
-        timer.stop();
+      timer.stop();
 
-        INFO_PRINT << " " << nobjects << " elements in " << timer.ellapsed() << " ms.\n";
+      INFO_PRINT << " " << nobjects << " elements in " << timer.ellapsed() << " ms.\n";
+    }
+
+    void slurp( const char* filename, const char* tags, int sysfind_flags )
+    {
+      std::string binfile = binary_datafile_name( filename );
+      if ( !binfile.empty() && Clib::FileExists( binfile ) )
+      {
+        if ( Clib::FileExists( filename ) )
+          POLLOG_INFO << "Both " << filename << " and " << binfile << " exist, using " << binfile << "\n";
+
+        std::unique_ptr<Clib::BinaryConfigFile> bf;
+        auto itr = prefetched_datafiles.find( binfile );
+        if ( itr != prefetched_datafiles.end() )
+        {
+          bf = std::move( itr->second );
+          prefetched_datafiles.erase( itr );
+        }
+        else
+        {
+          bf.reset( new Clib::BinaryConfigFile( binfile, tags ) );
+        }
+        slurp_elems( *bf, binfile.c_str(), sysfind_flags );
+      }
+      else if ( Clib::FileExists( filename ) )
+      {
+        Clib::ConfigFile cf( filename, tags );
+        slurp_elems( cf, filename, sysfind_flags );
       }
     }
 
@@ -652,6 +730,7 @@ namespace Pol {
       }
 
       rename_dat_files();
+      prefetch_binary_datafiles();
 
       load_incremental_indexes();
 
@@ -667,6 +746,7 @@ namespace Pol {
       read_npcequip_dat();
       read_items_dat();
       read_multis_dat();
+      prefetched_datafiles.clear();
       read_storage_dat();
       read_resources_dat();
       read_guilds_dat();
@@ -693,7 +773,7 @@ namespace Pol {
 
       for ( ObjectHash::hs::const_iterator citr = objStorageManager.objecthash.begin(), citrend = objStorageManager.objecthash.end(); citr != citrend; ++citr )
       {
-        UObject* obj = ( *citr ).second.get();
+        UObject* obj = citr->get();
         if ( obj->ismobile() )
         {
           Mobile::Character* chr = static_cast<Mobile::Character*>( obj );
@@ -930,7 +1010,7 @@ namespace Pol {
     {
       for ( const auto &objitr : objStorageManager.objecthash )
       {
-        UObject* obj = objitr.second.get();
+        UObject* obj = objitr.get();
         if ( obj->ismobile() && !obj->orphan() )
         {
           Mobile::Character* chr = static_cast<Mobile::Character*>( obj );
@@ -948,7 +1028,7 @@ namespace Pol {
     {
       for ( const auto &objitr : objStorageManager.objecthash )
       {
-        UObject* obj = objitr.second.get();
+        UObject* obj = objitr.get();
         if ( obj->ismobile() && !obj->orphan() )
         {
           Mobile::Character* chr = static_cast<Mobile::Character*>( obj );
@@ -996,7 +1076,7 @@ namespace Pol {
 
       for ( const auto &objitr : objStorageManager.objecthash )
       {
-        UObject* obj = objitr.second.get();
+        UObject* obj = objitr.get();
         if ( obj->ismobile() && !obj->orphan() )
         {
           Mobile::Character* chr = static_cast<Mobile::Character*>( obj );
@@ -1049,11 +1129,8 @@ namespace Pol {
       }
     }
 
-    bool commit(const std::string& basename)
+    bool commit_files( const std::string& bakfile, const std::string& datfile, const std::string& ndtfile )
     {
-      std::string bakfile = Plib::systemstate.config.world_data_path + basename + ".bak";
-      std::string datfile = Plib::systemstate.config.world_data_path + basename + ".txt";
-      std::string ndtfile = Plib::systemstate.config.world_data_path + basename + ".ndt";
       const char* bakfile_c = bakfile.c_str();
       const char* datfile_c = datfile.c_str();
       const char* ndtfile_c = ndtfile.c_str();
@@ -1093,6 +1170,366 @@ namespace Pol {
       return any;
     }
 
+    bool commit( const std::string& basename )
+    {
+      std::string path = Plib::systemstate.config.world_data_path + basename;
+      return commit_files( path + ".bak", path + ".txt", path + ".ndt" );
+    }
+
+    bool commit_binary( const std::string& basename )
+    {
+      std::string path = Plib::systemstate.config.world_data_path + basename;
+      return commit_files( path + ".bin.bak", path + ".bin", path + ".bin.ndt" );
+    }
+
+    // converts the written object files into their binary form, in parallel.
+    // a file which fails to convert is committed as text.
+    void convert_binary_datafiles()
+    {
+      std::vector<std::future<void>> conversions;
+      for ( const auto& datafile : binary_datafiles )
+      {
+        std::string path = Plib::systemstate.config.world_data_path + datafile.basename;
+        if ( !Clib::FileExists( path + ".ndt" ) )
+          continue;
+        conversions.push_back( std::async( std::launch::async, [path]()
+        {
+          threadhelp::ThreadRegister register_thread( "SaveSection: binary" );
+          std::string ndtfile = path + ".ndt";
+          if ( Clib::convert_text_to_binary_cfg( ndtfile, path + ".bin.ndt" ) )
+            unlink( ndtfile.c_str() );
+        } ) );
+      }
+      for ( auto& conversion : conversions )
+        conversion.wait();
+    }
+
+    // formats the world into the .ndt files of the SaveContext, returns false if a part failed.
+    // The forked child of a snapshot save writes sequentially and leaves the commit of the
+    // datastore to the server, which does it once the whole save succeeded.
+    bool write_datafiles( SaveContext& sc, bool snapshot_child )
+    {
+      bool result = true;
+#pragma omp parallel sections if ( !snapshot_child )
+      {
+#pragma omp section
+        {
+          threadhelp::ThreadRegister register_thread( "SaveSection: pol" );
+          try
+          {
+            sc.pol() << "#" << pf_endl
+              << "#  Created by Version: " << polverstr
+              << pf_endl
+              << "#  Mobiles:		 " << get_mobile_count()
+              << pf_endl << "#  Top-level Items: "
+              << get_toplevel_item_count() << pf_endl << "#"
+              << pf_endl << pf_endl;
+
+            write_system_data( sc.pol );
+            write_global_properties( sc.pol );
+            write_shadow_realms( sc.pol );
+          }
+          catch ( ... )
+          {
+            POLLOG_ERROR << "failed to store pol datafile!\n";
+            Clib::force_backtrace();
+            result = false;
+          }
+        }
+#pragma omp section
+        {
+        threadhelp::ThreadRegister register_thread( "SaveSection: items" );
+        try
+        {
+          write_items( sc.items );
+        }
+        catch ( ... )
+        {
+          POLLOG_ERROR << "failed to store items datafile!\n";
+          Clib::force_backtrace();
+          result = false;
+        }
+      }
+#pragma omp section
+        {
+          threadhelp::ThreadRegister register_thread( "SaveSection: chars" );
+          try
+          {
+            write_characters( sc );
+          }
+          catch ( ... )
+          {
+            POLLOG_ERROR << "failed to store character datafile!\n";
+            Clib::force_backtrace();
+            result = false;
+          }
+        }
+#pragma omp section
+        {
+          threadhelp::ThreadRegister register_thread( "SaveSection: npcs" );
+          try
+          {
+            write_npcs( sc );
+          }
+          catch ( ... )
+          {
+            POLLOG_ERROR << "failed to store npcs datafile!\n";
+            Clib::force_backtrace();
+            result = false;
+          }
+        }
+#pragma omp section
+        {
+          threadhelp::ThreadRegister register_thread( "SaveSection: multis" );
+          try
+          {
+            write_multis( sc.multis );
+          }
+          catch ( ... )
+          {
+            POLLOG_ERROR << "failed to store multis datafile!\n";
+            Clib::force_backtrace();
+            result = false;
+          }
+        }
+#pragma omp section
+        {
+          threadhelp::ThreadRegister register_thread( "SaveSection: storage" );
+          try
+          {
+            gamestate.storage.print( sc.storage );
+          }
+          catch ( ... )
+          {
+            POLLOG_ERROR << "failed to store storage datafile!\n";
+            Clib::force_backtrace();
+            result = false;
+          }
+        }
+#pragma omp section
+        {
+          threadhelp::ThreadRegister register_thread( "SaveSection: resource" );
+          try
+          {
+            write_resources_dat( sc.resource );
+          }
+          catch ( ... )
+          {
+            POLLOG_ERROR << "failed to store resource datafile!\n";
+            Clib::force_backtrace();
+            result = false;
+          }
+        }
+#pragma omp section
+        {
+          threadhelp::ThreadRegister register_thread( "SaveSection: guilds" );
+          try
+          {
+            write_guilds( sc.guilds );
+          }
+          catch ( ... )
+          {
+            POLLOG_ERROR << "failed to store guilds datafile!\n";
+            Clib::force_backtrace();
+            result = false;
+          }
+        }
+#pragma omp section
+        {
+          threadhelp::ThreadRegister register_thread( "SaveSection: datastore" );
+          try
+          {
+            Module::write_datastore( sc.datastore );
+            // Atomically (hopefully) perform the switch.
+            if ( !snapshot_child )
+              Module::commit_datastore();
+          }
+          catch ( ... )
+          {
+            POLLOG_ERROR << "failed to store datastore datafile!\n";
+            Clib::force_backtrace();
+            result = false;
+          }
+        }
+#pragma omp section
+        {
+          threadhelp::ThreadRegister register_thread( "SaveSection: party" );
+          try
+          {
+            write_party( sc.party );
+          }
+          catch ( ... )
+          {
+            POLLOG_ERROR << "failed to store party datafile!\n";
+            Clib::force_backtrace();
+            result = false;
+          }
+        }
+      }
+      return result;
+    }
+
+    void commit_datafiles()
+    {
+      if ( Plib::systemstate.config.binary_saves )
+        convert_binary_datafiles();
+
+      commit( "pol" );
+      commit( "objects" );
+      commit( "pcs" );
+      commit( "pcequip" );
+      commit( "npcs" );
+      commit( "npcequip" );
+      commit( "items" );
+      commit( "multis" );
+      commit( "storage" );
+      commit( "resource" );
+      commit( "guilds" );
+      commit( "datastore" );
+      commit( "parties" );
+      // without a new binary file the previous one is retired, so the text file is loaded
+      for ( const auto& datafile : binary_datafiles )
+        commit_binary( datafile.basename );
+    }
+
+#ifdef __linux__
+    namespace
+    {
+      // what the server handed over to a running snapshot save, given back if it fails
+      struct SnapshotSave
+      {
+        SnapshotSave() : pending( false ), dirty_serials(), deleted_serials() {}
+        bool pending;
+        std::vector<u32> dirty_serials;
+        ObjectHash::ds deleted_serials;
+      };
+      SnapshotSave snapshot_save;
+    }
+
+    // Snapshot save: the forked child gets a copy-on-write image of the world and writes it,
+    // the game continues as soon as the fork returned. Returns false if fork failed.
+    // The child is the forking thread only: it starts no threads and logs with printf (the
+    // logger thread doesn't exist there). The locks other threads take without the world lock
+    // (thread map, script allocator freelists) are taken around the fork by their atfork handlers.
+    bool write_data_snapshot()
+    {
+      pid_t pid = fork();
+      if ( pid < 0 )
+      {
+        int err = errno;
+        POLLOG_ERROR.Format( "Snapshot save: fork failed: {} ({}), saving normally\n" ) << strerror( err ) << err;
+        return false;
+      }
+      if ( pid == 0 )
+      {
+        Clib::Logging::global_logger = nullptr;
+        int res = 1;
+        try
+        {
+          SaveContext sc;
+          if ( write_datafiles( sc, true ) )
+            res = 0;
+        }
+        catch ( std::exception& ex )
+        {
+          printf( "Snapshot save: %s\n", ex.what() );
+        }
+        catch ( ... )
+        {
+        }
+        fflush( stdout );
+        _exit( res );
+      }
+
+      // the child saves the current state, so it is clean from now on. The objects dirty
+      // until now get their flag back if the snapshot fails.
+      snapshot_save.pending = true;
+      snapshot_save.dirty_serials.clear();
+      for ( const auto &objitr : objStorageManager.objecthash )
+      {
+        const UObject* obj = objitr.get();
+        if ( obj->orphan() )
+          continue;
+        if ( obj->dirty() )
+          snapshot_save.dirty_serials.push_back( obj->serial );
+        obj->clear_dirty();
+      }
+      objStorageManager.objecthash.TakeDeleted( snapshot_save.deleted_serials );
+      Module::snapshot_datastore();
+
+      // no incremental save runs until finish_snapshot_save(), so all incremental files
+      // belong to the state the child saved
+      SaveContext::finished =
+        std::move( std::async( std::launch::async, [pid]()->bool
+      {
+        int status = 0;
+        pid_t res;
+        while ( ( res = waitpid( pid, &status, 0 ) ) < 0 && errno == EINTR )
+          ;
+        if ( res < 0 )
+        {
+          int err = errno;
+          POLLOG_ERROR.Format( "Snapshot save: waitpid failed: {} ({}), the previous data files are kept!\n" ) << strerror( err ) << err;
+          return false;
+        }
+        if ( !WIFEXITED( status ) || WEXITSTATUS( status ) != 0 )
+        {
+          if ( WIFEXITED( status ) )
+            POLLOG_ERROR << "Snapshot save failed (exit code " << WEXITSTATUS( status ) << "), the previous data files are kept!\n";
+          else
+            POLLOG_ERROR << "Snapshot save failed (signal " << WTERMSIG( status ) << "), the previous data files are kept!\n";
+          return false;
+        }
+        commit_datafiles();
+        commit_incremental_saves();
+        return true;
+      } ) );
+      return true;
+    }
+#endif
+
+    // waits for a running snapshot save and settles what the server handed over to it.
+    // Needs the world lock.
+    void finish_snapshot_save()
+    {
+#ifdef __linux__
+      if ( !snapshot_save.pending )
+        return;
+      snapshot_save.pending = false;
+      SaveContext::ready();
+      bool success = false;
+      try
+      {
+        success = SaveContext::finished.get();
+      }
+      catch ( std::exception& ex )
+      {
+        POLLOG_ERROR << "Snapshot save: " << ex.what() << "\n";
+      }
+      Module::finish_datastore_snapshot( success );
+      if ( success )
+      {
+        objStorageManager.incremental_save_count = 0;
+        objStorageManager.incremental_saves_disabled = false;
+      }
+      else
+      {
+        for ( u32 serial : snapshot_save.dirty_serials )
+        {
+          UObject* obj = objStorageManager.objecthash.Find( serial );
+          if ( obj != nullptr && !obj->orphan() )
+            obj->set_dirty();
+        }
+        objStorageManager.objecthash.RestoreDeleted( snapshot_save.deleted_serials );
+        // the incremental files are still the ones of the previous full save
+        objStorageManager.incremental_saves_disabled = true;
+        POLLOG_ERROR << "Incremental saves are disabled, the next save is a full save.\n";
+      }
+      snapshot_save.dirty_serials.clear();
+      snapshot_save.deleted_serials.clear();
+#endif
+    }
+
     bool should_write_data()
     {
       if ( Plib::systemstate.config.inhibit_saves )
@@ -1107,6 +1544,7 @@ namespace Pol {
                     long long& elapsed_ms )
     {
       SaveContext::ready();  // allow only one active
+      finish_snapshot_save();
       if ( !should_write_data() )
       {
         dirty_writes = clean_writes = 0;
@@ -1118,218 +1556,64 @@ namespace Pol {
       UObject::clean_writes = 0;
 
       Tools::Timer<> timer;
-      // launch complete save as seperate thread
-      // but wait till the first critical part is finished
-      // which means all objects got written into a format object
-      // the remaining operations are only pure buffered i/o
-      auto critical_promise = std::make_shared<std::promise<bool>>();
-      auto critical_future = critical_promise->get_future();
-      SaveContext::finished =
-        std::move( std::async( std::launch::async, [&, critical_promise]()->bool
-      {
-        // limit the used thread
-#ifndef __clang__
-        int max_threads = omp_get_max_threads();
-        if ( max_threads > 1 )
-        {
-          max_threads /= 2;
-          max_threads = std::max( 2, max_threads );
-        }
-        omp_set_num_threads( max_threads );
+#ifdef __linux__
+      bool snapshot = Plib::systemstate.config.snapshot_save && !Clib::exit_signalled && write_data_snapshot();
+#else
+      bool snapshot = false;
 #endif
-        try
+      if ( !snapshot )
+      {
+        // launch complete save as seperate thread
+        // but wait till the first critical part is finished
+        // which means all objects got written into a format object
+        // the remaining operations are only pure buffered i/o
+        auto critical_promise = std::make_shared<std::promise<bool>>();
+        auto critical_future = critical_promise->get_future();
+        SaveContext::finished =
+          std::move( std::async( std::launch::async, [&, critical_promise]()->bool
         {
-          SaveContext sc;
-          bool result = true;
-#pragma omp parallel sections
+          // limit the used thread
+#ifndef __clang__
+          int max_threads = omp_get_max_threads();
+          if ( max_threads > 1 )
           {
-#pragma omp section
-            {
-              threadhelp::ThreadRegister register_thread( "SaveSection: pol" );
-              try
-              {
-                sc.pol() << "#" << pf_endl
-                  << "#  Created by Version: " << polverstr
-                  << pf_endl
-                  << "#  Mobiles:		 " << get_mobile_count()
-                  << pf_endl << "#  Top-level Items: "
-                  << get_toplevel_item_count() << pf_endl << "#"
-                  << pf_endl << pf_endl;
-
-                write_system_data( sc.pol );
-                write_global_properties( sc.pol );
-                write_shadow_realms( sc.pol );
-              }
-              catch ( ... )
-              {
-                POLLOG_ERROR << "failed to store pol datafile!\n";
-                Clib::force_backtrace();
-                result = false;
-              }
-            }
-#pragma omp section
-            {
-            threadhelp::ThreadRegister register_thread( "SaveSection: items" );
-            try
-            {
-              write_items( sc.items );
-            }
-            catch ( ... )
-            {
-              POLLOG_ERROR << "failed to store items datafile!\n";
-              Clib::force_backtrace();
-              result = false;
-            }
+            max_threads /= 2;
+            max_threads = std::max( 2, max_threads );
           }
-#pragma omp section
-            {
-              threadhelp::ThreadRegister register_thread( "SaveSection: chars" );
-              try
-              {
-                write_characters( sc );
-              }
-              catch ( ... )
-              {
-                POLLOG_ERROR << "failed to store character datafile!\n";
-                Clib::force_backtrace();
-                result = false;
-              }
-            }
-#pragma omp section
-            {
-              threadhelp::ThreadRegister register_thread( "SaveSection: npcs" );
-              try
-              {
-                write_npcs( sc );
-              }
-              catch ( ... )
-              {
-                POLLOG_ERROR << "failed to store npcs datafile!\n";
-                Clib::force_backtrace();
-                result = false;
-              }
-            }
-#pragma omp section
-            {
-              threadhelp::ThreadRegister register_thread( "SaveSection: multis" );
-              try
-              {
-                write_multis( sc.multis );
-              }
-              catch ( ... )
-              {
-                POLLOG_ERROR << "failed to store multis datafile!\n";
-                Clib::force_backtrace();
-                result = false;
-              }
-            }
-#pragma omp section
-            {
-              threadhelp::ThreadRegister register_thread( "SaveSection: storage" );
-              try
-              {
-                gamestate.storage.print( sc.storage );
-              }
-              catch ( ... )
-              {
-                POLLOG_ERROR << "failed to store storage datafile!\n";
-                Clib::force_backtrace();
-                result = false;
-              }
-            }
-#pragma omp section
-            {
-              threadhelp::ThreadRegister register_thread( "SaveSection: resource" );
-              try
-              {
-                write_resources_dat( sc.resource );
-              }
-              catch ( ... )
-              {
-                POLLOG_ERROR << "failed to store resource datafile!\n";
-                Clib::force_backtrace();
-                result = false;
-              }
-            }
-#pragma omp section
-            {
-              threadhelp::ThreadRegister register_thread( "SaveSection: guilds" );
-              try
-              {
-                write_guilds( sc.guilds );
-              }
-              catch ( ... )
-              {
-                POLLOG_ERROR << "failed to store guilds datafile!\n";
-                Clib::force_backtrace();
-                result = false;
-              }
-            }
-#pragma omp section
-            {
-              threadhelp::ThreadRegister register_thread( "SaveSection: datastore" );
-              try
-              {
-                Module::write_datastore( sc.datastore );
-                // Atomically (hopefully) perform the switch.
-                Module::commit_datastore();
-              }
-              catch ( ... )
-              {
-                POLLOG_ERROR << "failed to store datastore datafile!\n";
-                Clib::force_backtrace();
-                result = false;
-              }
-            }
-#pragma omp section
-            {
-              threadhelp::ThreadRegister register_thread( "SaveSection: party" );
-              try
-              {
-                write_party( sc.party );
-              }
-              catch ( ... )
-              {
-                POLLOG_ERROR << "failed to store party datafile!\n";
-                Clib::force_backtrace();
-                result = false;
-              }
-            }
+          omp_set_num_threads( max_threads );
+#endif
+          try
+          {
+            SaveContext sc;
+            bool result = write_datafiles( sc, false );
+            critical_promise->set_value( result );  // critical part end
+          } // deconstructor of the SaveContext flushes and joins the queues
+          catch ( ... )
+          {
+            POLLOG_ERROR << "failed to save datafiles!\n";
+            Clib::force_backtrace();
+            critical_promise->set_value( false );  // critical part end
           }
-          critical_promise->set_value( result );  // critical part end
-        } // deconstructor of the SaveContext flushes and joins the queues
-        catch ( ... )
-        {
-          POLLOG_ERROR << "failed to save datafiles!\n";
-          Clib::force_backtrace();
-          critical_promise->set_value( false );  // critical part end
-        }
-        commit( "pol" );
-        commit( "objects" );
-        commit( "pcs" );
-        commit( "pcequip" );
-        commit( "npcs" );
-        commit( "npcequip" );
-        commit( "items" );
-        commit( "multis" );
-        commit( "storage" );
-        commit( "resource" );
-        commit( "guilds" );
-        commit( "datastore" );
-        commit( "parties" );
-        return true;
-      } ) );
-      critical_future.wait();  // wait for end of critical part
+          commit_datafiles();
+          return true;
+        } ) );
+        critical_future.wait();  // wait for end of critical part
+      }
 
       if ( Plib::systemstate.accounts_txt_dirty ) // write accounts extra, since it uses extra thread for io operations would be to many threads working
       {
         Accounts::write_account_data();
       }
 
-      commit_incremental_saves();
-      objStorageManager.incremental_save_count = 0;
+      // a snapshot save settles them in finish_snapshot_save(), once it is known if it succeeded
+      if ( !snapshot )
+      {
+        commit_incremental_saves();
+        objStorageManager.incremental_save_count = 0;
+      }
       timer.stop();
-      objStorageManager.objecthash.ClearDeleted();
+      if ( !snapshot )
+        objStorageManager.objecthash.ClearDeleted();
       //optimize_zones(); // shrink zone vectors TODO this takes way to much time!
 
       // cout << "Clean: " << UObject::clean_writes << " Dirty: " <<
@@ -1338,7 +1622,8 @@ namespace Pol {
       dirty_writes = UObject::dirty_writes;
       elapsed_ms = timer.ellapsed();
 
-      objStorageManager.incremental_saves_disabled = false;
+      if ( !snapshot )
+        objStorageManager.incremental_saves_disabled = false;
       return 0;
     }
 
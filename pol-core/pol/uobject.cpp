@@ -22,6 +22,7 @@ Notes
 #include "../plib/realm.h"
 #include "../plib/systemstate.h"
 
+#include "globals/network.h"
 #include "globals/state.h"
 #include "item/item.h"
 #include "item/itemdesc.h"
@@ -80,6 +81,7 @@ namespace Pol {
 	  facing( FACING_N ),
 	  realm( NULL ),
 	  saveonexit_( true ),
+	  listen_point_count( 0 ),
 	  uobj_class_( static_cast<const u8>( i_uobj_class ) ),
 	  dirty_( true ),
 	  _rev( 0 ),
@@ -108,7 +110,7 @@ namespace Pol {
     size_t UObject::estimatedSize() const
     {
       size_t size = sizeof(UObject) + proplist_.estimatedSize();
-      size += dynmap.size() * (sizeof( unsigned short ) + sizeof( boost::any ) * 2 + ( sizeof(void*)* 3 + 1 ) / 2);
+      size += dynprops_.estimatedSize() - sizeof( DynProps );
       return size;
     }
 
@@ -132,6 +134,7 @@ namespace Pol {
 
 		set_dirty(); // we will have to write a 'object deleted' directive once
 
+		networkManager.tooltip_cache->erase( serial );
 		serial = 0; // used to set serial_ext to 0.  This way, if debugging, one can find out the old serial
 		passert( ref_counted::count() >= 1 );
 
@@ -165,6 +168,18 @@ namespace Pol {
 	  proplist_.setprop( propname, propvalue ); // VOID_RETURN
 	}
 
+	Bscript::BObjectImp* UObject::getpropimp( const std::string& propname ) const
+	{
+	  return proplist_.getpropimp( propname );
+	}
+
+	void UObject::setpropimp( const std::string& propname, const Bscript::BObjectImp& propvalue )
+	{
+	  if ( propname[0] != '#' )
+		set_dirty();
+	  proplist_.setpropimp( propname, propvalue );
+	}
+
 	void UObject::eraseprop( const std::string& propname )
 	{
 	  if ( propname[0] != '#' )
@@ -2,6 +2,7 @@
 History
 =======
 2009/02/01 MuadDib:   Resistance storage added.
+2026/10/17 agent:     dynmap replaced by DynProps
 
 Notes
 =======
@@ -22,12 +23,12 @@ Notes
 
 #include "../clib/refptr.h"
 #include "proplist.h"
+#include "dynproperties.h"
 
 #include "../clib/boostutils.h"
 
 #include "../bscript/objmembers.h" // needed for knowing the definitions of MBR_...
 
-#include <boost/any.hpp>
 #include <boost/flyweight.hpp>
 
 #include <iosfwd>
@@ -150,49 +151,6 @@ namespace Pol {
 #	pragma pack()
 #endif
 
-	template<typename T>
-	struct MemberHelper
-	{
-	public:
-	  static T getmember( const std::map<unsigned short, boost::any> &_map, unsigned short member )
-	  {
-		auto itr = _map.find( member );
-
-		if ( itr == _map.end() )
-		  return 0;
-		else
-		  return boost::any_cast<T>( ( *itr ).second );
-	  };
-	  static void setmember( std::map<unsigned short, boost::any> &_map, unsigned short member, T value )
-	  {
-		if ( value == 0 )
-		  _map.erase( member );
-		else
-		  _map[member] = value;
-	  };
-	};
-	template<>
-	struct MemberHelper<std::string>
-	{
-	public:
-	  static std::string getmember( const std::map<unsigned short, boost::any> &_map, unsigned short member )
-	  {
-		auto itr = _map.find( member );
-
-		if ( itr == _map.end() )
-		  return "";
-		else
-		  return boost::any_cast<std::string>( ( *itr ).second );
-	  };
-      static void setmember(std::map<unsigned short, boost::any> &_map, unsigned short member, std::string value)
-	  {
-		if ( value.empty() )
-		  _map.erase( member );
-		else
-		  _map[member] = value;
-	  };
-	};
-
 	/* NOTES:
 			if you add fields, be sure to update Items::create().
 			*/
@@ -219,6 +177,8 @@ namespace Pol {
 
 	  bool getprop( const std::string& propname, std::string& propvalue ) const;
 	  void setprop( const std::string& propname, const std::string& propvalue );
+	  Bscript::BObjectImp* getpropimp( const std::string& propname ) const;
+	  void setpropimp( const std::string& propname, const Bscript::BObjectImp& propvalue );
 	  void eraseprop( const std::string& propname );
 	  void copyprops( const UObject& obj );
 	  void copyprops( const PropertyList& proplist );
@@ -277,6 +237,7 @@ namespace Pol {
 	  virtual const char *classname() const = 0;
 
       virtual size_t estimatedSize() const;
+      const DynProps& dynprops() const { return dynprops_; }
 
 
 	  bool isa( UOBJ_CLASS uobj_class ) const;
@@ -348,6 +309,8 @@ namespace Pol {
 	  bool saveonexit_;	// 1-25-2009 MuadDib added. So far only items will make use of this.
 	  // Another possibility is adding this to NPCs for WoW style Instances.
 
+	  u16 listen_point_count; // speech listen points registered on this object, see listenpt.h
+
 	private:
 	  const u8 uobj_class_;
 	  mutable bool dirty_;
@@ -359,17 +322,17 @@ namespace Pol {
       template <typename T>
       T getmember(unsigned short member) const
       {
-          return MemberHelper<T>::getmember(dynmap, member);
+          return dynprops_.get<T>(member);
       }
       template <typename T>
       void setmember(unsigned short member, T value)
       {
-          MemberHelper<T>::setmember(dynmap, member, value);
+          dynprops_.set<T>(member, value);
       }
 
 	private:
 	  PropertyList proplist_;
-	  std::map<unsigned short, boost::any> dynmap;
+	  DynProps dynprops_;
       
 	private: // not implemented:
 	  UObject( const UObject& );
@@ -26,7 +26,7 @@ namespace Pol {
 			++itr )
 	  {
 		OSTRINGSTREAM os;
-		os << ( *itr ).first << ": " << ( *itr ).second;
+		os << ( *itr ).first << ": " << ( *itr ).second.packed();
 		send_sysmessage( client, OSTRINGSTREAM_STR( os ) );
 	  }
 	}
@@ -19,11 +19,13 @@ namespace Pol {
             start_time(poltime()),
             warn_runaway_on_cycle(Plib::systemstate.config.runaway_script_threshold),
             runaway_cycles(0),
+            slice_left(-1),
             eventmask(0),
             area_size(0),
             speech_size(1),
             can_access_offline_mobiles(false),
             auxsvc_assume_string(false),
+            scheduled(false),
             pParent(NULL),
             pChild(NULL)
         {
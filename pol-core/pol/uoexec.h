@@ -41,12 +41,18 @@ namespace Pol {
 	  u64 warn_runaway_on_cycle;
 	  u64 runaway_cycles;
 
+	  // instructions left of the current time slice after the parallel part
+	  // of run_ready(), -1 if the script didn't take part in it
+	  int slice_left;
+
 	  unsigned int eventmask;
 	  unsigned short area_size;
 	  unsigned short speech_size;
 
 	  bool can_access_offline_mobiles;
 	  bool auxsvc_assume_string;
+	  // run by the scheduler (not to completion), so it can be suspended
+	  bool scheduled;
 	  weak_ptr_owner<UOExecutor> weakptr;
 
 	  UOExecutor	*pParent, *pChild;
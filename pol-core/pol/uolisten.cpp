@@ -12,6 +12,7 @@ Notes
 #include "uoclient.h"
 #include "network/client.h"
 #include "network/cliface.h"
+#include "network/clientthread.h"
 
 #include "core.h"
 #include "polsem.h"
@@ -116,6 +117,15 @@ namespace Pol {
 		if ( SL.GetConnection( timeout ) )
 		{
 		  // create an appropriate Client object
+#ifdef __linux__
+		  if ( Plib::systemstate.config.network_io_threads )
+		  {
+			UoClientThread thread( ls, SL );
+			thread.create();
+			add_client_to_reactor( thread.client );
+		  }
+		  else
+#endif
 		  if ( Plib::systemstate.config.use_single_thread_login )
 		  {
 			UoClientThread* thread = new UoClientThread( ls, SL );
@@ -161,6 +171,10 @@ namespace Pol {
 
 	void start_uo_client_listeners( void )
 	{
+#ifdef __linux__
+	  if ( Plib::systemstate.config.network_io_threads )
+		start_client_reactors();
+#endif
 	  for ( unsigned i = 0; i < networkManager.uoclient_listeners.size(); ++i )
 	  {
 		UoClientListener* ls = &networkManager.uoclient_listeners[i];
@@ -61,6 +61,7 @@ Notes
 #include "network/client.h"
 #include "network/packets.h"
 #include "cmdlevel.h"
+#include "decay.h"
 #include "door.h"
 #include "exscrobj.h"
 #include "fnsearch.h"
@@ -978,6 +979,7 @@ namespace Pol {
 		  return new BLong( invisible() );
 		case MBR_DECAYAT:
 		  decayat_gameclock_ = value;
+		  Core::schedule_decay( this );
 		  return new BLong( decayat_gameclock_ );
 		case MBR_SELLPRICE:
 		  return new BLong( sellprice_ = value );
@@ -3694,6 +3696,9 @@ namespace Pol {
         case MBR_UO_EXPANSION_CLIENT:
           return BObjectRef( new BLong( obj_->UOExpansionFlagClient ) );
           break;
+        case MBR_TRANSMIT_STATS:
+          return BObjectRef( obj_->gettransmitstats() );
+          break;
         default: return BObjectRef( UninitObject::create() );
       }
     }
@@ -17,6 +17,8 @@ Notes
 #include "item/item.h"
 #include "multi/multi.h"
 
+#include "decay.h"
+#include "listenpt.h"
 #include "realms.h"
 #include "globals/uvars.h"
 
@@ -30,6 +32,41 @@ Notes
 
 namespace Pol {
   namespace Core {
+	namespace {
+	  void add_item_to_tile( Zone& zone, Items::Item* item )
+	  {
+		zone.tile_items[zone_tile_key( item->x, item->y )].push_back( item );
+	  }
+
+	  bool erase_tile_item( Zone& zone, ZoneTileItems::iterator tile, Items::Item* item )
+	  {
+		ZoneItems& titems = tile->second;
+		ZoneItems::iterator itr = std::find( titems.begin(), titems.end(), item );
+		if ( itr == titems.end() )
+		  return false;
+		titems.erase( itr );
+		if ( titems.empty() )
+		  zone.tile_items.erase( tile );
+		return true;
+	  }
+
+	  void remove_item_from_tile( Zone& zone, unsigned short x, unsigned short y, Items::Item* item )
+	  {
+		ZoneTileItems::iterator tile = zone.tile_items.find( zone_tile_key( x, y ) );
+		if ( tile != zone.tile_items.end() && erase_tile_item( zone, tile, item ) )
+		  return;
+
+		// the position was changed without telling the world
+		POLLOG_ERROR.Format( "remove_item_from_tile: item 0x{:X} not indexed at {},{}\n" )
+		  << item->serial << x << y;
+		for ( tile = zone.tile_items.begin(); tile != zone.tile_items.end(); ++tile )
+		{
+		  if ( erase_tile_item( zone, tile, item ) )
+			return;
+		}
+	  }
+	}
+
 	void add_item_to_world( Items::Item* item )
 	{
 	  Zone& zone = getzone( item->x, item->y, item->realm );
@@ -38,6 +75,10 @@ namespace Pol {
 
 	  item->realm->add_toplevel_item(*item);
 	  zone.items.push_back( item );
+	  add_item_to_tile( zone, item );
+	  item->in_world( true );
+	  schedule_decay( item );
+	  move_listen_points( item, NULL, 0, 0, item->realm, item->x, item->y );
 	}
 
 	void remove_item_from_world( Items::Item* item )
@@ -64,6 +105,9 @@ namespace Pol {
 
       item->realm->remove_toplevel_item(*item);
 	  zone.items.erase( itr );
+	  remove_item_from_tile( zone, item->x, item->y, item );
+	  item->in_world( false );
+	  move_listen_points( item, item->realm, item->x, item->y, NULL, 0, 0 );
 	}
 
 	void add_multi_to_world( Multi::UMulti* multi )
@@ -71,6 +115,7 @@ namespace Pol {
 	  Zone& zone = getzone( multi->x, multi->y, multi->realm );
 	  zone.multis.push_back( multi );
       multi->realm->add_multi(*multi);
+	  move_listen_points( multi, NULL, 0, 0, multi->realm, multi->x, multi->y );
 	}
 
 	void remove_multi_from_world( Multi::UMulti* multi )
@@ -82,6 +127,7 @@ namespace Pol {
       
       multi->realm->remove_multi(*multi);
 	  zone.multis.erase( itr );
+	  move_listen_points( multi, multi->realm, multi->x, multi->y, NULL, 0, 0 );
 	}
 
 	void move_multi_in_world( unsigned short oldx, unsigned short oldy,
@@ -104,6 +150,7 @@ namespace Pol {
           oldrealm->remove_multi(*multi);
           multi->realm->add_multi(*multi);
       }
+	  move_listen_points( multi, oldrealm, oldx, oldy, multi->realm, newx, newy );
 	}
 
 	int get_toplevel_item_count()
@@ -211,6 +258,7 @@ namespace Pol {
             oldrealm->remove_mobile(*chr, Plib::WorldChangeReason::Moved);
             chr->realm->add_mobile(*chr, Plib::WorldChangeReason::Moved);
         }
+        move_listen_points(chr, oldrealm, oldx, oldy, chr->realm, newx, newy);
     }
 
 	void MoveItemWorldPosition( unsigned short oldx, unsigned short oldy,
@@ -239,11 +287,17 @@ namespace Pol {
         passert( std::find( newzone.items.begin(), newzone.items.end(), item ) == newzone.items.end() );
 		newzone.items.push_back( item );
 	  }
+	  if ( &oldzone != &newzone || oldx != item->x || oldy != item->y )
+	  {
+		remove_item_from_tile( oldzone, oldx, oldy, item );
+		add_item_to_tile( newzone, item );
+	  }
 
       if (oldrealm != item->realm) {
           oldrealm->remove_toplevel_item(*item);
           item->realm->add_toplevel_item(*item);
       }
+	  move_listen_points( item, oldrealm, oldx, oldy, item->realm, item->x, item->y );
 	}
 
     // If the ClrCharacterWorldPosition() fails, this function will find the actual char position and report
@@ -417,7 +471,9 @@ namespace Pol {
             realm->zone[x][y].characters.shrink_to_fit();
             realm->zone[x][y].npcs.shrink_to_fit();
             realm->zone[x][y].items.shrink_to_fit();
+            realm->zone[x][y].tile_items.rehash( 0 );
             realm->zone[x][y].multis.shrink_to_fit();
+            realm->zone[x][y].listen_points.shrink_to_fit();
           }
         }
       }
@@ -30,6 +30,7 @@ Notes
 #include "../clib/passert.h"
 #include "../plib/realm.h"
 
+#include <unordered_map>
 #include <vector>
 
 namespace Pol {
@@ -43,6 +44,7 @@ namespace Pol {
 	class Item;
   }
   namespace Core {
+	class ListenPoint;
 
 	void add_item_to_world( Items::Item* item );
 	void remove_item_from_world( Items::Item* item );
@@ -72,6 +74,9 @@ namespace Pol {
 	typedef std::vector<Mobile::Character*> ZoneCharacters;
 	typedef std::vector<Multi::UMulti*> ZoneMultis;
 	typedef std::vector<Items::Item*> ZoneItems;
+	typedef std::vector<ListenPoint*> ZoneListenPoints;
+	// the items of a zone by tile, key is zone_tile_key()
+	typedef std::unordered_map<unsigned short, ZoneItems> ZoneTileItems;
 
 	struct Zone
 	{
@@ -79,11 +84,32 @@ namespace Pol {
       ZoneCharacters npcs;
 	  ZoneItems items;
 	  ZoneMultis multis;
+	  ZoneTileItems tile_items;
+	  ZoneListenPoints listen_points;
 	};
 
 	const unsigned WGRID_SIZE = 64;
 	const unsigned WGRID_SHIFT = 6;
 
+	// position of a tile inside its zone
+	inline unsigned short zone_tile_key( unsigned short x, unsigned short y )
+	{
+	  return static_cast<unsigned short>( ( ( x & ( WGRID_SIZE - 1 ) ) << WGRID_SHIFT ) | ( y & ( WGRID_SIZE - 1 ) ) );
+	}
+
+	// the toplevel items lying on x,y, NULL if there are none.
+	// callers still compare the item position, like when scanning the zone.
+	inline const ZoneItems* get_tile_items( unsigned short x, unsigned short y, const Plib::Realm* realm )
+	{
+	  if ( x >= realm->width() || y >= realm->height() )
+		return NULL;
+	  const ZoneTileItems& tiles = realm->zone[x >> WGRID_SHIFT][y >> WGRID_SHIFT].tile_items;
+	  ZoneTileItems::const_iterator itr = tiles.find( zone_tile_key( x, y ) );
+	  if ( itr == tiles.end() )
+		return NULL;
+	  return &itr->second;
+	}
+
     inline void zone_convert( unsigned short x, unsigned short y, unsigned short* wx, unsigned short* wy, const Plib::Realm* realm )
 	{
 	  passert( x < realm->width() );
@@ -7,8 +7,10 @@ Notes
 
 */
 
+#include "../clib/binarycfg.h"
 #include "../clib/strutil.h"
 #include "../clib/logfacility.h"
+#include "../clib/timer.h"
 
 #include "../plib/mapcell.h"
 #include "../plib/mapserver.h"
@@ -19,9 +21,13 @@ Notes
 #include "../plib/realm.h"
 #include "../plib/maptile.h"
 #include "../plib/maptileserver.h"
+#include "../plib/staticblock.h"
+#include "../plib/staticserver.h"
 
 #include <string>
 #include <fstream>
+#include <random>
+#include <vector>
 
 namespace Pol {
   namespace Plib {
@@ -34,7 +40,10 @@ namespace Pol {
 	void usage()
 	{
       ERROR_PRINT << "Usage: poltool [cmd] [options]\n"
-        << "\t  mapdump x1 y1 [x2 y2 realm]       writes polmap info to polmap.html\n";
+        << "\t  mapdump x1 y1 [x2 y2 realm]       writes polmap info to polmap.html\n"
+        << "\t  txt2bin file.txt [file.bin]       converts a data file to binary form\n"
+        << "\t  bin2txt file.bin [file.txt]       converts a binary data file to text\n"
+        << "\t  benchmap [realm] [count]          compares lookup times of the map backends\n";
 	}
 
 	int mapdump( int argc, char* argv[] )
@@ -104,6 +113,153 @@ namespace Pol {
       ofs << "</table>" << std::endl;
 	  return 0;
 	}
+
+	struct BenchPos
+	{
+	  unsigned short x;
+	  unsigned short y;
+	};
+
+	// random locations, and a walk of single steps like a moving mobile does
+	void bench_positions( const Plib::RealmDescriptor& descriptor, size_t count,
+						  std::vector<BenchPos>& random, std::vector<BenchPos>& walk )
+	{
+	  std::mt19937 rng( 42 );
+	  random.resize( count );
+	  for ( auto& pos : random )
+	  {
+		pos.x = static_cast<unsigned short>( rng() % descriptor.width );
+		pos.y = static_cast<unsigned short>( rng() % descriptor.height );
+	  }
+	  walk.resize( count );
+	  int x = descriptor.width / 2, y = descriptor.height / 2;
+	  for ( auto& pos : walk )
+	  {
+		x = std::min( std::max( x + static_cast<int>( rng() % 3 ) - 1, 0 ), descriptor.width - 1 );
+		y = std::min( std::max( y + static_cast<int>( rng() % 3 ) - 1, 0 ), descriptor.height - 1 );
+		pos.x = static_cast<unsigned short>( x );
+		pos.y = static_cast<unsigned short>( y );
+	  }
+	}
+
+	template <class Lookup>
+	long long bench_lookups( const std::vector<BenchPos>& positions, Lookup lookup, size_t& checksum )
+	{
+	  Tools::Timer<> timer;
+	  for ( const auto& pos : positions )
+		checksum += lookup( pos.x, pos.y );
+	  timer.stop();
+	  return timer.ellapsed();
+	}
+
+	void bench_report( const char* name, long long t_load, size_t heap, long long t_random, long long t_walk, size_t count )
+	{
+	  INFO_PRINT.Format( "  {:<22} load {:>6} ms  heap {:>7} kb  random {:>6} ms ({:>5} ns)  walk {:>6} ms ({:>5} ns)\n" )
+		<< name << t_load << heap / 1024
+		<< t_random << ( count ? t_random * 1000000 / static_cast<long long>( count ) : 0 )
+		<< t_walk << ( count ? t_walk * 1000000 / static_cast<long long>( count ) : 0 );
+	}
+
+	int benchmap( int argc, char* argv[] )
+	{
+	  const char* realmname = argc >= 2 ? argv[1] : "britannia";
+	  size_t count = argc >= 3 ? strtoul( argv[2], NULL, 0 ) : 10000000;
+	  Plib::RealmDescriptor descriptor = Plib::RealmDescriptor::Load( realmname );
+
+	  std::vector<BenchPos> random, walk;
+	  bench_positions( descriptor, count, random, walk );
+	  INFO_PRINT << "Realm " << realmname << ", " << count << " lookups per run:\n";
+
+	  // checksums keep the lookups from being optimized away, and show the backends agree
+	  const char* types[] = { "file", "memory", "mapped" };
+	  for ( const char* type : types )
+	  {
+		Tools::Timer<> timer;
+		std::unique_ptr<Plib::MapServer> mapserver( Plib::MapServer::Create( descriptor, type ) );
+		timer.stop();
+		size_t checksum = 0;
+		Plib::MapShapeList shapes;
+		auto lookup = [&]( unsigned short x, unsigned short y )
+		{
+		  shapes.clear();
+		  mapserver->GetMapShapes( shapes, x, y, Plib::FLAG::MOVE_FLAGS );
+		  return shapes.size();
+		};
+		long long t_random = bench_lookups( random, lookup, checksum );
+		long long t_walk = bench_lookups( walk, lookup, checksum );
+		bench_report( ( std::string( "MapServer " ) + type ).c_str(), timer.ellapsed(), mapserver->sizeEstimate(), t_random, t_walk, count );
+		INFO_PRINT << "    checksum " << checksum << "\n";
+	  }
+	  for ( bool mapped : { false, true } )
+	  {
+		Tools::Timer<> timer;
+		std::unique_ptr<Plib::StaticServer> staticserver( new Plib::StaticServer( descriptor, mapped ) );
+		timer.stop();
+		size_t checksum = 0;
+		Plib::StaticEntryList statics;
+		auto lookup = [&]( unsigned short x, unsigned short y )
+		{
+		  statics.clear();
+		  staticserver->getstatics( statics, x, y );
+		  return statics.size();
+		};
+		long long t_random = bench_lookups( random, lookup, checksum );
+		long long t_walk = bench_lookups( walk, lookup, checksum );
+		bench_report( mapped ? "StaticServer mapped" : "StaticServer memory", timer.ellapsed(), staticserver->sizeEstimate(), t_random, t_walk, count );
+		INFO_PRINT << "    checksum " << checksum << "\n";
+	  }
+	  for ( bool mapped : { false, true } )
+	  {
+		Tools::Timer<> timer;
+		std::unique_ptr<Plib::MapTileServer> maptileserver( new Plib::MapTileServer( descriptor, mapped ) );
+		timer.stop();
+		size_t checksum = 0;
+		auto lookup = [&]( unsigned short x, unsigned short y )
+		{
+		  return static_cast<size_t>( maptileserver->GetMapTile( x, y ).landtile );
+		};
+		long long t_random = bench_lookups( random, lookup, checksum );
+		long long t_walk = bench_lookups( walk, lookup, checksum );
+		bench_report( mapped ? "MapTileServer mapped" : "MapTileServer file", timer.ellapsed(), maptileserver->sizeEstimate(), t_random, t_walk, count );
+		INFO_PRINT << "    checksum " << checksum << "\n";
+	  }
+	  return 0;
+	}
+
+	// argv[1] is the input, argv[2] the optional output. the default output
+	// swaps the extension of the input to to_ext.
+	int convert_cfg( int argc, char* argv[], const char* to_ext,
+					 bool( *convert )( const std::string&, const std::string& ) )
+	{
+	  if ( argc < 2 )
+	  {
+		usage();
+		return 1;
+	  }
+	  std::string infile = argv[1];
+	  std::string outfile;
+	  if ( argc >= 3 )
+	  {
+		outfile = argv[2];
+	  }
+	  else
+	  {
+		outfile = infile;
+		std::string::size_type dot = outfile.rfind( '.' );
+		if ( dot != std::string::npos && outfile.find_first_of( "/\\", dot ) == std::string::npos )
+		  outfile.erase( dot );
+		outfile += to_ext;
+	  }
+	  if ( outfile == infile )
+	  {
+		ERROR_PRINT << "Input and output file are the same\n";
+		return 1;
+	  }
+	  if ( !convert( infile, outfile ) )
+		return 1;
+	  INFO_PRINT << "Converted " << infile << " to " << outfile << "\n";
+	  return 0;
+	}
   }
 
   int xmain( int argc, char* argv[] )
@@ -119,6 +275,18 @@ namespace Pol {
 	{
 	  return Poltool::mapdump( argc - 1, argv + 1 );
 	}
+	else if ( cmd == "txt2bin" )
+	{
+	  return Poltool::convert_cfg( argc - 1, argv + 1, ".bin", Clib::convert_text_to_binary_cfg );
+	}
+	else if ( cmd == "bin2txt" )
+	{
+	  return Poltool::convert_cfg( argc - 1, argv + 1, ".txt", Clib::convert_binary_to_text_cfg );
+	}
+	else if ( cmd == "benchmap" )
+	{
+	  return Poltool::benchmap( argc - 1, argv + 1 );
+	}
 	else
 	{
       ERROR_PRINT << "Unknown command " << cmd << "\n";
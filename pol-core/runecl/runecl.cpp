@@ -223,9 +223,9 @@ namespace Pol {
       {
         fmt::Writer tmp;
         tmp << "Profiling information: \n"
-          << "\tEObjectImp constructions: " << eobject_imp_constructions << "\n";
+          << "\tEObjectImp constructions: " << static_cast<int>( eobject_imp_constructions ) << "\n";
         if ( eobject_imp_count )
-          tmp << "\tRemaining BObjectImps: " << eobject_imp_count << "\n";
+          tmp << "\tRemaining BObjectImps: " << static_cast<int>( eobject_imp_count ) << "\n";
         tmp << "\tInstruction cycles: " << escript_instr_cycles << "\n"
           << "\tInnerExec calls: " << escript_execinstr_calls << "\n"
           << "\tClocks: " << clocks << " (" << seconds << " seconds)" << "\n"
@@ -9,6 +9,8 @@ create_tiles_cfg - will handle tile names with 20 chars too
 2006/04/09 Shinigami: added uoconvert.cfg flag ShowRoofAndPlatformWarning
 2006/05/26 Shinigami: there was another part with ShowRoofAndPlatformWarning-check, commented out
 2009/12/02 Turley:    added config.max_tile_id & termur support - Tomi
+2026/10/17 agent:     map/statics: solid blocks and statics stripes are calculated on worker threads (threads=N)
+                      map/statics: incremental=1 only regenerates blocks whose source data changed
 
 Notes
 =======
@@ -16,6 +18,7 @@ Notes
 */
 
 
+#include "../pol/blockchecksums.h"
 #include "../pol/uofile.h"
 #include "../pol/objtype.h"
 #include "../pol/polcfg.h"
@@ -30,6 +33,7 @@ Notes
 #include "../plib/mapserver.h"
 #include "../plib/mapshape.h"
 #include "../plib/mapwriter.h"
+#include "../plib/navgrid.h"
 #include "../plib/realmdescriptor.h"
 #include "../plib/systemstate.h"
 
@@ -40,13 +44,18 @@ Notes
 #include "../clib/fileutil.h"
 #include "../clib/logfacility.h"
 #include "../clib/passert.h"
+#include "../clib/threadhelp.h"
 #include "../clib/timer.h"
 
+#include <algorithm>
+#include <deque>
+#include <future>
 #include <string>
 #include <set>
 #include <vector>
 #include <stdexcept>
 #include <limits>
+#include <memory>
 
 #ifdef _MSC_VER
 #pragma warning(disable:4996) // deprecation warning for fopen
@@ -74,8 +83,9 @@ namespace Pol {
 	
 	
 	void generate_map();
-    void create_map(const std::string& realm, unsigned short width, unsigned short height);
+    void create_map(const std::string& realm, unsigned short width, unsigned short height, unsigned threads, bool incremental);
     void update_map(const std::string& realm, unsigned short x, unsigned short y);
+	unsigned thread_count();
 	
 	void create_multis_cfg();
 	void create_tiles_cfg();
@@ -210,7 +220,20 @@ namespace Pol {
 	  return ( ( f1 ^ f2 ) == bits );
 	}
 
+	// solids of one SOLIDX_X_SIZE x SOLIDX_Y_SIZE block, calculated before they are written
+	struct SolidBlock
+	{
+	  unsigned short x_base;
+	  unsigned short y_base;
+	  MAPCELL cells[SOLIDX_X_SIZE][SOLIDX_Y_SIZE];
+	  unsigned short solid_count[SOLIDX_X_SIZE][SOLIDX_Y_SIZE];
+	  std::vector<SOLIDS_ELEM> solids; // in cell order
+	};
+
 	void ProcessSolidBlock( unsigned short x_base, unsigned short y_base, MapWriter& mapwriter );
+	void ProcessSolidBlocks( const std::vector<std::pair<unsigned short, unsigned short>>& coords, size_t blocks_per_task,
+							 unsigned threads, MapWriter& mapwriter );
+	u32 conversion_settings();
 
 	unsigned empty = 0, nonempty = 0;
 	unsigned total_statics = 0;
@@ -232,34 +255,87 @@ namespace Pol {
         << "total statics=" << total_statics << "\n";
 	}
 
-    void create_map(const std::string& realm, unsigned short width, unsigned short height)
+	// everything besides the uo data the solids depend on
+	u32 conversion_settings()
+	{
+	  std::vector<u32> values;
+	  values.push_back( cfg_use_no_shoot );
+	  values.push_back( cfg_LOS_through_windows );
+	  values.push_back( static_cast<u32>( uo_mapid ) );
+	  values.push_back( static_cast<u32>( uo_usedif ) );
+	  return BlockChecksums::settings_checksum( values );
+	}
+
+	// threads=N, defaults to the number of cores
+	unsigned thread_count()
 	{
+	  int threads = Clib::LongArg2( "threads=", 0 );
+	  if ( threads <= 0 )
+		threads = static_cast<int>( std::thread::hardware_concurrency() );
+	  return threads > 0 ? static_cast<unsigned>( threads ) : 1;
+	}
+
+    void create_map(const std::string& realm, unsigned short width, unsigned short height, unsigned threads, bool incremental)
+	{
+      std::string directory = "realm/" + realm + "/";
+      std::string checksum_file = directory + "mapcrc.dat";
 	  auto mapwriter = new MapWriter();
       INFO_PRINT << "Creating map base and solids files.\n"
         << "  Realm: " << realm << "\n"
         << "  Map ID: " << uo_mapid << "\n"
         << "  Use Dif files: " << ( uo_usedif ? "Yes" : "No" ) << "\n"
         << "  Size: " << uo_map_width << "x" << uo_map_height << "\n"
-        << "Initializing files: ";
-	  mapwriter->CreateNewFiles( realm, width, height );
-      INFO_PRINT << "Done.\n";
+        << "  Threads: " << threads << "\n";
 	  Tools::Timer<> timer;
 	  rawmapfullread();
 	  rawstaticfullread();
       INFO_PRINT << "  Reading mapfiles time: " << timer.ellapsed() << " ms.\n";
+
+	  // solids of a cell depend on the map of the surrounding cells and on its own statics
+	  BlockChecksums checksums, old_checksums;
+	  checksums.calculate( width, height, true, true, conversion_settings() );
+	  bool update = incremental &&
+		Clib::FileExists( directory + "realm.cfg" ) &&
+		Clib::FileExists( directory + "base.dat" ) &&
+		old_checksums.load( checksum_file, width, height, conversion_settings() );
+
+	  std::vector<std::pair<unsigned short, unsigned short>> coords;
 	  for ( unsigned short y_base = 0; y_base < height; y_base += SOLIDX_Y_SIZE )
 	  {
 		for ( unsigned short x_base = 0; x_base < width; x_base += SOLIDX_X_SIZE )
 		{
-		  ProcessSolidBlock( x_base, y_base, *mapwriter );
+		  if ( !update || checksums.changed( old_checksums, x_base - 2, y_base - 2, x_base + SOLIDX_X_SIZE + 1, y_base + SOLIDX_Y_SIZE + 1 ) )
+			coords.push_back( std::make_pair( x_base, y_base ) );
 		}
-        INFO_PRINT << "\rConverting: " << y_base * 100 / height << "%";
 	  }
+
+	  if ( update )
+	  {
+		mapwriter->OpenExistingFiles( realm );
+		if ( mapwriter->width() != width || mapwriter->height() != height )
+		  throw std::runtime_error( "realm.cfg size differs from the given width/height, incremental update not possible" );
+        INFO_PRINT << "Source data changed in " << coords.size() << " of " << ( width / SOLIDX_X_SIZE ) * ( height / SOLIDX_Y_SIZE ) << " blocks.\n";
+	  }
+	  else
+	  {
+        INFO_PRINT << "Initializing files: ";
+		mapwriter->CreateNewFiles( realm, width, height );
+        INFO_PRINT << "Done.\n";
+	  }
+
+	  ProcessSolidBlocks( coords, ( width + SOLIDX_X_SIZE - 1 ) / SOLIDX_X_SIZE, threads, *mapwriter );
 	  timer.stop();
 
 	  mapwriter->WriteConfigFile();
 	  delete mapwriter;
+	  if ( !checksums.save( checksum_file ) )
+        ERROR_PRINT << "Unable to write " << checksum_file << "\n";
 
+	  if ( coords.empty() )
+	  {
+        INFO_PRINT << "No changed blocks.\n";
+		return;
+	  }
       INFO_PRINT << "\rConversion complete.              \n"
         << "Conversion details:\n"
         << "  Total blocks: " << empty + nonempty << "\n"
@@ -455,18 +531,26 @@ namespace Pol {
 		return lowest_z;
 	}
 
-	void ProcessSolidBlock( unsigned short x_base, unsigned short y_base, MapWriter& mapwriter )
+	void solid_block_extent( unsigned short x_base, unsigned short y_base, unsigned short& x_add_max, unsigned short& y_add_max )
 	{
-	  unsigned int idx2_offset = 0;
-	  SOLIDX2_ELEM idx2_elem;
-	  memset( &idx2_elem, 0, sizeof idx2_elem );
-	  idx2_elem.baseindex = mapwriter.NextSolidIndex();
-
-	  unsigned short x_add_max = SOLIDX_X_SIZE, y_add_max = SOLIDX_Y_SIZE;
+	  x_add_max = SOLIDX_X_SIZE;
+	  y_add_max = SOLIDX_Y_SIZE;
 	  if ( x_base + x_add_max > uo_map_width )
 		x_add_max = uo_map_width - x_base;
 	  if ( y_base + y_add_max > uo_map_height )
 		y_add_max = uo_map_height - y_base;
+	}
+
+	// only reads the (fully loaded) uo data, so blocks can be calculated concurrently
+	void CalcSolidBlock( SolidBlock& block )
+	{
+	  unsigned short x_base = block.x_base;
+	  unsigned short y_base = block.y_base;
+	  memset( block.solid_count, 0, sizeof block.solid_count );
+	  block.solids.clear();
+
+	  unsigned short x_add_max, y_add_max;
+	  solid_block_extent( x_base, y_base, x_add_max, y_add_max );
 
 	  for ( unsigned short x_add = 0; x_add < x_add_max; ++x_add )
 	  {
@@ -750,20 +834,12 @@ namespace Pol {
 		  if ( !shapes.empty() )
 			cell.flags |= FLAG::MORE_SOLIDS;
 
-		  mapwriter.SetMapCell( x, y, cell );
+		  block.cells[x_add][y_add] = cell;
 
 		  if ( !shapes.empty() )
 		  {
-			++with_more_solids;
-			total_statics += static_cast<unsigned int>( shapes.size() );
-			if ( idx2_offset == 0 )
-			  idx2_offset = mapwriter.NextSolidx2Offset();
-
-			unsigned int addindex = mapwriter.NextSolidIndex() - idx2_elem.baseindex;
-			if ( addindex > std::numeric_limits<unsigned short>::max() )
-                throw std::runtime_error("addoffset overflow");
-			idx2_elem.addindex[x_add][y_add] = static_cast<unsigned short>( addindex );
 			int count = static_cast<int>( shapes.size() );
+			block.solid_count[x_add][y_add] = static_cast<unsigned short>( count );
 			for ( int j = 0; j < count; ++j )
 			{
 			  MapShape shape = shapes[j];
@@ -783,11 +859,47 @@ namespace Pol {
 			  solid.z = _z;
 			  solid.height = height;
 			  solid.flags = flags;
-			  mapwriter.AppendSolid( solid );
+			  block.solids.push_back( solid );
 			}
 		  }
 		}
 	  }
+	}
+
+	void WriteSolidBlock( const SolidBlock& block, MapWriter& mapwriter )
+	{
+	  unsigned int idx2_offset = 0;
+	  SOLIDX2_ELEM idx2_elem;
+	  memset( &idx2_elem, 0, sizeof idx2_elem );
+	  idx2_elem.baseindex = mapwriter.NextSolidIndex();
+
+	  unsigned short x_add_max, y_add_max;
+	  solid_block_extent( block.x_base, block.y_base, x_add_max, y_add_max );
+
+	  auto solid = block.solids.begin();
+	  for ( unsigned short x_add = 0; x_add < x_add_max; ++x_add )
+	  {
+		for ( unsigned short y_add = 0; y_add < y_add_max; ++y_add )
+		{
+		  mapwriter.SetMapCell( block.x_base + x_add, block.y_base + y_add, block.cells[x_add][y_add] );
+
+		  unsigned short count = block.solid_count[x_add][y_add];
+		  if ( count )
+		  {
+			++with_more_solids;
+			total_statics += count;
+			if ( idx2_offset == 0 )
+			  idx2_offset = mapwriter.NextSolidx2Offset();
+
+			unsigned int addindex = mapwriter.NextSolidIndex() - idx2_elem.baseindex;
+			if ( addindex > std::numeric_limits<unsigned short>::max() )
+                throw std::runtime_error("addoffset overflow");
+			idx2_elem.addindex[x_add][y_add] = static_cast<unsigned short>( addindex );
+			for ( unsigned short j = 0; j < count; ++j )
+			  mapwriter.AppendSolid( *solid++ );
+		  }
+		}
+	  }
 	  if ( idx2_offset )
 	  {
 		++nonempty;
@@ -797,7 +909,59 @@ namespace Pol {
 	  {
 		++empty;
 	  }
-	  mapwriter.SetSolidx2Offset( x_base, y_base, idx2_offset );
+	  mapwriter.SetSolidx2Offset( block.x_base, block.y_base, idx2_offset );
+	}
+
+	void ProcessSolidBlock( unsigned short x_base, unsigned short y_base, MapWriter& mapwriter )
+	{
+	  SolidBlock block;
+	  block.x_base = x_base;
+	  block.y_base = y_base;
+	  CalcSolidBlock( block );
+	  WriteSolidBlock( block, mapwriter );
+	}
+
+	// Calculates the blocks on worker threads, blocks_per_task blocks per task.
+	// The results are written in the given order, so the files are the same as with a single thread.
+	void ProcessSolidBlocks( const std::vector<std::pair<unsigned short, unsigned short>>& coords, size_t blocks_per_task,
+							 unsigned threads, MapWriter& mapwriter )
+	{
+	  if ( coords.empty() )
+		return;
+	  typedef std::vector<SolidBlock> Results;
+	  size_t tasks = ( coords.size() + blocks_per_task - 1 ) / blocks_per_task;
+	  std::deque<std::pair<std::shared_ptr<Results>, std::future<bool>>> pending;
+	  threadhelp::TaskThreadPool pool( threads, "uoconvert" );
+
+	  size_t next_task = 0;
+	  for ( size_t task = 0; task < tasks; ++task )
+	  {
+		// keep the workers busy, but don't hold more than a few results in memory
+		while ( next_task < tasks && pending.size() < threads * 2 )
+		{
+		  size_t begin = next_task * blocks_per_task;
+		  size_t end = std::min( begin + blocks_per_task, coords.size() );
+		  std::shared_ptr<Results> results( new Results( end - begin ) );
+		  auto future = pool.checked_push( [&coords, results, begin]()
+		  {
+			for ( size_t i = 0; i < results->size(); ++i )
+			{
+			  SolidBlock& block = ( *results )[i];
+			  block.x_base = coords[begin + i].first;
+			  block.y_base = coords[begin + i].second;
+			  CalcSolidBlock( block );
+			}
+		  } );
+		  pending.push_back( std::make_pair( results, std::move( future ) ) );
+		  ++next_task;
+		}
+
+		pending.front().second.get(); // rethrows exceptions of the worker
+		for ( const auto& block : *pending.front().first )
+		  WriteSolidBlock( block, mapwriter );
+		pending.pop_front();
+        INFO_PRINT << "\rConverting: " << ( task + 1 ) * 100 / tasks << "%";
+	  }
 	}
 
 	void write_multi( FILE* multis_cfg, unsigned id, FILE* multi_mul, unsigned int offset, unsigned int length )
@@ -1217,6 +1381,8 @@ namespace Pol {
 
       int x = Clib::LongArg2( "x=", -1 );
       int y = Clib::LongArg2( "y=", -1 );
+      unsigned threads = UOConvert::thread_count();
+      bool incremental = Clib::LongArg2( "incremental=", 0 ) != 0;
 
       // brittania: realm=main mapid=0 width=6144 height=4096
       // ilshenar: realm=ilshenar mapid=2 width=2304 height=1600
@@ -1230,7 +1396,7 @@ namespace Pol {
       }
       else
       {
-        UOConvert::create_map( realm, static_cast<unsigned short>( width ), static_cast<unsigned short>( height ) );
+        UOConvert::create_map( realm, static_cast<unsigned short>( width ), static_cast<unsigned short>( height ), threads, incremental );
       }
     }
     else if ( command == "statics" )
@@ -1246,7 +1412,9 @@ namespace Pol {
       UOConvert::open_uo_data_files( );
       UOConvert::read_uo_data( );
 
-      Core::write_pol_static_files( realm );
+      unsigned threads = UOConvert::thread_count();
+      bool incremental = Clib::LongArg2( "incremental=", 0 ) != 0;
+      Core::write_pol_static_files( realm, threads, incremental );
     }
     else if ( command == "multis" )
     {
@@ -1281,6 +1449,17 @@ namespace Pol {
 
       UOConvert::create_maptile( realm );
     }
+    else if ( command == "navgrid" )
+    {
+      const char* realm = Clib::FindArg2( "realm=", "britannia" );
+      Plib::RealmDescriptor descriptor = Plib::RealmDescriptor::Load( realm );
+      std::unique_ptr<Plib::MapServer> mapserver( Plib::MapServer::Create( descriptor ) );
+
+      INFO_PRINT << "Creating navigation grid for realm " << realm << ": ";
+      Tools::Timer<> timer;
+      Plib::NavGrid::Create( descriptor, *mapserver );
+      INFO_PRINT << "Done in " << timer.ellapsed() << " ms.\n";
+    }
     else if ( command == "flags" )
     {
       UOConvert::display_flags( );
@@ -1289,9 +1468,10 @@ namespace Pol {
     {
       ERROR_PRINT << "Usage: uoconvert [command] [options]\n"
         << "Commands: \n"
-        << "  map {uodata=Dir} {maxtileid=0x3FFF/0x7FFF} {realm=realmname} {width=Width} {height=Height} {x=X} {y=Y}\n"
-        << "  statics {uodata=Dir} {maxtileid=0x3FFF/0x7FFF} {realm=realmname}\n"
+        << "  map {uodata=Dir} {maxtileid=0x3FFF/0x7FFF} {realm=realmname} {width=Width} {height=Height} {x=X} {y=Y} {threads=N} {incremental=0/1}\n"
+        << "  statics {uodata=Dir} {maxtileid=0x3FFF/0x7FFF} {realm=realmname} {threads=N} {incremental=0/1}\n"
         << "  maptile {uodata=Dir} {maxtileid=0x3FFF/0x7FFF} {realm=realmname}\n"
+        << "  navgrid {realm=realmname}\n"
         << "  multis {uodata=Dir} {maxtileid=0x3FFF/0x7FFF}\n"
         << "  tiles {uodata=Dir} {maxtileid=0x3FFF/0x7FFF}\n"
         << "  landtiles {uodata=Dir} {maxtileid=0x3FFF/0x7FFF}\n";
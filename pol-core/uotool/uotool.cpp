@@ -17,6 +17,7 @@ Notes
 #include "../pol/multi/multidef.h"
 #include "../pol/globals/multidefs.h"
 #include "../pol/objtype.h"
+#include "../pol/objecthash.h"
 
 #include "../plib/realmdescriptor.h"
 #include "../plib/staticblock.h"
@@ -32,6 +33,12 @@ Notes
 #include "../clib/logfacility.h"
 #include "../clib/fdump.h"
 #include "../clib/passert.h"
+#include "../clib/timer.h"
+
+#include <algorithm>
+#include <map>
+#include <random>
+#include <vector>
 
 #ifdef _MSC_VER
 #pragma warning(disable:4996) // deprecation warning for fopen, sprintf, stricmp
@@ -146,7 +153,8 @@ namespace Pol {
         << "    loschange                prints differences in LOS handling \n"
         << "    staticdefrag [realm]     recreates static files {default britannia} \n"
         << "    formatdesc name          prints plural and singular form of name \n"
-        << "    checkmultis              prints infos about multi center items \n";
+        << "    checkmultis              prints infos about multi center items \n"
+        << "    benchobjecthash [count]  compares objecthash against std::map {default 1M and 5M objects} \n";
 	  return ret;
 	}
 #define TILES_START 0x68800
@@ -1339,9 +1347,148 @@ namespace Pol {
 
   }
 
+  namespace Uotool {
+	class BenchObject : public ref_counted
+	{};
+	typedef ref_ptr<BenchObject> BenchObjectRef;
+
+	// Same access pattern as the objecthash: sequential item serials on creation/load,
+	// lookups by serial in random order, full sweeps, removal of scattered objects.
+	template <class Insert, class Find, class Iterate, class Remove>
+	void bench_run( const char* name, const std::vector<u32>& serials, const std::vector<u32>& shuffled,
+					Insert insert, Find find, Iterate iterate, Remove remove )
+	{
+	  std::vector<BenchObjectRef> objects;
+	  objects.reserve( serials.size() );
+	  for ( size_t i = 0; i < serials.size(); ++i )
+		objects.push_back( BenchObjectRef( new BenchObject ) );
+
+	  Tools::Timer<> timer;
+	  for ( size_t i = 0; i < serials.size(); ++i )
+		insert( serials[i], objects[i] );
+	  timer.stop();
+	  long long t_insert = timer.ellapsed();
+
+	  timer.start();
+	  size_t found = 0;
+	  for ( u32 serial : shuffled )
+		found += find( serial );
+	  timer.stop();
+	  long long t_find = timer.ellapsed();
+
+	  timer.start();
+	  size_t iterated = iterate();
+	  timer.stop();
+	  long long t_iterate = timer.ellapsed();
+
+	  timer.start();
+	  for ( u32 serial : shuffled )
+		remove( serial );
+	  timer.stop();
+	  long long t_remove = timer.ellapsed();
+
+	  INFO_PRINT.Format( "  {:<12} insert {:>6} ms  find {:>6} ms  iterate {:>6} ms  remove {:>6} ms" )
+		<< name << t_insert << t_find << t_iterate << t_remove;
+	  if ( found != serials.size() || iterated != serials.size() )
+		INFO_PRINT << "  MISMATCH (" << found << "/" << iterated << ")";
+	  INFO_PRINT << "\n";
+	}
+
+	// iteration has to continue behind pages and dirs which got freed by erase()
+	bool check_serialtable()
+	{
+	  const u32 page = 1 << 10;
+	  const u32 dir = 1 << 21;
+	  const u32 base = 0x40000000Lu;
+	  // three pages with a hole page in between, a hole dir and a partly used last page
+	  std::vector<u32> serials = { base + 5, base + page - 1, base + 2 * page + 100, base + 2 * page + 900,
+		base + 2 * dir + 3 * page + 1, base + 2 * dir + 4 * page + 800 };
+	  std::vector<u32> holes = { base + page, base + page + 700, base + dir + 17, base + 2 * dir + 4 * page + 5 };
+
+	  Core::SerialTable<BenchObjectRef> table;
+	  for ( u32 s : serials )
+		table.insert( s, BenchObjectRef( new BenchObject ) );
+	  for ( u32 s : holes )
+		table.insert( s, BenchObjectRef( new BenchObject ) );
+	  for ( u32 s : holes )
+		table.erase( s );
+
+	  bool ok = table.size() == serials.size();
+	  size_t i = 0;
+	  for ( auto itr = table.begin(); itr != table.end(); ++itr, ++i )
+		ok = ok && i < serials.size() && itr.serial() == serials[i];
+	  ok = ok && i == serials.size();
+	  // lower_bound from a slot offset inside the freed page/dir, like Reap() continuing
+	  // at a serial which got deleted in the meantime
+	  for ( u32 s : holes )
+	  {
+		auto itr = table.lower_bound( s );
+		auto expected = std::lower_bound( serials.begin(), serials.end(), s );
+		ok = ok && ( expected == serials.end() ? itr == table.end() : ( itr != table.end() && itr.serial() == *expected ) );
+	  }
+	  if ( !ok )
+		INFO_PRINT << "SerialTable iteration check failed\n";
+	  return ok;
+	}
+
+	void bench_objecthash( size_t count )
+	{
+	  std::vector<u32> serials;
+	  serials.reserve( count );
+	  // mostly dense, with the gaps left by deleted objects
+	  std::mt19937 rng( 42 );
+	  u32 serial = 0x40000000Lu; // ITEMSERIAL_START
+	  while ( serials.size() < count )
+	  {
+		serials.push_back( serial );
+		serial += ( rng() % 8 == 0 ) ? 2 : 1;
+	  }
+	  std::vector<u32> shuffled( serials );
+	  std::shuffle( shuffled.begin(), shuffled.end(), rng );
+
+	  INFO_PRINT << count << " objects:\n";
+	  {
+		std::map<u32, BenchObjectRef> map;
+		bench_run( "std::map", serials, shuffled,
+				   [&]( u32 s, const BenchObjectRef& ref ) { map.insert( map.end(), std::make_pair( s, ref ) ); },
+				   [&]( u32 s ) { return map.find( s ) != map.end() ? 1 : 0; },
+				   [&]() { size_t n = 0; for ( const auto& p : map ) n += !!p.second; return n; },
+				   [&]( u32 s ) { map.erase( s ); } );
+	  }
+	  {
+		std::unique_ptr<Core::SerialTable<BenchObjectRef>> table( new Core::SerialTable<BenchObjectRef> );
+		bench_run( "SerialTable", serials, shuffled,
+				   [&]( u32 s, const BenchObjectRef& ref ) { table->insert( s, ref ); },
+				   [&]( u32 s ) { return table->find( s ) != NULL ? 1 : 0; },
+				   [&]() { size_t n = 0; for ( const auto& ref : *table ) n += !!ref; return n; },
+				   [&]( u32 s ) { table->erase( s ); } );
+	  }
+	}
+
+	int benchobjecthash( int argc, char* argv[] )
+	{
+	  if ( !check_serialtable() )
+		return 1;
+	  if ( argc >= 3 )
+	  {
+		bench_objecthash( strtoul( argv[2], NULL, 0 ) );
+	  }
+	  else
+	  {
+		bench_objecthash( 1000000 );
+		bench_objecthash( 5000000 );
+	  }
+	  return 0;
+	}
+  }
+
   int xmain( int argc, char* argv[] )
   {
 	Clib::StoreCmdArgs( argc, argv );
+	// doesn't need any uo data
+	if ( argc > 1 && stricmp( argv[1], "benchobjecthash" ) == 0 )
+	  return Uotool::benchobjecthash( argc, argv );
+
 	Clib::ConfigFile cf( "pol.cfg" );
 	Clib::ConfigElem elem;
 